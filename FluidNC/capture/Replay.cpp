@@ -0,0 +1,198 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "Replay.h"
+#include "Capture.h"
+
+#include <cstdlib>
+#include <cstdio>
+#include <sstream>
+#include <iostream>
+
+Replay::Replay() {
+    const char* filename;
+    if ((filename = getenv("FLUIDNC_REPLAY")) != nullptr) {
+        load(filename);
+        _mode = Mode::Replay;
+    } else if ((filename = getenv("FLUIDNC_RECORD")) != nullptr) {
+        _log.open(filename, std::ios::out | std::ios::trunc);
+        if (_log.is_open()) {
+            _log << "# FluidNC input log" << std::endl;
+            _mode = Mode::Record;
+        } else {
+            std::cerr << "Cannot create record file " << filename << std::endl;
+        }
+    }
+    if ((filename = getenv("FLUIDNC_TRACE")) != nullptr) {
+        _trace.open(filename, std::ios::out | std::ios::trunc);
+        if (_trace.is_open()) {
+            _trace << "# FluidNC output trace" << std::endl;
+        } else {
+            std::cerr << "Cannot create trace file " << filename << std::endl;
+        }
+    }
+}
+
+Replay::~Replay() {
+    if (_log.is_open()) {
+        _log.close();
+    }
+    if (_trace.is_open()) {
+        _trace.close();
+    }
+}
+
+uint32_t Replay::now() {
+    return Capture::instance().current();
+}
+
+void Replay::load(const char* filename) {
+    std::ifstream in(filename);
+    if (!in.is_open()) {
+        std::cerr << "Cannot open replay file " << filename << std::endl;
+        return;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream ss(line);
+        Entry              entry;
+        std::string        id;
+        if (!(ss >> entry.time >> id)) {
+            continue;
+        }
+        std::string hex;
+        while (ss >> hex) {
+            entry.data.push_back(uint8_t(strtoul(hex.c_str(), nullptr, 16)));
+        }
+        _pending[id].push_back(entry);
+    }
+}
+
+void Replay::write_line(std::ofstream& out, uint32_t time, const std::string& id, const uint8_t* data, size_t len) {
+    char hex[4];
+    out << time << ' ' << id;
+    for (size_t i = 0; i < len; ++i) {
+        snprintf(hex, sizeof(hex), " %02x", data[i]);
+        out << hex;
+    }
+    // Flush every line so the log survives the process being killed
+    out << std::endl;
+}
+
+void Replay::record(const std::string& id, const uint8_t* data, size_t len) {
+    if (_mode == Mode::Record) {
+        write_line(_log, now(), id, data, len);
+    }
+}
+
+int Replay::available(const std::string& id, int live_available) {
+    if (_mode != Mode::Replay) {
+        return live_available;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto     it    = _pending.find(id);
+    int      count = 0;
+    uint32_t t     = now();
+    if (it != _pending.end()) {
+        for (auto& entry : it->second) {
+            if (entry.time > t) {
+                break;
+            }
+            count += int(entry.data.size());
+        }
+    }
+    return count;
+}
+
+int Replay::read(const std::string& id, int live_byte) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_mode != Mode::Replay) {
+        if (live_byte >= 0) {
+            uint8_t c = uint8_t(live_byte);
+            record(id, &c, 1);
+        }
+        return live_byte;
+    }
+
+    auto it = _pending.find(id);
+    if (it == _pending.end()) {
+        return -1;
+    }
+    auto& queue = it->second;
+    while (!queue.empty() && queue.front().data.empty()) {
+        queue.pop_front();
+    }
+    if (queue.empty() || queue.front().time > now()) {
+        return -1;
+    }
+    auto& data = queue.front().data;
+    int   c    = data.front();
+    data.erase(data.begin());
+    if (data.empty()) {
+        queue.pop_front();
+    }
+    return c;
+}
+
+bool Replay::level(const std::string& id, bool live_level) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_mode != Mode::Replay) {
+        auto it = _levels.find(id);
+        if (it == _levels.end() || it->second != live_level) {
+            _levels[id] = live_level;
+            uint8_t v   = live_level;
+            record(id, &v, 1);
+        }
+        return live_level;
+    }
+
+    auto it = _pending.find(id);
+    if (it != _pending.end()) {
+        auto&    queue = it->second;
+        uint32_t t     = now();
+        while (!queue.empty() && queue.front().time <= t) {
+            _levels[id] = !queue.front().data.empty() && queue.front().data.front();
+            queue.pop_front();
+        }
+    }
+    return _levels[id];
+}
+
+std::vector<uint8_t> Replay::response(const std::string& id, const std::vector<uint8_t>& live_response) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_mode != Mode::Replay) {
+        record(id, live_response.data(), live_response.size());
+        return live_response;
+    }
+
+    auto it = _pending.find(id);
+    if (it == _pending.end() || it->second.empty()) {
+        return {};
+    }
+    auto data = it->second.front().data;
+    it->second.pop_front();
+    return data;
+}
+
+void Replay::output(const std::string& id, uint32_t value) {
+    if (!tracing()) {
+        return;
+    }
+    uint8_t v = uint8_t(value);
+    output(id, &v, 1);
+}
+
+void Replay::output(const std::string& id, const uint8_t* data, size_t len) {
+    if (!tracing()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    write_line(_trace, now(), id, data, len);
+}
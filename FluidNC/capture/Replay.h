@@ -0,0 +1,82 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <fstream>
+
+// Deterministic record/replay of external inputs for the capture builds.
+//
+// Every input that reaches the firmware from outside - channel bytes, GPIO
+// levels and VFD responses - passes through this class together with the
+// virtual time from Capture.  The behavior is selected by environment
+// variables that are read the first time the instance is used:
+//
+//   FLUIDNC_RECORD=<file>  Log every input with its virtual timestamp
+//   FLUIDNC_REPLAY=<file>  Ignore live inputs and feed the log back instead
+//   FLUIDNC_TRACE=<file>   Write step, GPIO and channel outputs to a trace
+//                          that tools/trace_compare.py can diff between builds
+//
+// Log and trace files share a line format:  <time> <id> <hex bytes...>
+// e.g. "1532 console 47 31 0a" or "1540 gpio.4 01".  Lines beginning with
+// '#' are comments.
+//
+// Channel bytes and GPIO levels are released on replay once the virtual
+// clock reaches their recorded timestamp.  VFD responses are request/response
+// pairs, so they are replayed in order, one per request, independent of time.
+
+class Replay {
+public:
+    enum class Mode { Live, Record, Replay };
+
+    static Replay& instance() {
+        static Replay instance;
+        return instance;
+    }
+
+    Mode mode() const { return _mode; }
+    bool tracing() const { return _trace.is_open(); }
+
+    // Byte stream inputs such as the console.  live_available/live_read
+    // describe the live source; on replay they are ignored.
+    int available(const std::string& id, int live_available);
+    int read(const std::string& id, int live_byte);
+
+    // Level inputs such as GPIOs.  Only changes are recorded.
+    bool level(const std::string& id, bool live_level);
+
+    // Message inputs that answer a request, such as VFD responses.
+    std::vector<uint8_t> response(const std::string& id, const std::vector<uint8_t>& live_response);
+
+    // Output trace for comparisons between builds.
+    void output(const std::string& id, uint32_t value);
+    void output(const std::string& id, const uint8_t* data, size_t len);
+
+private:
+    Replay();
+    ~Replay();
+
+    struct Entry {
+        uint32_t             time;
+        std::vector<uint8_t> data;
+    };
+
+    uint32_t now();
+    void     record(const std::string& id, const uint8_t* data, size_t len);
+    void     load(const char* filename);
+    void     write_line(std::ofstream& out, uint32_t time, const std::string& id, const uint8_t* data, size_t len);
+
+    Mode          _mode = Mode::Live;
+    std::ofstream _log;
+    std::ofstream _trace;
+    std::mutex    _mutex;
+
+    std::map<std::string, std::deque<Entry>> _pending;  // Replay entries per input id
+    std::map<std::string, bool>              _levels;   // Last known level per input id
+};
@@ -0,0 +1,17 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "Driver/fluidnc_adc.h"
+#include "Capture.h"
+
+#include <string>
+
+bool adc_attach(pinnum_t pin) {
+    return true;
+}
+
+// The voltage can be injected with Inputs::instance().set("adc.N", millivolts)
+uint32_t adc_read_mv(pinnum_t pin) {
+    const auto& val = Inputs::instance().get("adc." + std::to_string(pin));
+    return val.empty() ? 0 : val[0];
+}
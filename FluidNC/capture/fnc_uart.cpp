@@ -8,8 +8,19 @@
 #include <sstream>
 #include <algorithm>
 #include "HuanyangSimulator.h"
+#include "Replay.h"
 #include "NutsBolts.h"  // get_ms()
 
+#ifndef _WIN32
+#    include <cerrno>
+#    include <cstdlib>
+#    include <fcntl.h>
+#    include <poll.h>
+#    include <sys/ioctl.h>
+#    include <termios.h>
+#    include <unistd.h>
+#endif
+
 class InputPin;
 void uart_register_input_pin(uint32_t uart_num, pinnum_t pinnum, InputPin* object) {}
 
@@ -22,14 +33,50 @@ inline std::string uart_key(uint32_t uart_num) {
     return key.str();
 }
 
+// If FLUIDNC_UART<n> names a tty, such as one end of a pty pair made by
+//   socat pty,raw,echo=0,link=/tmp/uart1a pty,raw,echo=0,link=/tmp/uart1b
+// uart<n> reads and writes it instead of the captured inputs.  That lets
+// two instances talk to each other, as for motion_sync.
+static std::vector<int> tty_fd(MAX_N_UARTS, -1);
+
+static bool uart_is_tty(uint32_t uart_num) {
+    return uart_num < MAX_N_UARTS && tty_fd[uart_num] >= 0;
+}
+
 void uart_discard_input(uint32_t uart_num) {}
 
-void uart_init(uint32_t uart_num) {}
+void uart_init(uint32_t uart_num) {
+#ifndef _WIN32
+    if (uart_num >= MAX_N_UARTS || tty_fd[uart_num] >= 0) {
+        return;
+    }
+    auto path = getenv(("FLUIDNC_UART" + std::to_string(uart_num)).c_str());
+    if (!path) {
+        return;
+    }
+    int fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0) {
+        return;
+    }
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    tty_fd[uart_num] = fd;
+#endif
+}
 
 int uart_buflen(uint32_t uart_num) {
+#ifndef _WIN32
+    if (uart_is_tty(uart_num)) {
+        int len = 0;
+        return ioctl(tty_fd[uart_num], FIONREAD, &len) == 0 ? len : 0;
+    }
+#endif
     auto        key = uart_key(uart_num);
     const auto& val = Inputs::instance().get(key);
-    return val.size();
+    return Replay::instance().available(key, int(val.size()));
 }
 
 extern int inchar();
@@ -38,6 +85,16 @@ std::vector<uint8_t> vfd_output;
 uint32_t             vfd_ms;
 
 int uart_read(uint32_t uart_num, uint8_t* buf, uint32_t len, uint32_t timeout_ms) {
+#ifndef _WIN32
+    if (uart_is_tty(uart_num)) {
+        struct pollfd pfd = { tty_fd[uart_num], POLLIN, 0 };
+        if (poll(&pfd, 1, int(timeout_ms)) <= 0) {
+            return 0;
+        }
+        auto got = read(tty_fd[uart_num], buf, len);
+        return got < 0 ? 0 : int(got);
+    }
+#endif
     if (vfd_simulator[uart_num]) {
         if (vfd_output.size()) {
             auto copylen = std::min((size_t)len, vfd_output.size());
@@ -47,28 +104,51 @@ int uart_read(uint32_t uart_num, uint8_t* buf, uint32_t len, uint32_t timeout_ms
         }
         return 0;
     }
-    auto        key = uart_key(uart_num);
-    const auto& val = Inputs::instance().get(key);
-    auto        max = std::min(size_t(len), val.size());
+    auto        key    = uart_key(uart_num);
+    auto&       replay = Replay::instance();
+    const auto& val    = Inputs::instance().get(key);
+    auto        max    = std::min(size_t(len), size_t(replay.available(key, int(val.size()))));
     for (size_t i = 0; i < max; ++i) {
-        buf[i] = uint8_t(val[i]);
+        buf[i] = uint8_t(replay.read(key, i < val.size() ? int(val[i]) : -1));
+    }
+    if (replay.mode() != Replay::Mode::Replay) {
+        std::vector<uint32_t> newval(val.begin() + max, val.end());
+        Inputs::instance().set(key, newval);
     }
-    std::vector<uint32_t> newval(val.begin() + max, val.end());
-    Inputs::instance().set(key, newval);
     return int(max);
 }
 
 int uart_write(uint32_t uart_num, const uint8_t* buf, size_t len) {
+#ifndef _WIN32
+    if (uart_is_tty(uart_num)) {
+        size_t sent = 0;
+        while (sent < len) {
+            auto wrote = write(tty_fd[uart_num], buf + sent, len - sent);
+            if (wrote < 0) {
+                if (errno != EAGAIN) {
+                    return int(sent);
+                }
+                struct pollfd pfd = { tty_fd[uart_num], POLLOUT, 0 };
+                poll(&pfd, 1, 10);
+                continue;
+            }
+            sent += size_t(wrote);
+        }
+        return int(len);
+    }
+#endif
     if (vfd_simulator[uart_num]) {
         int32_t this_ms = get_ms();
         vfd_simulator[uart_num]->update((int32_t)this_ms - (int32_t)vfd_ms);
         vfd_ms     = this_ms;
-        vfd_output = vfd_simulator[uart_num]->processModbusMessage(std::vector<uint8_t> { buf, buf + len });
+        auto response = vfd_simulator[uart_num]->processModbusMessage(std::vector<uint8_t> { buf, buf + len });
+        vfd_output    = Replay::instance().response("vfd." + std::to_string(uart_num), response);
 
         return 0;
     }
 
     auto key = uart_key(uart_num);
+    Replay::instance().output(key, buf, len);
     auto val = Inputs::instance().get(key);
     for (size_t i = 0; i < len; ++i) {
         val.push_back(uint32_t(uint8_t(buf[i])));
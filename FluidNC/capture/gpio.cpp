@@ -6,10 +6,30 @@
 #include "Uart.h"
 #include "Protocol.h"
 #include "Driver/fluidnc_gpio.h"
+#include "Capture.h"
+#include "Replay.h"
+#include "InputFilter.h"
 
-void gpio_write(pinnum_t pin, bool value) {}
+static std::string gpio_key(pinnum_t pin) {
+    return "gpio." + std::to_string(pin);
+}
+
+void gpio_write(pinnum_t pin, bool value) {
+    auto& replay = Replay::instance();
+    if (replay.tracing()) {
+        replay.output(gpio_key(pin), value);
+    }
+}
 bool gpio_read(pinnum_t pin) {
-    return 0;
+    // Live input levels can be injected with Inputs::instance().set("gpio.N", level)
+    auto        key  = gpio_key(pin);
+    const auto& val  = Inputs::instance().get(key);
+    bool        live = !val.empty() && val[0];
+    return Replay::instance().level(key, live);
+}
+// Writes go through gpio_write() so they can be traced
+bool gpio_output_regs(pinnum_t pin, volatile uint32_t** set_reg, volatile uint32_t** clear_reg, uint32_t* mask) {
+    return false;
 }
 void gpio_mode(pinnum_t pin, bool input, bool output, bool pullup, bool pulldown, bool opendrain) {}
 void gpio_drive_strength(pinnum_t pin, uint8_t strength) {}
@@ -34,8 +54,31 @@ static int32_t gpio_deltat_ticks[MAX_N_GPIO + 1]     = { 0 };
 // Do not send events for changes that occur too soon
 static void gpio_set_rate_limit(int32_t gpio_num, uint32_t ms) {}
 
+// A noisy input can be simulated with Inputs::instance().set("gpio.N.noise", percent),
+// which inverts each sample of the pin with that probability.  The noise
+// sequence is pseudo-random but repeatable from run to run.
+static bool gpio_noise(pinnum_t pin) {
+    static uint32_t lcg   = 1;
+    const auto&     noise = Inputs::instance().get(gpio_key(pin) + ".noise");
+    if (noise.empty() || !noise[0]) {
+        return false;
+    }
+    lcg = lcg * 1103515245 + 12345;
+    return ((lcg >> 16) % 100) < noise[0];
+}
+
+static gpio_mask_t gpio_mask(int32_t gpio_num);
+
 static inline gpio_mask_t get_gpios() {
-    return ((uint64_t(0) << 32) | 0) ^ gpios_inverted;
+    gpio_mask_t levels = 0;
+    for (pinnum_t pin = 0; pin < MAX_N_GPIO; ++pin) {
+        if (gpios_interest & gpio_mask(pin)) {
+            if (gpio_read(pin) ^ gpio_noise(pin)) {
+                levels |= gpio_mask(pin);
+            }
+        }
+    }
+    return levels ^ gpios_inverted;
 }
 static gpio_mask_t gpio_mask(int32_t gpio_num) {
     return 1ULL << gpio_num;
@@ -53,6 +96,9 @@ static void gpios_update(gpio_mask_t& gpios, int32_t gpio_num, bool active) {
 
 static void* gpioArgs[MAX_N_GPIO + 1];
 
+// There is no sampling timer in the capture build, so poll_gpios() takes the filter samples
+static InputFilter gpio_filter;
+
 void gpio_set_event(int32_t gpio_num, void* arg, bool invert) {
     gpioArgs[gpio_num] = arg;
     gpio_mask_t mask   = gpio_mask(gpio_num);
@@ -60,6 +106,7 @@ void gpio_set_event(int32_t gpio_num, void* arg, bool invert) {
     gpios_update(gpios_inverted, gpio_num, invert);
     gpio_set_rate_limit(gpio_num, 5);
     auto active = gpio_is_active(gpio_num);
+    gpio_filter.set_level(gpio_num, active);
 
     // Set current to the opposite of the current state so the first poll will send the current state
     gpios_update(gpios_current, gpio_num, !active);
@@ -90,7 +137,9 @@ static void gpio_send_event(int32_t gpio_num, bool active) {
 }
 
 void poll_gpios() {
-    gpio_mask_t gpios_active  = get_gpios();
+    gpio_mask_t raw = get_gpios();
+    gpio_filter.sample(raw);
+    gpio_mask_t gpios_active  = gpio_filter.apply(raw);
     gpio_mask_t gpios_changed = (gpios_active ^ gpios_current) & gpios_interest;
 
     // Process each changed GPIO. We check gpios_changed != 0 explicitly because
@@ -104,3 +153,21 @@ void poll_gpios() {
         gpios_changed &= ~gpio_mask(gpio_num);
     }
 }
+
+void gpio_set_filter(pinnum_t pin, uint32_t samples) {
+    gpio_filter.set_samples(pin, samples, gpio_is_active(pin));
+}
+
+void gpio_filter_start(uint32_t sample_hz) {}
+
+uint32_t gpio_filter_samples(pinnum_t pin) {
+    return gpio_filter.samples(pin);
+}
+
+uint32_t gpio_filter_glitches(pinnum_t pin) {
+    return gpio_filter.glitches(pin);
+}
+
+uint32_t gpio_filter_rate() {
+    return 0;
+}
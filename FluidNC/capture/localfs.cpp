@@ -31,11 +31,60 @@ std::uintmax_t localfs_size() {
     return 200000;
 }
 
+// The host directory stands in for a LittleFS volume with the ESP32 geometry
+bool localfs_littlefs_geometry(uint32_t& block_size, uint32_t& inline_max) {
+    block_size = 4096;
+    inline_max = 512;
+    return true;
+}
+
 bool sd_init_slot(uint32_t freq_hz, pinnum_t cs_pin, pinnum_t cd_pin = -1, pinnum_t wp_pin = -1) {
     return true;
 }
 void sd_deinit_slot() {}
 void sd_unmount() {}
+void sd_set_read_cache(uint32_t chunk_bytes) {}
+
+struct SdDir {
+    stdfs::directory_iterator iter;
+};
+
+SdDir* sd_opendir(const char* path) {
+    if (!string_util::starts_with_ignore_case(path, SD.prefix)) {
+        return nullptr;
+    }
+    std::error_code ec;
+    auto            dir = new SdDir { stdfs::directory_iterator { path, ec } };
+    if (ec) {
+        delete dir;
+        return nullptr;
+    }
+    return dir;
+}
+
+bool sd_readdir(SdDir* dir, std::string& name, uint32_t& size, bool& is_dir) {
+    std::error_code ec;
+    if (dir->iter == stdfs::directory_iterator()) {
+        return false;
+    }
+    name   = dir->iter->path().filename().string();
+    is_dir = dir->iter->is_directory(ec);
+    size   = is_dir ? 0 : uint32_t(dir->iter->file_size(ec));
+    dir->iter.increment(ec);
+    if (ec) {
+        dir->iter = stdfs::directory_iterator();
+    }
+    return true;
+}
+
+void sd_closedir(SdDir* dir) {
+    delete dir;
+}
+
+// The host directory can be changed behind our back
+uint32_t sd_volume_signature() {
+    return 0;
+}
 
 std::error_code sd_mount(uint32_t max_files) {
     std::cout << "Mounting sd from " << SD.prefix << std::endl;
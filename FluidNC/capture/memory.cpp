@@ -0,0 +1,25 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "Driver/fluidnc_memory.h"
+
+#include <cstdlib>
+
+// The host has one kind of memory.  It is reported as PSRAM, so that
+// configurations for boards with PSRAM can be run.
+
+void* memory_alloc(size_t size, MemoryTier tier) {
+    return malloc(size);
+}
+
+void memory_free(void* ptr) {
+    free(ptr);
+}
+
+bool memory_has_external() {
+    return true;
+}
+
+size_t memory_free_bytes(MemoryTier tier) {
+    return tier == MemoryTier::External ? 8 * 1024 * 1024 : 256 * 1024;
+}
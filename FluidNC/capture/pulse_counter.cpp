@@ -0,0 +1,73 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "Driver/pulse_counter.h"
+#include "Capture.h"
+
+#include <string>
+#include <vector>
+
+// Stands in for pulse trains on the pins.  The pulse rate is injected with
+// Inputs::instance().set("pcnt.N", pulses_per_minute) for a counter on pin N,
+// or "index.N" for index pulses, and pulses accumulate at that rate as the
+// capture clock advances.
+
+struct SimTrain {
+    pinnum_t pin;
+    uint32_t time;      // Capture time of the last update, in ms
+    uint64_t fraction;  // Pulses, times 60000
+    uint32_t count;
+    uint64_t last_us;
+    uint64_t previous_us;
+};
+
+static std::vector<SimTrain> counters;
+static std::vector<SimTrain> indexes;
+
+static void advance(SimTrain& train, const char* kind) {
+    uint32_t    now  = Capture::instance().current();
+    const auto& rate = Inputs::instance().get(kind + std::to_string(train.pin));
+    if (!rate.empty() && rate[0]) {
+        uint64_t period_us = 60000000ull / rate[0];
+        train.fraction += uint64_t(rate[0]) * (now - train.time);
+        while (train.fraction >= 60000) {
+            train.fraction -= 60000;
+            ++train.count;
+            train.previous_us = train.last_us;
+            train.last_us     = uint64_t(now) * 1000 - (train.fraction * period_us) / 60000;
+        }
+    }
+    train.time = now;
+}
+
+int32_t pulse_counter_attach(pinnum_t pin, uint32_t filter_ns) {
+    counters.push_back({ pin, Capture::instance().current(), 0, 0, 0, 0 });
+    return counters.size() - 1;
+}
+
+uint32_t pulse_counter_read(int32_t counter) {
+    auto& train = counters[counter];
+    advance(train, "pcnt.");
+    return train.count;
+}
+
+bool pulse_index_attach(pinnum_t pin) {
+    indexes.push_back({ pin, Capture::instance().current(), 0, 0, 0, 0 });
+    return true;
+}
+
+uint32_t pulse_index_read(pinnum_t pin, uint64_t& last_us, uint64_t& previous_us) {
+    for (auto& train : indexes) {
+        if (train.pin == pin) {
+            advance(train, "index.");
+            last_us     = train.last_us;
+            previous_us = train.previous_us;
+            return train.count;
+        }
+    }
+    return 0;
+}
+
+uint64_t pulse_time_us() {
+    return uint64_t(Capture::instance().current()) * 1000;
+}
@@ -0,0 +1,38 @@
+#include "Driver/task_stats.h"
+
+#include <chrono>
+
+// Tasks are threads here, so the times are wall-clock times of the host
+
+static int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint32_t profile_ticks() {
+    return uint32_t(now_ns());
+}
+
+uint32_t profile_ticks_per_us() {
+    return 1000;
+}
+
+int64_t profile_uptime_us() {
+    static int64_t boot_ns = now_ns();
+    return (now_ns() - boot_ns) / 1000;
+}
+
+// Each thread has its own copy, so its address identifies the thread
+static thread_local char thread_tag;
+
+void* task_current() {
+    return &thread_tag;
+}
+
+void* task_by_name(const char* name) {
+    return nullptr;
+}
+
+// Threads do not have fixed stacks to measure
+int32_t task_stack_free(void* task) {
+    return -1;
+}
@@ -1,5 +1,7 @@
 #include "Driver/delay_usecs.h"
 
+#include <chrono>
+
 static int counter = 0;
 uint32_t   ticks_per_us;
 
@@ -26,3 +28,8 @@ void spinUntil(int32_t endTicks) {
 int32_t getCpuTicks() {
     return ++counter;
 }
+
+uint32_t getMicros() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return uint32_t(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+}
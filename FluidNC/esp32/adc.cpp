@@ -0,0 +1,41 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "Driver/fluidnc_adc.h"
+
+#include <driver/adc.h>
+#include <esp_adc_cal.h>
+#include <soc/soc_caps.h>
+
+// Only ADC1 is used, because ADC2 is unavailable while WiFi is running
+static int8_t                        adc_channels[SOC_GPIO_PIN_COUNT];
+static esp_adc_cal_characteristics_t adc_characteristics;
+static bool                          adc_characterized = false;
+
+bool adc_attach(pinnum_t pin) {
+    if (!adc_characterized) {
+        for (auto& channel : adc_channels) {
+            channel = -1;
+        }
+        adc1_config_width(ADC_WIDTH_BIT_12);
+        esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, 1100, &adc_characteristics);
+        adc_characterized = true;
+    }
+    for (int channel = 0; channel < ADC1_CHANNEL_MAX; channel++) {
+        gpio_num_t gpio;
+        if (adc1_pad_get_io_num(adc1_channel_t(channel), &gpio) == ESP_OK && gpio == pin) {
+            adc1_config_channel_atten(adc1_channel_t(channel), ADC_ATTEN_DB_11);
+            adc_channels[pin] = channel;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t adc_read_mv(pinnum_t pin) {
+    int channel = adc_channels[pin];
+    if (channel < 0) {
+        return 0;
+    }
+    return esp_adc_cal_raw_to_voltage(adc1_get_raw(adc1_channel_t(channel)), &adc_characteristics);
+}
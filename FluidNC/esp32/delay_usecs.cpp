@@ -2,6 +2,7 @@
 
 #include <esp_attr.h>  // IRAM_ATTR
 #include <xtensa/core-macros.h>
+#include <esp_timer.h>
 
 #include <sdkconfig.h>
 
@@ -59,3 +60,7 @@ void IRAM_ATTR spinUntil(int32_t endTicks) {
 int32_t IRAM_ATTR getCpuTicks() {
     return XTHAL_GET_CCOUNT();
 }
+
+uint32_t IRAM_ATTR getMicros() {
+    return uint32_t(esp_timer_get_time());
+}
@@ -35,6 +35,9 @@ uint32_t i2s_frame_us;  // 1, 2 or 4
 
 static volatile uint32_t i2s_out_port_data = 0;
 
+// Serializes read-modify-write updates of i2s_out_port_data
+static portMUX_TYPE i2s_out_mux = portMUX_INITIALIZER_UNLOCKED;
+
 static bool i2s_out_initialized = 0;
 
 static pinnum_t i2s_out_ws_pin   = INVALID_PINNUM;
@@ -157,20 +160,27 @@ void i2s_out_delay() {
 }
 
 void IRAM_ATTR i2s_out_write(pinnum_t pin, uint8_t val) {
-    uint32_t bit = 1 << pin;
-    if (val) {
-        i2s_out_port_data |= bit;
-    } else {
-        i2s_out_port_data &= ~bit;
-    }
+    i2s_out_batch_t batch;
+    i2s_out_batch_begin(&batch);
+    i2s_out_batch_write(&batch, pin, val);
+    i2s_out_batch_commit(&batch);
+}
 
+void IRAM_ATTR i2s_out_batch_commit(const i2s_out_batch_t* batch) {
+    if (!(batch->set | batch->clear)) {
+        return;
+    }
+    portENTER_CRITICAL_SAFE(&i2s_out_mux);
+    uint32_t port_data = (i2s_out_port_data & ~batch->clear) | batch->set;
+    i2s_out_port_data  = port_data;
     if (!timer_running) {
         // Direct write to the I2S FIFO in case the pulse timer is not running
-        I2S0.fifo_wr = i2s_out_port_data;
+        I2S0.fifo_wr = port_data;
     }
+    portEXIT_CRITICAL_SAFE(&i2s_out_mux);
 }
 
-uint8_t i2s_out_read(pinnum_t pin) {
+uint8_t IRAM_ATTR i2s_out_read(pinnum_t pin) {
     uint32_t port_data = i2s_out_port_data;
     return !!(port_data & (1 << pin));
 }
@@ -426,11 +436,12 @@ static uint32_t init_step_pin(pinnum_t step_pin, bool step_invert) {
     return step_pin;
 }
 
-// This modifies a memory variable that contains the desired
-// pin states.  Later, that variable will be transferred to
-// the I2S FIFO to change all the affected pins at once.
+// Direction changes are collected in a batch, so all of the
+// direction pins change together in finish_dir().
+static i2s_out_batch_t _dir_batch;
+
 static IRAM_ATTR void set_dir_pin(pinnum_t pin, bool level) {
-    i2s_out_write(pin, level);
+    i2s_out_batch_write(&_dir_batch, pin, level);
 }
 
 // For direction changes, we push one sample to the FIFO
@@ -439,6 +450,8 @@ static IRAM_ATTR void set_dir_pin(pinnum_t pin, bool level) {
 // that we use for step pulses, but the optimization might not
 // be worthwhile since direction changes are infrequent.
 static IRAM_ATTR void finish_dir() {
+    i2s_out_batch_commit(&_dir_batch);
+    i2s_out_batch_begin(&_dir_batch);
     I2S0.fifo_wr = i2s_out_port_data;
     delay_us(_dir_delay_us);
 }
@@ -16,6 +16,7 @@
 #include <driver/gpio.h>
 #include "hal/gpio_hal.h"
 #include <esp_attr.h>  // IRAM_ATTR
+#include <freertos/FreeRTOS.h>
 #include "driver/dedic_gpio.h"
 #include "hal/cpu_ll.h"
 #include <esp_idf_version.h>
@@ -38,6 +39,9 @@ static int32_t _stepPulseEndTime;
 static uint32_t i2s_output_ = 0;
 static uint32_t i2s_pulse_  = 0;
 
+// Serializes read-modify-write updates of i2s_output_
+static portMUX_TYPE i2s_out_mux = portMUX_INITIALIZER_UNLOCKED;
+
 struct dedic_gpio_bundle_t* bundle = NULL;
 
 static void setup_dedicated_gpios(pinnum_t bck_pin, pinnum_t data_pin, pinnum_t ws_pin) {
@@ -148,14 +152,21 @@ static void IRAM_ATTR i2s_out_gpio_shiftout(uint32_t port_data) {
 }
 
 void IRAM_ATTR i2s_out_write(pinnum_t pin, uint8_t val) {
-    uint32_t bit = 1 << pin;
-    if (val) {
-        i2s_output_ |= bit;
-    } else {
-        i2s_output_ &= ~bit;
-    }
+    i2s_out_batch_t batch;
+    i2s_out_batch_begin(&batch);
+    i2s_out_batch_write(&batch, pin, val);
+    i2s_out_batch_commit(&batch);
+}
 
+// One shiftout for all of the changed bits
+void IRAM_ATTR i2s_out_batch_commit(const i2s_out_batch_t* batch) {
+    if (!(batch->set | batch->clear)) {
+        return;
+    }
+    portENTER_CRITICAL_SAFE(&i2s_out_mux);
+    i2s_output_ = (i2s_output_ & ~batch->clear) | batch->set;
     i2s_out_gpio_shiftout(i2s_output_);
+    portEXIT_CRITICAL_SAFE(&i2s_out_mux);
 }
 
 void IRAM_ATTR i2s_out_delay() {}
@@ -197,13 +208,12 @@ static uint32_t init_step_pin(pinnum_t step_pin, bool step_invert) {
     return step_pin;
 }
 
+// Direction changes are collected in a batch, so all of the
+// direction pins go out in one shiftout in finish_dir().
+static i2s_out_batch_t _dir_batch;
+
 static void IRAM_ATTR set_pin(pinnum_t pin, bool level) {
-    if (level) {
-        i2s_output_ |= (uint32_t)(1u << (int)pin);
-    } else {
-        i2s_output_ &= (uint32_t)(~(1u << (int)pin));
-    }
-    i2s_out_gpio_shiftout(i2s_output_);
+    i2s_out_batch_write(&_dir_batch, pin, level);
 }
 
 static void IRAM_ATTR set_step_pin(pinnum_t pin, bool level) {
@@ -215,6 +225,8 @@ static void IRAM_ATTR set_step_pin(pinnum_t pin, bool level) {
 }
 
 static void IRAM_ATTR finish_dir() {
+    i2s_out_batch_commit(&_dir_batch);
+    i2s_out_batch_begin(&_dir_batch);
     delay_us(_dir_delay_us);
 }
 
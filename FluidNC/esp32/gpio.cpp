@@ -6,10 +6,23 @@
 #include "Protocol.h"
 #include "Driver/fluidnc_gpio.h"
 #include "Pin.h"
+#include "InputFilter.h"
 
 #include "driver/gpio.h"
 #include "hal/gpio_hal.h"
+#include "hal/timer_ll.h"
 #include "rom/gpio.h"  // gpio_matrix_*
+#include "esp_intr_alloc.h"
+#include "soc/timer_periph.h"
+#include <esp_idf_version.h>
+#if ESP_IDF_VERSION_MAJOR < 5
+#    include "driver/periph_ctrl.h"
+#else
+#    include "esp_private/periph_ctrl.h"
+#endif
+#if SOC_GPIO_SUPPORT_PIN_GLITCH_FILTER
+#    include "driver/gpio_filter.h"
+#endif
 
 static gpio_dev_t* _gpio_dev = GPIO_HAL_GET_HW(GPIO_PORT_0);
 
@@ -20,6 +33,19 @@ bool IRAM_ATTR gpio_read(pinnum_t pin) {
     return gpio_ll_get_level(_gpio_dev, (gpio_num_t)pin);
 }
 
+bool gpio_output_regs(pinnum_t pin, volatile uint32_t** set_reg, volatile uint32_t** clear_reg, uint32_t* mask) {
+    if (pin < 32) {
+        *set_reg   = &_gpio_dev->out_w1ts;
+        *clear_reg = &_gpio_dev->out_w1tc;
+        *mask      = 1u << pin;
+    } else {
+        *set_reg   = &_gpio_dev->out1_w1ts.val;
+        *clear_reg = &_gpio_dev->out1_w1tc.val;
+        *mask      = 1u << (pin - 32);
+    }
+    return true;
+}
+
 static void gpio_send_initial_event(int32_t gpio_num);
 
 void gpio_mode(pinnum_t pin, bool input, bool output, bool pullup, bool pulldown, bool opendrain) {
@@ -114,6 +140,9 @@ static void gpios_update(gpio_mask_t& gpios, int32_t gpio_num, bool active) {
 
 static void* gpioArgs[MAX_N_GPIO + 1];
 
+static InputFilter gpio_filter;
+static uint32_t    gpio_filter_hz = 0;  // 0 means that poll_gpios() takes the samples
+
 void gpio_set_event(int32_t gpio_num, void* arg, bool invert) {
     gpioArgs[gpio_num] = arg;
 
@@ -121,6 +150,7 @@ void gpio_set_event(int32_t gpio_num, void* arg, bool invert) {
     gpios_update(gpios_inverted, gpio_num, invert);
     gpio_set_rate_limit(gpio_num, 5);
     auto active = gpio_is_active(gpio_num);
+    gpio_filter.set_level(gpio_num, active);
 
     // Set current to the opposite of the current state so the first poll will send the current state
     gpios_update(gpios_current, gpio_num, !active);
@@ -162,7 +192,10 @@ static void gpio_send_event(int32_t gpio_num, bool active) {
 }
 
 void poll_gpios() {
-    gpio_mask_t gpios_active  = get_gpios();
+    if (!gpio_filter_hz && gpio_filter.filtered()) {
+        gpio_filter.sample(get_gpios());
+    }
+    gpio_mask_t gpios_active  = gpio_filter.apply(get_gpios());
     gpio_mask_t gpios_changed = (gpios_active ^ gpios_current) & gpios_interest;
 
     // Process each changed GPIO. We check gpios_changed != 0 explicitly because
@@ -176,3 +209,110 @@ void poll_gpios() {
         gpios_changed &= ~gpio_mask(gpio_num);
     }
 }
+
+void gpio_set_filter(pinnum_t pin, uint32_t samples) {
+#if SOC_GPIO_SUPPORT_PIN_GLITCH_FILTER
+    // Where the hardware has a pin glitch filter, use it to remove
+    // very short spikes before they reach the sampling filter
+    if (samples > 1) {
+        gpio_pin_glitch_filter_config_t glitch_config = {};
+        glitch_config.gpio_num                        = (gpio_num_t)pin;
+        gpio_glitch_filter_handle_t glitch_filter;
+        if (gpio_new_pin_glitch_filter(&glitch_config, &glitch_filter) == ESP_OK) {
+            gpio_glitch_filter_enable(glitch_filter);
+        }
+    }
+#endif
+    gpio_filter.set_samples(pin, samples, gpio_is_active(pin));
+}
+
+uint32_t gpio_filter_samples(pinnum_t pin) {
+    return gpio_filter.samples(pin);
+}
+
+uint32_t gpio_filter_glitches(pinnum_t pin) {
+    return gpio_filter.glitches(pin);
+}
+
+uint32_t gpio_filter_rate() {
+    return gpio_filter_hz;
+}
+
+// The filter samples all GPIOs at once from the interrupt of timer 0 in
+// timer group 1.  Timer group 0 timer 0 is the stepping timer.
+static const uint32_t fFilterTimer = 1000000;  // Count at 1 MHz
+
+#if ESP_IDF_VERSION_MAJOR < 5
+static void IRAM_ATTR gpio_filter_isr(void* arg) {
+    timer_ll_clear_intr_status(&TIMERG1, TIMER_0);
+    gpio_filter.sample(get_gpios());
+    // The alarm enable is cleared when the alarm occurs
+    timer_ll_set_alarm_enable(&TIMERG1, TIMER_0, true);
+}
+
+void gpio_filter_start(uint32_t sample_hz) {
+    if (gpio_filter_hz || !gpio_filter.filtered() || !sample_hz) {
+        return;
+    }
+    periph_module_enable(PERIPH_TIMG1_MODULE);
+
+    timer_ll_intr_disable(&TIMERG1, TIMER_0);
+    timer_ll_set_counter_enable(&TIMERG1, TIMER_0, TIMER_PAUSE);
+    timer_ll_set_divider(&TIMERG1, TIMER_0, APB_CLK_FREQ / fFilterTimer);
+    timer_ll_set_counter_increase(&TIMERG1, TIMER_0, true);
+    timer_ll_set_counter_value(&TIMERG1, TIMER_0, 0ULL);
+    timer_ll_set_alarm_value(&TIMERG1, TIMER_0, (uint64_t)(fFilterTimer / sample_hz));
+    timer_ll_set_auto_reload(&TIMERG1, TIMER_0, true);
+    timer_ll_clear_intr_status(&TIMERG1, TIMER_0);
+
+    esp_intr_alloc_intrstatus(timer_group_periph_signals.groups[TIMER_GROUP_1].t0_irq_id,
+                              ESP_INTR_FLAG_IRAM | ESP_INTR_FLAG_LEVEL1,
+                              timer_ll_get_intr_status_reg(&TIMERG1),
+                              1 << TIMER_0,
+                              gpio_filter_isr,
+                              NULL,
+                              NULL);
+
+    timer_ll_intr_enable(&TIMERG1, TIMER_0);
+    timer_ll_set_alarm_enable(&TIMERG1, TIMER_0, true);
+    timer_ll_set_counter_enable(&TIMERG1, TIMER_0, true);
+    gpio_filter_hz = sample_hz;
+}
+#else
+static void IRAM_ATTR gpio_filter_isr(void* arg) {
+    timer_ll_clear_intr_status(&TIMERG1, TIMER_LL_EVENT_ALARM(0));
+    gpio_filter.sample(get_gpios());
+    // The alarm enable is cleared when the alarm occurs
+    timer_ll_enable_alarm(&TIMERG1, 0, true);
+}
+
+void gpio_filter_start(uint32_t sample_hz) {
+    if (gpio_filter_hz || !gpio_filter.filtered() || !sample_hz) {
+        return;
+    }
+    periph_module_enable(PERIPH_TIMG1_MODULE);
+
+    timer_ll_enable_intr(&TIMERG1, TIMER_LL_EVENT_ALARM(0), false);
+    timer_ll_enable_counter(&TIMERG1, 0, false);
+    timer_ll_set_clock_prescale(&TIMERG1, 0, APB_CLK_FREQ / fFilterTimer);
+    timer_ll_set_count_direction(&TIMERG1, 0, gptimer_count_direction_t::GPTIMER_COUNT_UP);
+    timer_ll_set_reload_value(&TIMERG1, 0, 0ULL);
+    timer_ll_trigger_soft_reload(&TIMERG1, 0);
+    timer_ll_set_alarm_value(&TIMERG1, 0, (uint64_t)(fFilterTimer / sample_hz));
+    timer_ll_enable_auto_reload(&TIMERG1, 0, true);
+    timer_ll_clear_intr_status(&TIMERG1, TIMER_LL_EVENT_ALARM(0));
+
+    esp_intr_alloc_intrstatus(timer_group_periph_signals.groups[1].timer_irq_id[0],
+                              ESP_INTR_FLAG_IRAM | ESP_INTR_FLAG_LEVEL1,
+                              (uint32_t)timer_ll_get_intr_status_reg(&TIMERG1),
+                              TIMER_LL_EVENT_ALARM(0),
+                              gpio_filter_isr,
+                              NULL,
+                              NULL);
+
+    timer_ll_enable_intr(&TIMERG1, TIMER_LL_EVENT_ALARM(0), true);
+    timer_ll_enable_alarm(&TIMERG1, 0, true);
+    timer_ll_enable_counter(&TIMERG1, 0, true);
+    gpio_filter_hz = sample_hz;
+}
+#endif
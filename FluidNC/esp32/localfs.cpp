@@ -8,6 +8,7 @@
 #include "string_util.h"
 #include "Config.h"
 #include "esp_partition.h"
+#include "sdkconfig.h"
 #include "Logging.h"
 
 const char* spiffsName      = "spiffs";
@@ -94,3 +95,21 @@ uint64_t localfs_size() {
     }
     return space.capacity;
 }
+
+// The esp_littlefs defaults, for builds whose sdkconfig does not set them
+#ifndef CONFIG_LITTLEFS_BLOCK_SIZE
+#    define CONFIG_LITTLEFS_BLOCK_SIZE 4096
+#endif
+#ifndef CONFIG_LITTLEFS_CACHE_SIZE
+#    define CONFIG_LITTLEFS_CACHE_SIZE 512
+#endif
+
+bool localfs_littlefs_geometry(uint32_t& block_size, uint32_t& inline_max) {
+    if (LocalFS.prefix != littlefsPrefix) {
+        return false;
+    }
+    block_size = CONFIG_LITTLEFS_BLOCK_SIZE;
+    // LittleFS inlines files that fit in its cache
+    inline_max = CONFIG_LITTLEFS_CACHE_SIZE;
+    return true;
+}
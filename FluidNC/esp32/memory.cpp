@@ -0,0 +1,41 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "Driver/fluidnc_memory.h"
+
+#include <esp_heap_caps.h>
+
+// PSRAM is in the heap when the build enables it (BOARD_HAS_PSRAM) and the
+// chip is present, and is then found with MALLOC_CAP_SPIRAM
+
+static const uint32_t internal_caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+static const uint32_t external_caps = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+static const uint32_t dma_caps      = MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL;
+
+bool memory_has_external() {
+    return heap_caps_get_total_size(MALLOC_CAP_SPIRAM) != 0;
+}
+
+void* memory_alloc(size_t size, MemoryTier tier) {
+    if (tier == MemoryTier::Dma) {
+        return heap_caps_malloc(size, dma_caps);
+    }
+    if (tier == MemoryTier::External && memory_has_external()) {
+        return heap_caps_malloc(size, external_caps);
+    }
+    return heap_caps_malloc(size, internal_caps);
+}
+
+void memory_free(void* ptr) {
+    heap_caps_free(ptr);
+}
+
+size_t memory_free_bytes(MemoryTier tier) {
+    if (tier == MemoryTier::Dma) {
+        return heap_caps_get_free_size(dma_caps);
+    }
+    if (tier == MemoryTier::External && memory_has_external()) {
+        return heap_caps_get_free_size(external_caps);
+    }
+    return heap_caps_get_free_size(internal_caps);
+}
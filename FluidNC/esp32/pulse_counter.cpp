@@ -0,0 +1,135 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "Driver/pulse_counter.h"
+
+#include <driver/pcnt.h>
+#include <driver/gpio.h>
+#include <esp_timer.h>
+#include <esp_attr.h>
+#include <soc/soc_caps.h>
+
+// The hardware counters are 16 bits.  A counter interrupts when it reaches
+// high_limit and restarts from 0, and the interrupt extends the count.
+static const int16_t high_limit = 30000;
+
+struct Counter {
+    bool              used  = false;
+    volatile uint32_t wraps = 0;
+    uint32_t          last  = 0;
+};
+static Counter counters[PCNT_UNIT_MAX];
+static bool    pcnt_isr_installed = false;
+
+static void IRAM_ATTR counter_isr(void* arg) {
+    counters[intptr_t(arg)].wraps += high_limit;
+}
+
+int32_t pulse_counter_attach(pinnum_t pin, uint32_t filter_ns) {
+    int unit = 0;
+    while (unit < PCNT_UNIT_MAX && counters[unit].used) {
+        ++unit;
+    }
+    if (unit == PCNT_UNIT_MAX) {
+        return -1;
+    }
+    auto u = pcnt_unit_t(unit);
+
+    pcnt_config_t config  = {};
+    config.pulse_gpio_num = pin;
+    config.ctrl_gpio_num  = PCNT_PIN_NOT_USED;
+    config.channel        = PCNT_CHANNEL_0;
+    config.unit           = u;
+    config.pos_mode       = PCNT_COUNT_INC;
+    config.neg_mode       = PCNT_COUNT_DIS;
+    config.lctrl_mode     = PCNT_MODE_KEEP;
+    config.hctrl_mode     = PCNT_MODE_KEEP;
+    config.counter_h_lim  = high_limit;
+    config.counter_l_lim  = 0;
+    if (pcnt_unit_config(&config) != ESP_OK) {
+        return -1;
+    }
+
+    // The filter counts APB clock cycles, 80 per microsecond, up to 1023
+    uint32_t cycles = filter_ns * 80 / 1000;
+    if (cycles) {
+        pcnt_set_filter_value(u, cycles > 1023 ? 1023 : cycles);
+        pcnt_filter_enable(u);
+    } else {
+        pcnt_filter_disable(u);
+    }
+
+    pcnt_event_enable(u, PCNT_EVT_H_LIM);
+    if (!pcnt_isr_installed) {
+        pcnt_isr_service_install(0);
+        pcnt_isr_installed = true;
+    }
+    pcnt_isr_handler_add(u, counter_isr, (void*)intptr_t(unit));
+
+    pcnt_counter_pause(u);
+    pcnt_counter_clear(u);
+    pcnt_counter_resume(u);
+    counters[unit].used = true;
+    return unit;
+}
+
+uint32_t pulse_counter_read(int32_t counter) {
+    auto&    c = counters[counter];
+    uint32_t wraps;
+    int16_t  count;
+    do {
+        wraps = c.wraps;
+        pcnt_get_counter_value(pcnt_unit_t(counter), &count);
+    } while (wraps != c.wraps);
+
+    // A read after the counter restarts but before the interrupt extends
+    // the count would go backwards
+    uint32_t value = wraps + uint16_t(count);
+    if (int32_t(value - c.last) < 0) {
+        value = c.last;
+    }
+    c.last = value;
+    return value;
+}
+
+struct Index {
+    volatile uint32_t count       = 0;
+    volatile uint64_t last_us     = 0;
+    volatile uint64_t previous_us = 0;
+};
+static Index* indexes[SOC_GPIO_PIN_COUNT];
+
+static void IRAM_ATTR index_isr(void* arg) {
+    auto index         = static_cast<Index*>(arg);
+    index->previous_us = index->last_us;
+    index->last_us     = esp_timer_get_time();
+    index->count       = index->count + 1;
+}
+
+bool pulse_index_attach(pinnum_t pin) {
+    if (!indexes[pin]) {
+        indexes[pin] = new Index();
+    }
+    gpio_install_isr_service(ESP_INTR_FLAG_IRAM);  // Returns an error if already installed
+    auto gpio = gpio_num_t(pin);
+    gpio_set_intr_type(gpio, GPIO_INTR_POSEDGE);
+    return gpio_isr_handler_add(gpio, index_isr, indexes[pin]) == ESP_OK;
+}
+
+uint32_t pulse_index_read(pinnum_t pin, uint64_t& last_us, uint64_t& previous_us) {
+    auto index = indexes[pin];
+    if (!index) {
+        return 0;
+    }
+    uint32_t count;
+    do {
+        count       = index->count;
+        last_us     = index->last_us;
+        previous_us = index->previous_us;
+    } while (count != index->count);
+    return count;
+}
+
+uint64_t pulse_time_us() {
+    return esp_timer_get_time();
+}
@@ -13,10 +13,17 @@
 #include <soc/sdmmc_struct.h>
 #include <sdmmc_cmd.h>
 #include <driver/sdspi_host.h>
+#include <esp_heap_caps.h>
 #include <esp_error.hpp>
+#include <cstring>
 
 #include "Driver/sdspi.h"
 #include "Config.h"
+#include "BlockCache.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
 
 #define CHECK_EXECUTE_RESULT(err, str)                                                                                                     \
     do {                                                                                                                                   \
@@ -26,10 +33,209 @@
         }                                                                                                                                  \
     } while (0)
 
+// NOTE: SDSPI_HOST_DEFAULT is incomplete and will give a warning
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+sdmmc_host_t  host_config = SDSPI_HOST_DEFAULT();
+#pragma GCC diagnostic pop
+
+sdmmc_card_t*   card      = NULL;
+const char*     base_path = "/sd";
+static FATFS*   sd_fs     = NULL;
+static uint32_t sd_mounts = 0;  // Counts mounts, for sd_volume_signature()
+
+// The clock requested by the configuration.  If the card gives CRC errors,
+// the clock steps down through this list until transfers are reliable.
+// After a run of clean reads at a lowered clock, it steps back up one
+// entry at a time, toward the configured clock.  Each failed attempt to
+// step up doubles the run needed before the next one, so a card that is
+// marginal at the higher clock is not retried often.
+static uint32_t       configured_khz  = SDMMC_FREQ_DEFAULT;
+static const uint32_t sd_clocks_khz[] = { 40000, 26667, 20000, 16000, 10000, 8000, 4000, 1000, SDMMC_FREQ_PROBING };
+
+static const uint32_t min_clean_reads = 1024;
+static uint32_t       raise_after     = min_clean_reads;  // Clean reads needed before the next step up
+static uint32_t       clean_reads     = 0;                // Clean reads at the current clock
+static bool           raised          = false;            // The current clock came from a step up
+
+static void reset_clock_negotiation() {
+    host_config.max_freq_khz = configured_khz;
+    raise_after              = min_clean_reads;
+    clean_reads              = 0;
+    raised                   = false;
+}
+
+static bool lower_clock() {
+    for (auto khz : sd_clocks_khz) {
+        if (khz < host_config.max_freq_khz) {
+            if (raised && raise_after < 0x10000000) {
+                raise_after *= 2;
+            }
+            raised                   = false;
+            clean_reads              = 0;
+            host_config.max_freq_khz = khz;
+            host_config.set_card_clk(host_config.slot, khz);
+            log_warn("SD: CRC errors, lowering clock to " << khz << " kHz");
+            return true;
+        }
+    }
+    return false;
+}
+
+static void raise_clock() {
+    uint32_t khz = host_config.max_freq_khz;
+    for (auto candidate : sd_clocks_khz) {
+        if (candidate > host_config.max_freq_khz && candidate <= configured_khz) {
+            khz = candidate;  // The list is descending, so this ends at the next step up
+        }
+    }
+    if (khz == host_config.max_freq_khz) {
+        return;
+    }
+    raised                   = true;
+    clean_reads              = 0;
+    host_config.max_freq_khz = khz;
+    host_config.set_card_clk(host_config.slot, khz);
+    log_info("SD: raising clock to " << khz << " kHz");
+}
+
+static bool read_sectors(uint32_t sector, uint32_t count, uint8_t* buf) {
+    esp_err_t err;
+    while ((err = sdmmc_read_sectors(card, buf, sector, count)) == ESP_ERR_INVALID_CRC) {
+        if (!lower_clock()) {
+            break;
+        }
+    }
+    if (err != ESP_OK) {
+        log_debug("SD: read of " << count << " sectors at " << sector << " failed code " << to_hex(err));
+        return false;
+    }
+    if (host_config.max_freq_khz < configured_khz && ++clean_reads >= raise_after) {
+        raise_clock();
+    }
+    return true;
+}
+
+// Read-ahead cache between FATFS and the card.  FATFS serializes access to
+// the volume, but the prefetch task does not go through FATFS, so all cache
+// access is under read_cache_lock.
+static uint32_t          read_cache_bytes = 8192;
+static BlockCache*       read_cache       = nullptr;
+static SemaphoreHandle_t read_cache_lock  = nullptr;
+static TaskHandle_t      prefetch_task    = nullptr;
+
+static void prefetch_loop(void* unused) {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        xSemaphoreTake(read_cache_lock, portMAX_DELAY);
+        if (read_cache) {
+            read_cache->prefetch();
+        }
+        xSemaphoreGive(read_cache_lock);
+    }
+}
+
+static DSTATUS cached_init(BYTE pdrv) {
+    return sdmmc_get_status(card) == ESP_OK ? 0 : STA_NOINIT;
+}
+
+static DSTATUS cached_status(BYTE pdrv) {
+    return 0;
+}
+
+static DRESULT cached_read(BYTE pdrv, BYTE* buff, uint32_t sector, UINT count) {
+    xSemaphoreTake(read_cache_lock, portMAX_DELAY);
+    bool ok      = read_cache->read(buff, sector, count);
+    bool pending = read_cache->prefetch_pending();
+    xSemaphoreGive(read_cache_lock);
+    if (pending) {
+        xTaskNotifyGive(prefetch_task);
+    }
+    return ok ? RES_OK : RES_ERROR;
+}
+
+static DRESULT cached_write(BYTE pdrv, const BYTE* buff, uint32_t sector, UINT count) {
+    xSemaphoreTake(read_cache_lock, portMAX_DELAY);
+    read_cache->invalidate(sector, count);
+    esp_err_t err = sdmmc_write_sectors(card, buff, sector, count);
+    xSemaphoreGive(read_cache_lock);
+    return err == ESP_OK ? RES_OK : RES_ERROR;
+}
+
+static DRESULT cached_ioctl(BYTE pdrv, BYTE cmd, void* buff) {
+    switch (cmd) {
+        case CTRL_SYNC:
+            return RES_OK;
+        case GET_SECTOR_COUNT:
+            *((DWORD*)buff) = card->csd.capacity;
+            return RES_OK;
+        case GET_SECTOR_SIZE:
+            *((WORD*)buff) = card->csd.sector_size;
+            return RES_OK;
+        default:
+            return RES_ERROR;
+    }
+}
+
+static const ff_diskio_impl_t cached_impl = {
+    .init   = &cached_init,
+    .status = &cached_status,
+    .read   = &cached_read,
+    .write  = &cached_write,
+    .ioctl  = &cached_ioctl,
+};
+
+// cppcheck-suppress unusedFunction
+void sd_set_read_cache(uint32_t chunk_bytes) {
+    read_cache_bytes = chunk_bytes;
+}
+
+static void start_read_cache(uint8_t pdrv) {
+    uint32_t sector_size = card->csd.sector_size;
+    if (!read_cache_bytes || read_cache_bytes < sector_size) {
+        return;
+    }
+    if (!read_cache_lock) {
+        read_cache_lock = xSemaphoreCreateMutex();
+        xTaskCreatePinnedToCore(prefetch_loop,     // task
+                                "sdPrefetch",      // name for task
+                                2048,              // size of task stack
+                                NULL,              // parameters
+                                1,                 // priority
+                                &prefetch_task,
+                                SUPPORT_TASK_CORE  // core
+        );
+    }
+    read_cache = new BlockCache(read_sectors, sector_size, read_cache_bytes / sector_size, card->csd.capacity);
+    if (!read_cache->ok()) {
+        log_warn("SD read cache disabled; not enough DMA-capable RAM for " << read_cache_bytes << " byte chunks");
+        delete read_cache;
+        read_cache = nullptr;
+        return;
+    }
+
+    // Replaces the plain SDMMC disk I/O registered by ff_diskio_register_sdmmc()
+    ff_diskio_register(pdrv, &cached_impl);
+}
+
+static void stop_read_cache() {
+    if (!read_cache) {
+        return;
+    }
+    xSemaphoreTake(read_cache_lock, portMAX_DELAY);
+    auto& stats = read_cache->stats();
+    log_debug("SD cache hits:" << stats.hits << " misses:" << stats.misses << " prefetches:" << stats.prefetches
+                               << " direct:" << stats.direct << " errors:" << stats.errors);
+    delete read_cache;
+    read_cache = nullptr;
+    xSemaphoreGive(read_cache_lock);
+}
+
 static esp_err_t mount_to_vfs_fat(uint32_t max_files, sdmmc_card_t* card, uint8_t pdrv, const char* base_path) {
     FATFS*    fs = NULL;
     esp_err_t err;
     ff_diskio_register_sdmmc(pdrv, card);
+    start_read_cache(pdrv);
 
     //    ESP_LOGD(TAG, "using pdrv=%i", pdrv);
     // Drive names are "0:", "1:", etc.
@@ -53,6 +259,8 @@ static esp_err_t mount_to_vfs_fat(uint32_t max_files, sdmmc_card_t* card, uint8_
         //        ESP_LOGW(TAG, "failed to mount card (%d)", res);
         goto fail;
     }
+    sd_fs = fs;
+    ++sd_mounts;
     return ESP_OK;
 
 fail:
@@ -61,18 +269,10 @@ fail:
     }
     esp_vfs_fat_unregister_path(base_path);
     ff_diskio_unregister(pdrv);
+    stop_read_cache();
     return err;
 }
 
-// NOTE: SDSPI_HOST_DEFAULT is incomplete and will give a warning
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
-sdmmc_host_t  host_config = SDSPI_HOST_DEFAULT();
-#pragma GCC diagnostic pop
-
-sdmmc_card_t* card        = NULL;
-const char*   base_path   = "/sd";
-
 static void call_host_deinit(const sdmmc_host_t* host_config) {
     if (host_config->flags & SDMMC_HOST_FLAG_DEINIT_ARG) {
         host_config->deinit_p(host_config->slot);
@@ -97,7 +297,8 @@ bool sd_init_slot(uint32_t freq_hz, pinnum_t cs_pin, pinnum_t cd_pin, pinnum_t w
     sdspi_device_config_t slot_config;
 
     host_config.flags &= ~SDMMC_HOST_FLAG_DDR;
-    host_config.max_freq_khz = freq_hz / 1000;
+    configured_khz           = freq_hz / 1000;
+    host_config.max_freq_khz = configured_khz;
 
     err = host_config.init();
     CHECK_EXECUTE_RESULT(err, "host init failed");
@@ -131,6 +332,8 @@ std::error_code sd_mount(uint32_t max_files) {
     log_verbose("Mount_sd");
     esp_err_t err;
 
+    // Each mount starts over at the configured clock, as it may be a different card
+    reset_clock_negotiation();
     if ((err = host_config.set_card_clk(host_config.slot, host_config.max_freq_khz)) != ESP_OK) {
         log_debug("spi_set_card_clk failed");
         return esp_error::make_error_code(err);
@@ -157,14 +360,28 @@ std::error_code sd_mount(uint32_t max_files) {
     }
     // /mount_prepare_mem()
 
-    // probe and initialize card
-    err = sdmmc_card_init(&host_config, card);
-    if (err != ESP_OK) {
-        // Some cards fail the first time after they are inserted, but then succeed,
-        // so we retry this step once.
+    // probe and initialize card, at the highest clock that gives clean transfers
+    while (true) {
         err = sdmmc_card_init(&host_config, card);
+        if (err != ESP_OK) {
+            // Some cards fail the first time after they are inserted, but then succeed,
+            // so we retry this step once.
+            err = sdmmc_card_init(&host_config, card);
+        }
+        if (err == ESP_OK) {
+            // A multi-block read at the final clock shows whether it is stable
+            uint8_t* test = static_cast<uint8_t*>(heap_caps_malloc(8 * card->csd.sector_size, MALLOC_CAP_DMA));
+            if (test) {
+                err = sdmmc_read_sectors(card, test, 0, 8);
+                free(test);
+            }
+        }
+        if ((err != ESP_ERR_INVALID_CRC && err != ESP_ERR_INVALID_RESPONSE) || !lower_clock()) {
+            break;
+        }
     }
     CHECK_EXECUTE_RESULT(err, "sdmmc_card_init failed");
+    log_debug("SD clock " << host_config.max_freq_khz << " kHz");
 
     err = mount_to_vfs_fat(max_files, card, pdrv, base_path);
     CHECK_EXECUTE_RESULT(err, "mount_to_vfs failed");
@@ -186,16 +403,74 @@ void sd_unmount() {
     // unmount
     const char drv[3] = { (char)('0' + pdrv), ':', 0 };
     f_mount(NULL, drv, 0);
+    sd_fs = NULL;
 
     esp_vfs_fat_unregister_path(base_path);
 
     // release SD driver
     ff_diskio_unregister(pdrv);
+    stop_read_cache();
 
     free(card);
     card = NULL;
 }
 
+struct SdDir {
+    FF_DIR  dir;
+    FILINFO info;
+};
+
+// cppcheck-suppress unusedFunction
+SdDir* sd_opendir(const char* path) {
+    if (!card || !sd_fs) {
+        return nullptr;
+    }
+    size_t base_len = strlen(base_path);
+    if (strncmp(path, base_path, base_len) != 0 || (path[base_len] != '\0' && path[base_len] != '/')) {
+        return nullptr;
+    }
+
+    // Map the VFS path to a FATFS path like "0:/jobs"
+    BYTE        pdrv = ff_diskio_get_pdrv_card(card);
+    std::string fatpath { char('0' + pdrv), ':' };
+    fatpath += path[base_len] ? path + base_len : "/";
+
+    auto dir = new SdDir;
+    if (f_opendir(&dir->dir, fatpath.c_str()) != FR_OK) {
+        delete dir;
+        return nullptr;
+    }
+    return dir;
+}
+
+// cppcheck-suppress unusedFunction
+bool sd_readdir(SdDir* dir, std::string& name, uint32_t& size, bool& is_dir) {
+    if (f_readdir(&dir->dir, &dir->info) != FR_OK || dir->info.fname[0] == '\0') {
+        return false;
+    }
+    name   = dir->info.fname;
+    is_dir = dir->info.fattrib & AM_DIR;
+    size   = is_dir ? 0 : dir->info.fsize;
+    return true;
+}
+
+// cppcheck-suppress unusedFunction
+void sd_closedir(SdDir* dir) {
+    f_closedir(&dir->dir);
+    delete dir;
+}
+
+// A card can be renamed or rewritten elsewhere without changing anything
+// that is cheap to check, such as its serial number or free space, so no
+// listing is trusted from one mount to the next.
+// cppcheck-suppress unusedFunction
+uint32_t sd_volume_signature() {
+    if (!card || !sd_fs) {
+        return 0;
+    }
+    return sd_mounts ? sd_mounts : 1;
+}
+
 // cppcheck-suppress unusedFunction
 void sd_deinit_slot() {
     sdspi_host_remove_device(host_config.slot);
@@ -0,0 +1,36 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "Driver/task_stats.h"
+#include "Driver/delay_usecs.h"  // ticks_per_us
+
+#include <esp_attr.h>  // IRAM_ATTR
+#include <esp_timer.h>
+#include <xtensa/core-macros.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+uint32_t IRAM_ATTR profile_ticks() {
+    return XTHAL_GET_CCOUNT();
+}
+
+uint32_t profile_ticks_per_us() {
+    return ticks_per_us;
+}
+
+int64_t profile_uptime_us() {
+    return esp_timer_get_time();
+}
+
+void* task_current() {
+    return xTaskGetCurrentTaskHandle();
+}
+
+void* task_by_name(const char* name) {
+    return xTaskGetHandle(name);
+}
+
+// In ESP-IDF, stack sizes and high water marks are in bytes
+int32_t task_stack_free(void* task) {
+    return task ? int32_t(uxTaskGetStackHighWaterMark(TaskHandle_t(task))) : -1;
+}
@@ -16,6 +16,9 @@ int32_t usToCpuTicks(int32_t us);
 int32_t usToEndTicks(int32_t us);
 int32_t getCpuTicks();
 
+// Microseconds since boot, wrapping every 71 minutes; safe to call from ISRs
+uint32_t getMicros();
+
 #ifdef __cplusplus
 }
 #endif
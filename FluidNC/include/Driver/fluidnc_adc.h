@@ -0,0 +1,17 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include "Driver/fluidnc_gpio.h"
+
+#include <cstdint>
+
+// Analog input interface
+
+// Prepares a pin for analog reads.  Returns false if the pin has no ADC
+// channel that can be used while WiFi is running.
+bool adc_attach(pinnum_t pin);
+
+// Returns the voltage on an attached pin in millivolts
+uint32_t adc_read_mv(pinnum_t pin);
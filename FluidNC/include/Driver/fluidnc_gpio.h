@@ -22,10 +22,24 @@ void gpio_add_interrupt(pinnum_t pin, int8_t mode, void (*callback)(void*), void
 void gpio_remove_interrupt(pinnum_t pin);
 void gpio_route(pinnum_t pin, uint32_t signal);
 
+// Gets the registers that set and clear an output pin, for writes with a
+// single store.  Returns false if the platform has no such registers.
+bool gpio_output_regs(pinnum_t pin, volatile uint32_t** set_reg, volatile uint32_t** clear_reg, uint32_t* mask);
+
 void gpio_set_event(int32_t gpio_num, void* arg, bool invert);
 void gpio_clear_event(int32_t gpio_num);
 void poll_gpios();
 
+// Input filtering.  An event pin with a filter must read at a new level for
+// "samples" consecutive samples before an event is sent for the change.
+// gpio_filter_start() starts periodic sampling at sample_hz if any pin has
+// a filter; without it, samples are taken by poll_gpios().
+void     gpio_set_filter(pinnum_t pin, uint32_t samples);
+void     gpio_filter_start(uint32_t sample_hz);
+uint32_t gpio_filter_samples(pinnum_t pin);
+uint32_t gpio_filter_glitches(pinnum_t pin);
+uint32_t gpio_filter_rate();
+
 #ifdef __cplusplus
 }
 #endif
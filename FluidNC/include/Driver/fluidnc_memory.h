@@ -0,0 +1,23 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+
+// Memory placement, for buffers that can live in external PSRAM
+
+enum class MemoryTier {
+    Internal,  // Internal RAM, for data touched in interrupts or on every step
+    External,  // PSRAM if the board has it, otherwise internal RAM
+    Dma,       // Internal RAM that DMA can reach, for device transfer buffers
+};
+
+// Returns nullptr if there is not enough memory in the tier
+void* memory_alloc(size_t size, MemoryTier tier);
+void  memory_free(void* ptr);
+
+// True if External allocations go to PSRAM
+bool memory_has_external();
+
+size_t memory_free_bytes(MemoryTier tier);
@@ -70,6 +70,34 @@ void i2s_out_write(pinnum_t pin, uint8_t val);
  */
 void i2s_out_delay();
 
+/*
+  Batched updates.  Bits written to a batch go to the internal pin state
+  var in one locked update when it is committed, so they reach the shift
+  registers together in the same frame.
+*/
+typedef struct {
+    uint32_t set;    // Bits to set
+    uint32_t clear;  // Bits to clear
+} i2s_out_batch_t;
+
+static inline void i2s_out_batch_begin(i2s_out_batch_t* batch) {
+    batch->set   = 0;
+    batch->clear = 0;
+}
+
+static inline void i2s_out_batch_write(i2s_out_batch_t* batch, pinnum_t pin, uint8_t val) {
+    uint32_t bit = 1u << pin;
+    if (val) {
+        batch->set |= bit;
+        batch->clear &= ~bit;
+    } else {
+        batch->clear |= bit;
+        batch->set &= ~bit;
+    }
+}
+
+void i2s_out_batch_commit(const i2s_out_batch_t* batch);
+
 /*
    Reference: "ESP32 Technical Reference Manual" by Espressif Systems
      https://www.espressif.com/sites/default/files/documentation/esp32_technical_reference_manual_en.pdf
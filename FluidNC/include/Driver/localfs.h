@@ -1,9 +1,13 @@
 #pragma once
 #include <filesystem>
 #include <string>
+#include <cstdint>
 
 bool localfs_format(const std::string fsname);
 bool localfs_mount();
 void localfs_unmount();
 
 std::uintmax_t localfs_size();
+
+// The geometry of the local filesystem if it is LittleFS; false otherwise
+bool localfs_littlefs_geometry(uint32_t& block_size, uint32_t& inline_max);
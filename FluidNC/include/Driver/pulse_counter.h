@@ -0,0 +1,28 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include "Driver/fluidnc_gpio.h"
+
+#include <cstdint>
+
+// Hardware pulse counting, for tachometers and encoders
+
+// Starts counting rising edges on pin, ignoring pulses shorter than
+// filter_ns.  Returns a counter number, or -1 if no counter is free.
+int32_t pulse_counter_attach(pinnum_t pin, uint32_t filter_ns);
+
+// Returns the number of edges counted since the counter was attached.
+// The count wraps at 2^32.
+uint32_t pulse_counter_read(int32_t counter);
+
+// Captures the time of each rising edge on pin, for once-per-revolution
+// index pulses.  Returns false if the pin cannot interrupt.
+bool pulse_index_attach(pinnum_t pin);
+
+// Returns the number of index edges seen, and the times of the last two
+uint32_t pulse_index_read(pinnum_t pin, uint64_t& last_us, uint64_t& previous_us);
+
+// Microseconds, on the same clock as the index times
+uint64_t pulse_time_us();
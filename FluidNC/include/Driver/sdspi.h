@@ -1,8 +1,26 @@
 #include "Driver/fluidnc_gpio.h"
 #include <system_error>
+#include <string>
+#include <cstdint>
 
 bool sd_init_slot(uint32_t freq_hz, pinnum_t cs_pin, pinnum_t cd_pin = INVALID_PINNUM, pinnum_t wp_pin = INVALID_PINNUM);
 void sd_unmount();
 void sd_deinit_slot();
 
 std::error_code sd_mount(uint32_t max_files = 3);
+
+// Sets the read-ahead chunk size used by later mounts; 0 disables the cache
+void sd_set_read_cache(uint32_t chunk_bytes);
+
+// One-pass directory listing of the mounted card.  Unlike readdir() followed
+// by stat(), which searches the directory again for every entry, this gets
+// each entry's size and type as the directory is read.  sd_opendir() returns
+// nullptr if the path is not a directory on the card.
+struct SdDir;
+SdDir* sd_opendir(const char* path);
+bool   sd_readdir(SdDir* dir, std::string& name, uint32_t& size, bool& is_dir);
+void   sd_closedir(SdDir* dir);
+
+// Changes at every mount, so cached directory listings are only reused
+// while the card stays mounted.  0 if not mounted.
+uint32_t sd_volume_signature();
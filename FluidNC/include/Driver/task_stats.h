@@ -0,0 +1,22 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+// Task information for the profiler.  Task handles are opaque; a null
+// handle means that the task is unknown.
+
+#include <stdint.h>
+
+// A fast counter for timing short sections of code, safe to call from ISRs
+uint32_t profile_ticks();
+uint32_t profile_ticks_per_us();
+
+// Time since boot, which does not wrap
+int64_t profile_uptime_us();
+
+void* task_current();
+void* task_by_name(const char* name);
+
+// Stack space that the task has never used, in bytes, or -1 if unknown
+int32_t task_stack_free(void* task);
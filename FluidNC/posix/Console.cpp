@@ -9,6 +9,7 @@
 
 #include "Channel.h"
 #include "lineedit.h"
+#include "Replay.h"
 
 static struct termios _orig_termios;
 
@@ -72,6 +73,7 @@ public:
     // Print methods (Stream inherits from Print)
     size_t write(uint8_t c) override {
         //        fflush(STDOUT);
+        Replay::instance().output("console", &c, 1);
         return ::write(STDOUT_FILENO, &c, 1);
     }
 
@@ -79,10 +81,15 @@ public:
 
     int available(void) override {
         int n;
-        return ioctl(STDIN_FILENO, FIONREAD, &n) ? 0 : n;
+        return Replay::instance().available("console", ioctl(STDIN_FILENO, FIONREAD, &n) ? 0 : n);
     }
 
     int read() override {
+        auto& replay = Replay::instance();
+        if (replay.mode() == Replay::Mode::Replay) {
+            return replay.read("console", -1);
+        }
+
         int n;
         if ((n = available()) < 1) {
             return -1;
@@ -90,7 +97,7 @@ public:
 
         char c;
         auto ret = ::read(STDIN_FILENO, &c, 1);
-        return ret == 1 ? c : -1;
+        return replay.read("console", ret == 1 ? c : -1);
     }
 
     // Channel methods
@@ -0,0 +1,129 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "AdaptiveFeed.h"
+
+#include "Machine/MachineConfig.h"
+#include "Driver/fluidnc_adc.h"
+#include "Protocol.h"  // protocol_send_event
+#include "State.h"     // state_is
+#include "Spindles/Spindle.h"
+
+/*
+
+adaptive_feed:
+  source: spindle
+  target_load_percent: 70
+  deadband_percent: 3
+  gain: 2.0
+  min_feed_percent: 50
+  max_feed_percent: 120
+  smoothing_ms: 300
+  update_ms: 100
+
+*/
+
+static const EnumItem sourceTypes[] = { { AdaptiveFeed::FROM_SPINDLE, "spindle" },
+                                        { AdaptiveFeed::FROM_ADC, "adc" },
+                                        { AdaptiveFeed::FROM_INPUT, "input" },
+                                        EnumItem(AdaptiveFeed::FROM_SPINDLE) };
+
+void AdaptiveFeed::init() {
+    if (_source == FROM_ADC) {
+        _adc_pin.setAttr(Pin::Attr::Input);
+        _adc_native = _adc_pin.getNative(Pin::Capabilities::Input | Pin::Capabilities::ADC | Pin::Capabilities::Native);
+        if (!adc_attach(_adc_native)) {
+            log_error("Adaptive feed: " << _adc_pin.name() << " cannot be used with WiFi running; use an ADC1 pin");
+            return;
+        }
+    }
+
+    if (!_task) {
+        xTaskCreatePinnedToCore(adaptive_feed_task,        // task
+                                "adaptiveFeedTaskHandle",  // name for task
+                                2048,                      // size of task stack
+                                this,                      // parameters
+                                1,                         // priority
+                                &_task,
+                                SUPPORT_TASK_CORE  // core
+        );
+    }
+
+    log_info("Adaptive feed Source:" << sourceTypes[_source].name << " Target:" << _control._target_load << "% Feed:" << _control._min_feed
+                                     << "-" << _control._max_feed << "%");
+}
+
+void AdaptiveFeed::adaptive_feed_task(void* arg) {
+    auto af = static_cast<AdaptiveFeed*>(arg);
+    while (true) {
+        af->update();
+        vTaskDelay(af->_update_ms / portTICK_PERIOD_MS);
+    }
+}
+
+// Returns the load in percent, or -1 if there is none to act on
+int32_t AdaptiveFeed::read_load() {
+    switch (_source) {
+        case FROM_ADC:
+            if (_adc_native == INVALID_PINNUM) {
+                return -1;
+            }
+            return adc_read_mv(_adc_native) * 100 / _full_scale_mv;
+        case FROM_INPUT: {
+            auto& pin = config->_userInputs->digitalInput[_input_num];
+            if (pin.undefined()) {
+                return -1;
+            }
+            return pin.get() ? 100 : 0;
+        }
+        default:
+            return spindle ? spindle->load_percent() : -1;
+    }
+}
+
+void AdaptiveFeed::update() {
+    if (state_is(State::Hold)) {
+        // Resume at the feed that was in effect
+        return;
+    }
+    SpindleState spindle_state = spindle ? spindle->get_state() : SpindleState::Disable;
+    bool         cutting       = state_is(State::Cycle) && (spindle_state == SpindleState::Cw || spindle_state == SpindleState::Ccw);
+    int32_t      load          = cutting ? read_load() : -1;
+    if (load < 0) {
+        _control.reset();
+        send(FeedOverride::Default);
+        return;
+    }
+    send(_control.update(load, _update_ms));
+}
+
+// The planner is replanned from the protocol loop, as for feed overrides
+void AdaptiveFeed::send(uint32_t percent) {
+    if (percent != _sent) {
+        _sent = percent;
+        protocol_send_event(&adaptiveFeedEvent, (void*)intptr_t(percent));
+    }
+}
+
+void AdaptiveFeed::validate() {
+    Assert(_source != FROM_ADC || _adc_pin.defined(), "Adaptive feed: source adc needs adc_pin");
+}
+
+void AdaptiveFeed::group(Configuration::HandlerBase& handler) {
+    handler.item("source", _source, sourceTypes);
+    handler.item("adc_pin", _adc_pin);
+    handler.item("full_scale_mv", _full_scale_mv, 1, 3300);
+    handler.item("input_num", _input_num, 0, MaxUserDigitalPin - 1);
+    handler.item("target_load_percent", _control._target_load, 1.0f, 100.0f);
+    handler.item("deadband_percent", _control._deadband, 0.0f, 50.0f);
+    handler.item("gain", _control._gain, 0.0f, 100.0f);
+    handler.item("min_feed_percent", _control._min_feed, FeedOverride::Min, FeedOverride::Default);
+    handler.item("max_feed_percent", _control._max_feed, FeedOverride::Default, FeedOverride::Max);
+    handler.item("smoothing_ms", _control._smoothing_ms, 0, 10000);
+    handler.item("update_ms", _update_ms, 20, 1000);
+}
+
+// Configuration registration
+namespace {
+    ConfigurableModuleFactory::InstanceBuilder<AdaptiveFeed> registration("adaptive_feed");
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include "Config.h"
+#include "Module.h"
+#include "Pin.h"
+#include "EnumItem.h"
+#include "FeedController.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// Adaptive feed scales the feed rate to hold the cutting load near a target,
+// so light cuts and air moves run faster and heavy engagement slows down.
+// The load comes from the active spindle (VFD current or tachometer speed
+// droop), an analog voltage on adc_pin, or a user input that is on when the
+// load is high.  The scaling goes through the same planner path as the feed
+// override, and is applied on top of it.
+class AdaptiveFeed : public ConfigurableModule {
+public:
+    enum Source : uint32_t {
+        FROM_SPINDLE,
+        FROM_ADC,
+        FROM_INPUT,
+    };
+
+    AdaptiveFeed(const char* name) : ConfigurableModule(name) {}
+
+    AdaptiveFeed(const AdaptiveFeed&)            = delete;
+    AdaptiveFeed(AdaptiveFeed&&)                 = delete;
+    AdaptiveFeed& operator=(const AdaptiveFeed&) = delete;
+    AdaptiveFeed& operator=(AdaptiveFeed&&)      = delete;
+
+    virtual ~AdaptiveFeed() = default;
+
+    void init() override;
+
+    // Configuration handlers:
+    void validate() override;
+    void group(Configuration::HandlerBase& handler) override;
+
+private:
+    static void adaptive_feed_task(void* arg);
+
+    int32_t read_load();
+    void    update();
+    void    send(uint32_t percent);
+
+    uint32_t _source        = FROM_SPINDLE;
+    Pin      _adc_pin;
+    uint32_t _full_scale_mv = 3300;  // Voltage at 100% load
+    int32_t  _input_num     = 0;     // Digital user input, on at 100% load
+    uint32_t _update_ms     = 100;
+
+    FeedController _control;
+
+    pinnum_t     _adc_native = INVALID_PINNUM;
+    TaskHandle_t _task       = nullptr;
+    uint32_t     _sent       = FeedOverride::Default;
+};
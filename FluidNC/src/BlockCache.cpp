@@ -0,0 +1,169 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "BlockCache.h"
+
+#include "Driver/fluidnc_memory.h"  // memory_alloc
+
+#include <algorithm>
+#include <cstring>
+
+BlockCache::BlockCache(ReadFn read, uint32_t sector_size, uint32_t chunk_sectors, uint32_t total_sectors, uint32_t n_buffers) :
+    _read(read), _sector_size(sector_size), _chunk_sectors(std::max(chunk_sectors, uint32_t(1))), _total_sectors(total_sectors),
+    _buffers(std::max(n_buffers, uint32_t(1))) {
+    for (auto& buffer : _buffers) {
+        buffer.data = static_cast<uint8_t*>(memory_alloc(_chunk_sectors * _sector_size, MemoryTier::Dma));
+        if (!buffer.data) {
+            _ok = false;
+        }
+    }
+}
+
+BlockCache::~BlockCache() {
+    for (auto& buffer : _buffers) {
+        if (buffer.data) {
+            memory_free(buffer.data);
+        }
+    }
+}
+
+bool BlockCache::cached(uint32_t chunk) const {
+    for (auto& buffer : _buffers) {
+        if (buffer.chunk == chunk) {
+            return true;
+        }
+    }
+    return false;
+}
+
+BlockCache::Buffer* BlockCache::find(uint32_t chunk) {
+    for (auto& buffer : _buffers) {
+        if (buffer.chunk == chunk) {
+            buffer.last_use = ++_use_count;
+            return &buffer;
+        }
+    }
+    return nullptr;
+}
+
+// The least recently used buffer, but never the chunk being read or the one
+// after it, so the filesystem's other reads do not evict the sequential run
+BlockCache::Buffer* BlockCache::victim() {
+    Buffer* oldest = nullptr;
+    for (auto& buffer : _buffers) {
+        if (_last_chunk != NO_CHUNK) {
+            if (buffer.chunk == _last_chunk && _buffers.size() > 1) {
+                continue;
+            }
+            if (buffer.chunk == _last_chunk + 1 && _buffers.size() > 2) {
+                continue;
+            }
+        }
+        if (!oldest || buffer.last_use < oldest->last_use) {
+            oldest = &buffer;
+        }
+    }
+    return oldest;
+}
+
+BlockCache::Buffer* BlockCache::fill(uint32_t chunk) {
+    Buffer*  buffer = victim();
+    uint32_t first  = chunk * _chunk_sectors;
+    uint32_t count  = std::min(_chunk_sectors, _total_sectors - first);
+
+    buffer->chunk = NO_CHUNK;
+    if (!_read(first, count, buffer->data)) {
+        ++_stats.errors;
+        return nullptr;
+    }
+    buffer->chunk    = chunk;
+    buffer->sectors  = count;
+    buffer->last_use = ++_use_count;
+    return buffer;
+}
+
+bool BlockCache::read(uint8_t* buf, uint32_t sector, uint32_t count) {
+    if (sector + count > _total_sectors) {
+        return false;
+    }
+    while (count) {
+        uint32_t chunk  = sector / _chunk_sectors;
+        uint32_t offset = sector % _chunk_sectors;
+
+        // Whole aligned chunks go straight to the caller's buffer in one
+        // multi-block read, unless they are already cached
+        if (offset == 0 && count >= _chunk_sectors && !cached(chunk)) {
+            uint32_t n = count - count % _chunk_sectors;
+            if (!_read(sector, n, buf)) {
+                ++_stats.errors;
+                return false;
+            }
+            ++_stats.direct;
+            _last_chunk = (sector + n) / _chunk_sectors - 1;
+            sector += n;
+            buf += n * _sector_size;
+            count -= n;
+            continue;
+        }
+
+        Buffer* buffer = find(chunk);
+        if (buffer) {
+            ++_stats.hits;
+        } else {
+            buffer = fill(chunk);
+            if (!buffer) {
+                return false;
+            }
+            ++_stats.misses;
+        }
+
+        uint32_t n = std::min(count, buffer->sectors - offset);
+        memcpy(buf, buffer->data + offset * _sector_size, n * _sector_size);
+
+        // Reading a chunk whose predecessor is cached is a sequential run,
+        // even if the filesystem reads its FAT in between
+        uint32_t next = chunk + 1;
+        if (chunk > 0 && cached(chunk - 1) && next * _chunk_sectors < _total_sectors && !cached(next)) {
+            _prefetch_chunk = next;
+        }
+        _last_chunk = chunk;
+
+        sector += n;
+        buf += n * _sector_size;
+        count -= n;
+    }
+    return true;
+}
+
+bool BlockCache::prefetch() {
+    uint32_t chunk  = _prefetch_chunk;
+    _prefetch_chunk = NO_CHUNK;
+    if (chunk == NO_CHUNK || cached(chunk)) {
+        return false;
+    }
+    if (fill(chunk)) {
+        ++_stats.prefetches;
+    }
+    return true;
+}
+
+void BlockCache::invalidate(uint32_t sector, uint32_t count) {
+    uint32_t first = sector / _chunk_sectors;
+    uint32_t last  = (sector + count - 1) / _chunk_sectors;
+    for (auto& buffer : _buffers) {
+        if (buffer.chunk != NO_CHUNK && buffer.chunk >= first && buffer.chunk <= last) {
+            buffer.chunk = NO_CHUNK;
+        }
+    }
+    if (_prefetch_chunk >= first && _prefetch_chunk <= last) {
+        _prefetch_chunk = NO_CHUNK;
+    }
+}
+
+void BlockCache::invalidate_all() {
+    for (auto& buffer : _buffers) {
+        buffer.chunk = NO_CHUNK;
+    }
+    _prefetch_chunk = NO_CHUNK;
+    _last_chunk     = NO_CHUNK;
+}
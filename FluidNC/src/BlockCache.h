@@ -0,0 +1,87 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// BlockCache is a read-ahead cache between a filesystem and a block device
+// such as an SD card.  Small reads are widened to aligned chunks of several
+// sectors, so the device sees a few large multi-block reads instead of many
+// single-sector ones.  When reads run sequentially, the next chunk is marked
+// for prefetch; a background task calls prefetch() to fill it into another
+// buffer while the filesystem consumes the current one.
+//
+// The cache is not thread-safe; the caller serializes read(), write
+// invalidation and prefetch() with one lock, as the device can only do one
+// transfer at a time anyway.
+
+class BlockCache {
+public:
+    // Reads count sectors starting at sector into buf; returns false on error
+    using ReadFn = std::function<bool(uint32_t sector, uint32_t count, uint8_t* buf)>;
+
+    struct Stats {
+        uint32_t hits       = 0;  // Reads served from a cached chunk
+        uint32_t misses     = 0;  // Chunks read on demand
+        uint32_t prefetches = 0;  // Chunks read ahead
+        uint32_t direct     = 0;  // Reads of whole chunks that bypassed the cache
+        uint32_t errors     = 0;
+    };
+
+    // Three buffers hold the chunk being read, the one being prefetched and
+    // the FAT sectors that the filesystem reads in between.  They are in
+    // DMA-capable internal RAM, so the device can read into them directly.
+    BlockCache(ReadFn read, uint32_t sector_size, uint32_t chunk_sectors, uint32_t total_sectors, uint32_t n_buffers = 3);
+    ~BlockCache();
+
+    BlockCache(const BlockCache&)            = delete;
+    BlockCache& operator=(const BlockCache&) = delete;
+
+    // False if the buffers could not be allocated; the cache must not be used
+    bool ok() const { return _ok; }
+
+    bool read(uint8_t* buf, uint32_t sector, uint32_t count);
+
+    // Call before writing sectors so stale data is not served afterwards
+    void invalidate(uint32_t sector, uint32_t count);
+    void invalidate_all();
+
+    // True if a sequential run has been detected and the next chunk is not cached yet
+    bool prefetch_pending() const { return _prefetch_chunk != NO_CHUNK; }
+
+    // Reads the pending chunk, if any.  Returns true if it did any I/O.
+    bool prefetch();
+
+    const Stats& stats() const { return _stats; }
+    uint32_t     chunk_bytes() const { return _chunk_sectors * _sector_size; }
+
+private:
+    static const uint32_t NO_CHUNK = UINT32_MAX;
+
+    struct Buffer {
+        uint32_t chunk    = NO_CHUNK;
+        uint32_t sectors  = 0;  // Valid sectors, fewer than chunk_sectors at the end of the device
+        uint32_t last_use = 0;
+        uint8_t* data     = nullptr;
+    };
+
+    bool    cached(uint32_t chunk) const;
+    Buffer* find(uint32_t chunk);
+    Buffer* fill(uint32_t chunk);
+    Buffer* victim();
+
+    ReadFn              _read;
+    uint32_t            _sector_size;
+    uint32_t            _chunk_sectors;
+    uint32_t            _total_sectors;
+    std::vector<Buffer> _buffers;
+    bool                _ok = true;
+
+    uint32_t _use_count      = 0;
+    uint32_t _last_chunk     = NO_CHUNK;
+    uint32_t _prefetch_chunk = NO_CHUNK;
+    Stats    _stats;
+};
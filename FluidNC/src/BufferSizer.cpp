@@ -0,0 +1,45 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "BufferSizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+void BufferSizer::Series::add(uint32_t us) {
+    ++count;
+    sum += us;
+    min = std::min(min, us);
+    max = std::max(max, us);
+}
+
+void BufferSizer::prep(uint32_t gap_us, uint32_t cost_us) {
+    _prep_gap.add(gap_us);
+    _prep_cost.add(cost_us);
+}
+
+void BufferSizer::reset() {
+    _prep_gap   = Series();
+    _prep_cost  = Series();
+    _line_gap   = Series();
+    _block_time = Series();
+}
+
+uint32_t BufferSizer::segments(uint32_t segment_us, uint32_t min, uint32_t max) const {
+    if (!_prep_gap.count || !segment_us) {
+        return 0;
+    }
+    // One more for the segment that is executing
+    uint32_t needed = uint32_t(std::ceil(_prep_gap.max * _margin / segment_us)) + 1;
+    return std::min(std::max(needed, min), max);
+}
+
+uint32_t BufferSizer::blocks(uint32_t min, uint32_t max) const {
+    uint32_t block_us = _block_time.mean();
+    if (!_line_gap.count || !block_us) {
+        return 0;
+    }
+    // Two more for the block that is executing and the one being planned
+    uint32_t needed = uint32_t(std::ceil(_line_gap.max * _margin / block_us)) + 2;
+    return std::min(std::max(needed, min), max);
+}
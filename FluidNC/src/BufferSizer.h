@@ -0,0 +1,45 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+
+// Sizes the step segment and planner buffers from measurements of the
+// motion pipeline.  The segment buffer must hold enough motion to cover
+// the longest time that the protocol loop goes without refilling it, and
+// the planner buffer must hold enough blocks to cover the longest wait for
+// the next line of input.  Both get a safety margin.
+class BufferSizer {
+public:
+    // Count, mean and extremes of a series of durations in microseconds
+    struct Series {
+        uint32_t count = 0;
+        uint64_t sum   = 0;
+        uint32_t min   = UINT32_MAX;
+        uint32_t max   = 0;
+
+        void     add(uint32_t us);
+        uint32_t mean() const { return count ? uint32_t(sum / count) : 0; }
+    };
+
+    float _margin = 1.5f;
+
+    Series _prep_gap;    // Between refills of the segment buffer
+    Series _prep_cost;   // Time spent refilling the segment buffer
+    Series _line_gap;    // Between one line of input being done and the next arriving
+    Series _block_time;  // Execution time of a planner block
+
+    void prep(uint32_t gap_us, uint32_t cost_us);
+    void line(uint32_t gap_us) { _line_gap.add(gap_us); }
+    void block(uint32_t duration_us) { _block_time.add(duration_us); }
+    void reset();
+
+    // The number of segments, each segment_us long, that are needed, within
+    // min and max.  Returns 0 if nothing has been measured.
+    uint32_t segments(uint32_t segment_us, uint32_t min, uint32_t max) const;
+
+    // The number of planner blocks that are needed, within min and max.
+    // Returns 0 if nothing has been measured.
+    uint32_t blocks(uint32_t min, uint32_t max) const;
+};
@@ -0,0 +1,110 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "BufferTuner.h"
+
+#include "BufferSizer.h"
+#include "Config.h"  // ACCELERATION_TICKS_PER_SECOND
+#include "State.h"   // state_is
+#include "Stepping.h"
+#include "Machine/MachineConfig.h"
+#include "Driver/delay_usecs.h"     // getCpuTicks()
+#include "Driver/fluidnc_memory.h"  // memory_has_external()
+
+static BufferSizer sizer;
+
+// The times of the previous events, or 0 if there was none in this cycle
+static int32_t last_prep  = 0;
+static int32_t last_line  = 0;
+static int32_t last_block = 0;
+
+// The limits of the segments and planner_blocks config items
+static const uint32_t min_segments        = 6;
+static const uint32_t max_segments        = 20;
+static const uint32_t min_blocks          = 10;
+static const uint32_t max_internal_blocks = 120;
+static const uint32_t max_external_blocks = 4000;
+
+static uint32_t ticks_to_us(int32_t ticks) {
+    return uint32_t(ticks) / ticks_per_us;
+}
+
+static bool measuring() {
+    return state_is(State::Cycle);
+}
+
+int32_t tuner_prep_start() {
+    return getCpuTicks();
+}
+
+void tuner_prep_end(int32_t start_ticks) {
+    if (!measuring()) {
+        last_prep = 0;
+        return;
+    }
+    int32_t now = getCpuTicks();
+    if (last_prep) {
+        sizer.prep(ticks_to_us(start_ticks - last_prep), ticks_to_us(now - start_ticks));
+    }
+    last_prep = now;
+}
+
+void tuner_line_received() {
+    if (measuring() && last_line) {
+        sizer.line(ticks_to_us(getCpuTicks() - last_line));
+    }
+}
+
+void tuner_line_done() {
+    last_line = measuring() ? getCpuTicks() : 0;
+}
+
+void tuner_block_done() {
+    if (!measuring()) {
+        last_block = 0;
+        return;
+    }
+    int32_t now = getCpuTicks();
+    if (last_block) {
+        sizer.block(ticks_to_us(now - last_block));
+    }
+    last_block = now;
+}
+
+void tuner_reset() {
+    sizer.reset();
+}
+
+static void report_series(Channel& out, const char* name, const BufferSizer::Series& series) {
+    log_stream(out,
+               name << " n:" << series.count << " min:" << series.min << "us mean:" << series.mean() << "us max:" << series.max << "us");
+}
+
+void tuner_report(Channel& out) {
+    if (!sizer._prep_gap.count) {
+        log_stream(out, "No measurements yet; run a job, then try again");
+        return;
+    }
+    report_series(out, "Refill gap", sizer._prep_gap);
+    report_series(out, "Refill time", sizer._prep_cost);
+    if (sizer._line_gap.count) {
+        report_series(out, "Input gap", sizer._line_gap);
+    }
+    if (sizer._block_time.count) {
+        report_series(out, "Block time", sizer._block_time);
+    }
+
+    const uint32_t segment_us = 1000000 / ACCELERATION_TICKS_PER_SECOND;
+    uint32_t       segments   = sizer.segments(segment_us, min_segments, max_segments);
+    log_stream(out,
+               "Segments:" << Stepping::_segments << " recommended:" << segments << " hold latency:" << (segments - 1) * segment_us / 1000
+                           << "ms");
+
+    uint32_t max_blocks = memory_has_external() ? max_external_blocks : max_internal_blocks;
+    uint32_t blocks     = sizer.blocks(min_blocks, max_blocks);
+    if (blocks) {
+        log_stream(out, "Planner blocks:" << config->_planner_blocks << " recommended:" << blocks);
+    } else {
+        log_stream(out, "Planner blocks:" << config->_planner_blocks << " no input measured");
+    }
+}
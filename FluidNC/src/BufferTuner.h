@@ -0,0 +1,28 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include "Channel.h"
+
+#include <cstdint>
+
+// Measurements of the motion pipeline while jobs run, for $Buffers/Tune.
+// Measurements are only taken in the Cycle state.  The hooks just take
+// timestamps, so they are always on.
+
+// Around the refill of the step segment buffer by the protocol loop
+int32_t tuner_prep_start();
+void    tuner_prep_end(int32_t start_ticks);
+
+// When a line of input arrives, and when it has been executed
+void tuner_line_received();
+void tuner_line_done();
+
+// When the segment generator finishes with a planner block
+void tuner_block_done();
+
+void tuner_reset();
+
+// Shows the measurements and the recommended buffer sizes
+void tuner_report(Channel& out);
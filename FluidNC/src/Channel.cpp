@@ -30,6 +30,7 @@ void Channel::resume() {
 void Channel::flushRx() {
     _linelen   = 0;
     _lastWasCR = false;
+    _hasUnread = false;
     while (_queue.size()) {
         _queue.pop();
     }
@@ -213,6 +214,11 @@ Error Channel::pollLine(char* line) {
         return Error::Ok;
     }
     handle();
+    if (line && _hasUnread) {
+        strcpy(line, _unreadLine.c_str());
+        _hasUnread = false;
+        return Error::Ok;
+    }
     while (1) {
         int32_t ch = -1;
         if (line && _queue.size()) {
@@ -245,6 +251,11 @@ Error Channel::pollLine(char* line) {
     return Error::NoData;
 }
 
+void Channel::unreadLine(const char* line) {
+    _unreadLine = line;
+    _hasUnread  = true;
+}
+
 void Channel::out(const char* s, const char* tag) {
     sendLine(MsgLevelNone, s);
 }
@@ -287,17 +298,39 @@ void Channel::print_msg(MsgLevel level, const char* msg) {
     }
 }
 
-// This overload is used primarily with fixed string
-// values.  It sends a pointer to the string whose
-// memory does not need to be reclaimed later.
-// This is the most efficient form, but it only works
-// with fixed messages.
+// Debug and verbose messages are dropped rather than waiting for room
+// when the output task falls behind, so that diagnostic logging cannot
+// stall the caller.  Other messages are responses that must be delivered.
+static bool queue_message(LogMessage& msg) {
+    if (msg.level >= MsgLevelDebug) {
+        if (!xQueueSend(message_queue, &msg, 0)) {
+            log_dropped(msg.level);
+            return false;
+        }
+        return true;
+    }
+    while (!xQueueSend(message_queue, &msg, 10)) {}
+    return true;
+}
+
+// This overload is used with fixed string values and with
+// LogStream's pooled message buffers.  It sends a pointer
+// to the string, which the output task returns to the pool
+// if it is a pooled buffer.
+// This is the most efficient form, as nothing is allocated.
 void Channel::sendLine(MsgLevel level, const char* line) {
+    if (level > _message_level) {
+        log_release(line);
+        return;
+    }
     if (outputTask) {
         LogMessage msg { this, (void*)line, level, false };
-        while (!xQueueSend(message_queue, &msg, 10)) {}
+        if (!queue_message(msg)) {
+            log_release(line);
+        }
     } else {
         print_msg(level, line);
+        log_release(line);
     }
 }
 
@@ -310,9 +343,15 @@ void Channel::sendLine(MsgLevel level, const char* line) {
 // This form has intermediate efficiency, as the string
 // is allocated once and freed once.
 void Channel::sendLine(MsgLevel level, const std::string* line) {
+    if (level > _message_level) {
+        delete line;
+        return;
+    }
     if (outputTask) {
         LogMessage msg { this, (void*)line, level, true };
-        while (!xQueueSend(message_queue, &msg, 10)) {}
+        if (!queue_message(msg)) {
+            delete line;
+        }
     } else {
         print_msg(level, line->c_str());
         delete line;
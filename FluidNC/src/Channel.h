@@ -83,6 +83,9 @@ protected:
     bool _ended   = false;
     bool _percent = false;
 
+    std::string _unreadLine;  // A line put back by unreadLine()
+    bool        _hasUnread = false;
+
 protected:
     bool _active = true;
     bool _paused = false;
@@ -98,6 +101,12 @@ public:
     virtual void  init() {}
     virtual void  handle() {}
     virtual Error pollLine(char* line);
+
+    // unreadLine() puts back a line returned by pollLine(), so that the next
+    // pollLine() returns it again.  Characters that arrive meanwhile wait
+    // behind it.
+    void unreadLine(const char* line);
+    bool hasUnreadLine() { return _hasUnread; }
     virtual void  ack(Error status);
     const char*   name() { return _name.c_str(); }
 
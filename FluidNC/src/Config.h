@@ -162,6 +162,16 @@ const bool FORCE_BUFFER_SYNC_DURING_WCO_CHANGE = true;  // Default enabled. Comm
 // repeatable. If needed, you can disable this behavior by uncommenting the define below.
 const bool ALLOW_FEED_OVERRIDE_DURING_PROBE_CYCLES = false;
 
+// Log messages are built in a pool of fixed-size buffers so that logging does not allocate
+// memory. Longer messages, and messages built while every buffer is in use, fall back to the heap.
+const int LOG_BUFFER_COUNT = 16;   // (1-32)
+const int LOG_BUFFER_SIZE  = 256;  // Bytes, including the terminator
+
+// Maximum number of debug and verbose messages per second. Further messages are dropped and
+// counted, and a warning reports the count. 0 disables the limit.
+const int LOG_DEBUG_RATE_LIMIT   = 100;
+const int LOG_VERBOSE_RATE_LIMIT = 100;
+
 #include "NutsBolts.h"
 
 #include "Assertion.h"
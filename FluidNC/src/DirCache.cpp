@@ -0,0 +1,219 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "DirCache.h"
+#include "Driver/sdspi.h"
+#include "JSONEncoder.h"
+#include "string_util.h"
+
+#include <algorithm>
+
+std::vector<DirCache::Dir> DirCache::_dirs;
+std::mutex                 DirCache::_mutex;
+uint32_t                   DirCache::_generation = 0;
+uint32_t                   DirCache::_clock      = 0;
+
+void DirCache::make_entry(Entry& entry, const std::string& name, int32_t size, bool is_dir) {
+    entry.name   = name;
+    entry.size   = size;
+    entry.is_dir = is_dir;
+    entry.json.clear();
+
+    JSONencoder j([&entry](const char* s) { entry.json += s; });
+    j.begin_object();
+    j.member("name", name);
+    j.member("shortname", name);
+    j.member("size", size);
+    j.member("datetime", "");
+    j.end_object();
+    j.flush();
+}
+
+// Listings on the local filesystem only change through FluidNC, but an
+// SD card can be swapped or written in another machine between mounts,
+// so its listings are dropped when it is mounted again.
+uint32_t DirCache::signature(const std::string& path) {
+    if (string_util::starts_with_ignore_case(path, SD.prefix) && (path.length() == SD.prefix.length() || path[SD.prefix.length()] == '/')) {
+        return sd_volume_signature();
+    }
+    return 1;
+}
+
+std::shared_ptr<const DirCache::Entries> DirCache::lookup(const std::string& path, uint32_t signature, uint32_t& generation) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    generation = _generation;
+    for (auto it = _dirs.begin(); it != _dirs.end(); ++it) {
+        if (it->path == path) {
+            if (signature && it->signature == signature) {
+                it->last_used = ++_clock;
+                return it->entries;
+            }
+            _dirs.erase(it);
+            break;
+        }
+    }
+    return nullptr;
+}
+
+void DirCache::insert(const std::string& path, uint32_t signature, uint32_t generation, Entries&& entries, size_t bytes) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Something changed while the directory was being read
+    if (generation != _generation || !signature || bytes > max_dir_bytes) {
+        return;
+    }
+
+    size_t total = bytes;
+    for (auto it = _dirs.begin(); it != _dirs.end();) {
+        if (it->path == path) {
+            it = _dirs.erase(it);
+        } else {
+            total += it->bytes;
+            ++it;
+        }
+    }
+    while (!_dirs.empty() && (_dirs.size() >= max_dirs || total > max_total_bytes)) {
+        auto lru = _dirs.begin();
+        for (auto it = _dirs.begin(); it != _dirs.end(); ++it) {
+            if (it->last_used < lru->last_used) {
+                lru = it;
+            }
+        }
+        total -= lru->bytes;
+        _dirs.erase(lru);
+    }
+
+    entries.shrink_to_fit();
+    _dirs.push_back({ path, std::make_shared<const Entries>(std::move(entries)), bytes, signature, ++_clock });
+}
+
+void DirCache::invalidate(const stdfs::path& path) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    ++_generation;
+
+    std::string name   = path.string();
+    std::string parent = path.parent_path().string();
+    std::string below  = name + "/";
+    for (auto it = _dirs.begin(); it != _dirs.end();) {
+        if (it->path == name || it->path == parent || it->path.compare(0, below.length(), below) == 0) {
+            it = _dirs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void DirCache::invalidate_all() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    ++_generation;
+    _dirs.clear();
+}
+
+DirReader::DirReader(const stdfs::path& dir) : _path(dir.string()) {
+    _signature = DirCache::signature(_path);
+    _cached    = DirCache::lookup(_path, _signature, _generation);
+    if (_cached) {
+        _ok = true;
+        return;
+    }
+
+    _sd = sd_opendir(_path.c_str());
+    if (_sd) {
+        _ok = true;
+    } else {
+        std::error_code ec;
+        _iter = stdfs::directory_iterator { dir, stdfs::directory_options::skip_permission_denied, ec };
+        _ok   = !ec;
+    }
+    _fill = _ok && _signature;
+}
+
+DirReader::~DirReader() {
+    if (_sd) {
+        sd_closedir(_sd);
+    }
+}
+
+bool DirReader::read_entry(std::string& name, int32_t& size, bool& is_dir) {
+    if (_sd) {
+        uint32_t file_size;
+        if (!sd_readdir(_sd, name, file_size, is_dir)) {
+            sd_closedir(_sd);
+            _sd = nullptr;
+            return false;
+        }
+        size = is_dir ? -1 : int32_t(file_size);
+        return true;
+    }
+
+    if (_iter == stdfs::directory_iterator()) {
+        return false;
+    }
+
+    std::error_code ec;
+    name   = _iter->path().filename().string();
+    is_dir = _iter->is_directory(ec) && !ec;
+    size   = -1;
+    if (!is_dir && _iter->is_regular_file(ec) && !ec) {
+        auto file_size = _iter->file_size(ec);
+        if (!ec && file_size != static_cast<uintmax_t>(-1)) {
+            size = int32_t(file_size);
+        }
+    }
+
+    _iter.increment(ec);
+    if (ec) {
+        _iter = stdfs::directory_iterator();
+    }
+    return true;
+}
+
+const DirCache::Entry* DirReader::next() {
+    if (_cached) {
+        return _index < _cached->size() ? &(*_cached)[_index++] : nullptr;
+    }
+
+    std::string name;
+    int32_t     size;
+    bool        is_dir;
+    if (!read_entry(name, size, is_dir)) {
+        if (_fill) {
+            DirCache::insert(_path, _signature, _generation, std::move(_filling), _bytes);
+            _fill = false;
+        }
+        return nullptr;
+    }
+
+    if (_fill) {
+        _filling.emplace_back();
+        DirCache::make_entry(_filling.back(), name, size, is_dir);
+        _bytes += DirCache::footprint(_filling.back());
+        if (_bytes <= DirCache::max_dir_bytes) {
+            return &_filling.back();
+        }
+        // Too big to cache, so stop collecting entries
+        _current = std::move(_filling.back());
+        _filling = {};
+        _fill    = false;
+        return &_current;
+    }
+
+    DirCache::make_entry(_current, name, size, is_dir);
+    return &_current;
+}
+
+size_t DirReader::skip(size_t count) {
+    if (_cached) {
+        count = std::min(count, _cached->size() - _index);
+        _index += count;
+        return count;
+    }
+    size_t skipped = 0;
+    while (skipped < count && next()) {
+        ++skipped;
+    }
+    return skipped;
+}
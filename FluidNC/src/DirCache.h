@@ -0,0 +1,103 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include "FluidPath.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct SdDir;
+
+// Listings of recently viewed directories, so that browsing a directory of
+// job files does not read the whole directory again for every request.
+// Anything that creates, deletes, renames or writes files must call
+// DirCache::invalidate() with the affected path.
+class DirCache {
+public:
+    struct Entry {
+        std::string name;
+        int32_t     size   = -1;  // -1 for directories
+        bool        is_dir = false;
+        std::string json;  // The WebUI file list object for this entry
+    };
+    using Entries = std::vector<Entry>;
+
+    // Directories that need more memory than max_dir_bytes are read from
+    // the filesystem every time, using the fast listing when possible.
+    static const size_t max_dirs        = 4;
+    static const size_t max_dir_bytes   = 24 * 1024;
+    static const size_t max_total_bytes = 48 * 1024;
+
+    // Forgets the listing of the directory containing path, of path itself,
+    // and of any directory below it.
+    static void invalidate(const stdfs::path& path);
+    static void invalidate_all();
+
+    static void make_entry(Entry& entry, const std::string& name, int32_t size, bool is_dir);
+
+    static size_t footprint(const Entry& entry) { return sizeof(Entry) + entry.name.size() + entry.json.size(); }
+
+private:
+    friend class DirReader;
+
+    struct Dir {
+        std::string                    path;
+        std::shared_ptr<const Entries> entries;
+        size_t                         bytes;
+        uint32_t                       signature;
+        uint32_t                       last_used;
+    };
+
+    static std::vector<Dir> _dirs;
+    static std::mutex       _mutex;
+    static uint32_t         _generation;
+    static uint32_t         _clock;
+
+    static uint32_t                       signature(const std::string& path);
+    static std::shared_ptr<const Entries> lookup(const std::string& path, uint32_t signature, uint32_t& generation);
+    static void insert(const std::string& path, uint32_t signature, uint32_t generation, Entries&& entries, size_t bytes);
+};
+
+// Reads the entries of one directory, from DirCache when it has them.
+// Otherwise the directory is read from the filesystem, and the entries
+// are added to the cache once all of them have been read.
+class DirReader {
+public:
+    explicit DirReader(const stdfs::path& dir);
+    ~DirReader();
+
+    DirReader(const DirReader&)            = delete;
+    DirReader& operator=(const DirReader&) = delete;
+
+    bool ok() const { return _ok; }
+
+    // Returns the next entry, or nullptr after the last one.
+    // The entry is only valid until the next call.
+    const DirCache::Entry* next();
+
+    // Skips up to count entries, returning the number skipped
+    size_t skip(size_t count);
+
+private:
+    bool read_entry(std::string& name, int32_t& size, bool& is_dir);
+
+    std::string                              _path;
+    std::shared_ptr<const DirCache::Entries> _cached;
+    size_t                                   _index = 0;
+
+    SdDir*                    _sd = nullptr;
+    stdfs::directory_iterator _iter;
+
+    DirCache::Entries _filling;
+    DirCache::Entry   _current;
+    size_t            _bytes      = 0;
+    bool              _fill       = false;
+    uint32_t          _signature  = 0;
+    uint32_t          _generation = 0;
+    bool              _ok         = false;
+};
@@ -47,6 +47,7 @@ const std::map<Error, const char*> ErrorNames = {
     { Error::GcodeMaxValueExceeded, "Gcode max value exceeded" },
     { Error::PParamMaxExceeded, "P param max exceeded" },
     { Error::CheckStartupPins, "Check startup pins" },
+    { Error::ProbeFailed, "Probe failed" },
     { Error::FsFailedMount, "Failed to mount device" },
     { Error::FsFailedRead, "Read failed" },
     { Error::FsFailedOpenDir, "Failed to open directory" },
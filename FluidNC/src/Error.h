@@ -51,6 +51,7 @@ enum class Error : uint8_t {
     GcodeMaxValueExceeded        = 38,
     PParamMaxExceeded            = 39,
     CheckStartupPins             = 40,
+    ProbeFailed                  = 41,
     FsFailedMount                = 60,  // Filesystem failed to mount
     FsFailedRead                 = 61,  // Failed to read file
     FsFailedOpenDir              = 62,  // Failed to open directory
@@ -6,6 +6,7 @@
 #    include "Extenders.h"
 #    include "I2CPinExtenderBase.h"
 #    include "Logging.h"
+#    include "TaskProfiler.h"  // ProfileRun
 
 // #    include <esp32-hal-gpio.h>
 #    include <freertos/FreeRTOS.h>
@@ -62,10 +63,12 @@ namespace Extenders {
 
     void I2CPinExtenderBase::isrTaskLoop(void* arg) {
         auto inst = static_cast<I2CPinExtenderBase*>(arg);
+        ProfileSlot profile = profile_task(ProfiledTask::Extender);
         while (true) {
             void* ptr;
             if (xQueueReceive(inst->_isrQueue, &ptr, portMAX_DELAY)) {
-                ISRData* valuePtr = static_cast<ISRData*>(ptr);
+                ProfileRun run(profile);
+                ISRData*   valuePtr = static_cast<ISRData*>(ptr);
                 // log_info("I2C pin extender state change ISR");
                 valuePtr->updateValueFromDevice();
             }
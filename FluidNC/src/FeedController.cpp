@@ -0,0 +1,26 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "FeedController.h"
+
+#include <algorithm>
+
+uint32_t FeedController::update(float load, uint32_t dt_ms) {
+    if (_load < 0) {
+        _load = load;
+    } else {
+        _load += (load - _load) * dt_ms / float(_smoothing_ms + dt_ms);
+    }
+
+    float error = _target_load - _load;
+    if (error > _deadband || error < -_deadband) {
+        _feed += _gain * error * dt_ms / 1000.0f;
+        _feed = std::min(std::max(_feed, float(_min_feed)), float(_max_feed));
+    }
+    return feed();
+}
+
+void FeedController::reset() {
+    _load = -1.0f;
+    _feed = 100.0f;
+}
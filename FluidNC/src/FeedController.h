@@ -0,0 +1,33 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+
+// The control law for adaptive feed.  The load signal is smoothed with a
+// first-order filter, and the feed percentage is integrated from the
+// difference between the smoothed load and the target, so a light load
+// speeds the feed up and a heavy one slows it down, within limits.
+class FeedController {
+public:
+    float    _target_load  = 70.0f;  // Percent
+    float    _deadband     = 3.0f;   // Percent of load where the feed is left alone
+    float    _gain         = 2.0f;   // Percent feed per second per percent load error
+    uint32_t _min_feed     = 50;     // Percent
+    uint32_t _max_feed     = 120;    // Percent
+    uint32_t _smoothing_ms = 300;    // Time constant of the load filter
+
+    // Takes a load sample dt_ms after the previous one; returns the feed percentage
+    uint32_t update(float load, uint32_t dt_ms);
+
+    // Forgets the load history and returns the feed to 100%
+    void reset();
+
+    float    load() const { return _load; }
+    uint32_t feed() const { return uint32_t(_feed + 0.5f); }
+
+private:
+    float _load = -1.0f;  // Negative until the first sample
+    float _feed = 100.0f;
+};
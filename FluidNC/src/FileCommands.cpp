@@ -12,6 +12,8 @@
 #include "string_util.h"  // split_prefix()
 
 #include "HashFS.h"
+#include "DirCache.h"
+#include "LocalFSMaint.h"
 
 #include <charconv>
 
@@ -30,7 +32,13 @@ static Error localFSSize(const char* parameter, AuthenticationLevel auth_level,
     return Error::Ok;
 }
 
+static Error localFSStats(const char* parameter, AuthenticationLevel auth_level, Channel& out) {
+    LocalFSMaint::report(out);
+    return Error::Ok;
+}
+
 static Error formatLocalFS(const char* parameter, AuthenticationLevel auth_level, Channel& out) {  // ESP710
+    DirCache::invalidate_all();
     if (localfs_format(parameter)) {
         return Error::FsFailedFormat;
     }
@@ -287,6 +295,7 @@ static Error deleteObject(const Volume& fs, const char* name, Channel& out) {
         } else {
             stdfs::remove(fpath);
         }
+        DirCache::invalidate(fpath);
         HashFS::delete_file(fpath);
     } catch (std::filesystem::filesystem_error const& ex) {
         log_error_to(out, ex.what());
@@ -461,6 +470,8 @@ static Error renameObject(const Volume& fs, const char* parameter, Authenticatio
         FluidPath inPath { ipath, fs };
         FluidPath outPath { opath, fs };
         std::filesystem::rename(inPath, outPath);
+        DirCache::invalidate(inPath);
+        DirCache::invalidate(outPath);
         HashFS::rename_file(inPath, outPath, true);
     } catch (std::filesystem::filesystem_error const& ex) {
         log_error_to(out, ex.what());
@@ -494,6 +505,85 @@ static Error copyFile(const Volume& ifs, const char* ipath, const Volume& ofs, c
     HashFS::rehash_file(filepath);
     return Error::Ok;
 }
+// Replaces a file with a copy compressed by GcodeCodec, or expands a
+// compressed file back to plain text.  Jobs run compressed files directly.
+static Error transcodeFile(const Volume& fs, const char* parameter, bool compress, Channel& out) {
+    if (notIdleOrAlarm()) {
+        return Error::IdleError;
+    }
+    InputFile* inFile;
+    Error      err;
+    if ((err = openFile(fs, parameter, out, inFile)) != Error::Ok) {
+        return err;
+    }
+    if (inFile->compressed() == compress) {
+        log_string(out, compress ? "File is already compressed" : "File is not compressed");
+        delete inFile;
+        return Error::Ok;
+    }
+
+    // openFile() has checked the name
+    std::string name(parameter);
+    if (name[0] != '/') {
+        name = "/" + name;
+    }
+    std::error_code ec;
+    FluidPath       path   = inFile->fpath();
+    FluidPath       temp   = { name + "~", fs, ec };
+    size_t          before = inFile->size();
+    size_t          after  = 0;
+    bool            ok     = true;
+    try {
+        FileStream outFile { temp, "w" };
+        uint8_t    buf[512];
+        int        len;
+        if (compress) {
+            GcodeCodec::Encoder encoder([&outFile](const uint8_t* data, size_t len) { return outFile.write(data, len) == len; });
+            while (ok && (len = inFile->FileStream::read(buf, sizeof(buf))) > 0) {
+                ok = encoder.write(buf, len);
+            }
+            ok = ok && encoder.finish();
+        } else {
+            while (ok && (len = inFile->read(buf, sizeof(buf))) > 0) {
+                ok = outFile.write(buf, len) == size_t(len);
+            }
+        }
+        after = outFile.position();
+    } catch (const Error err) {
+        delete inFile;
+        log_error_to(out, "Cannot create file " << name << "~");
+        return Error::FsFailedCreateFile;
+    }
+    ok = ok && !inFile->corrupt();
+    delete inFile;
+
+    if (ok) {
+        stdfs::rename(temp, path, ec);
+        ok = !ec;
+    }
+    if (!ok) {
+        stdfs::remove(temp, ec);
+        DirCache::invalidate(path);
+        log_error_to(out, "Cannot " << (compress ? "compress " : "expand ") << name);
+        return Error::FsFailedRead;
+    }
+    DirCache::invalidate(path);
+    HashFS::rehash_file(path);
+    log_stream(out, name << " " << before << " bytes " << (compress ? "compressed" : "expanded") << " to " << after);
+    return Error::Ok;
+}
+static Error compressSDFile(const char* parameter, AuthenticationLevel auth_level, Channel& out) {
+    return transcodeFile(SD, parameter, true, out);
+}
+static Error compressLocalFile(const char* parameter, AuthenticationLevel auth_level, Channel& out) {
+    return transcodeFile(LocalFS, parameter, true, out);
+}
+static Error expandSDFile(const char* parameter, AuthenticationLevel auth_level, Channel& out) {
+    return transcodeFile(SD, parameter, false, out);
+}
+static Error expandLocalFile(const char* parameter, AuthenticationLevel auth_level, Channel& out) {
+    return transcodeFile(LocalFS, parameter, false, out);
+}
 static Error copyDir(const Volume& ifs, const std::string_view iDir, const Volume& ofs, const std::string_view oDir, Channel& out) {  // No ESP command
     std::error_code ec;
 
@@ -506,6 +596,7 @@ static Error copyDir(const Volume& ifs, const std::string_view iDir, const Volum
 
         if (outDir.hasTail()) {
             stdfs::create_directory(outDir, ec);
+            DirCache::invalidate(outDir);
             if (ec) {
                 log_error_to(out, "Cannot create " << oDir << " on " << ofs.name);
                 return Error::FsFailedOpenDir;
@@ -575,6 +666,7 @@ static Error migrateLocalFS(const char* parameter, AuthenticationLevel auth_leve
         return err;
     }
     log_info("Reformatting local filesystem to " << newfs);
+    DirCache::invalidate_all();
     if (localfs_format(newfs)) {
         return Error::FsFailedFormat;
     }
@@ -665,10 +757,13 @@ void make_file_commands() {
     new WebCommand("path", WEBCMD, WU, NULL, "LocalFS/ListJSON", listLocalFilesJSON, allowConfigStates);
     new WebCommand("path", WEBCMD, WU, NULL, "LocalFS/Delete", deleteLocalFile, allowConfigStates);
     new WebCommand("path", WEBCMD, WU, NULL, "LocalFS/Rename", renameLocalObject, allowConfigStates);
+    new WebCommand("path", WEBCMD, WU, NULL, "LocalFS/Compress", compressLocalFile);
+    new WebCommand("path", WEBCMD, WU, NULL, "LocalFS/Expand", expandLocalFile);
     new WebCommand("path", WEBCMD, WU, NULL, "LocalFS/Backup", backupLocalFS);
     new WebCommand("path", WEBCMD, WU, NULL, "LocalFS/Restore", restoreLocalFS);
     new WebCommand("path", WEBCMD, WU, NULL, "LocalFS/Migrate", migrateLocalFS);
     new WebCommand(NULL, WEBCMD, WU, NULL, "LocalFS/Hashes", showLocalFSHashes);
+    new WebCommand(NULL, WEBCMD, WU, NULL, "LocalFS/Stats", localFSStats, anyState);
 
     new WebCommand("path", WEBCMD, WU, NULL, "File/SendJSON", fileSendJson);
     new WebCommand("path", WEBCMD, WU, NULL, "File/ShowSome", fileShowSome);
@@ -677,6 +772,8 @@ void make_file_commands() {
     new WebCommand("path", WEBCMD, WU, "ESP220", "SD/Run", runSDFile, nullptr);
     new WebCommand("file_or_directory_path", WEBCMD, WU, "ESP215", "SD/Delete", deleteSDObject);
     new WebCommand("path", WEBCMD, WU, NULL, "SD/Rename", renameSDObject);
+    new WebCommand("path", WEBCMD, WU, NULL, "SD/Compress", compressSDFile);
+    new WebCommand("path", WEBCMD, WU, NULL, "SD/Expand", expandSDFile);
     new WebCommand(NULL, WEBCMD, WU, "ESP210", "SD/List", listSDFiles);
     new WebCommand("path", WEBCMD, WU, NULL, "SD/ListJSON", listSDFilesJSON);
     new WebCommand(NULL, WEBCMD, WU, "ESP200", "SD/Status", showSDStatus);
@@ -3,6 +3,14 @@
 
 #include "FileStream.h"
 #include "Machine/MachineConfig.h"  // config->
+#include "DirCache.h"
+#include "LocalFSMaint.h"
+
+#include <cstring>
+
+static bool is_write_mode(const char* mode) {
+    return strpbrk(mode, "wa+") != nullptr;
+}
 
 std::string FileStream::path() {
     return _fpath.string();
@@ -13,7 +21,7 @@ std::string FileStream::name() {
 }
 
 int FileStream::available() {
-    return size() - position();
+    return size() - FileStream::position();
 }
 
 int FileStream::read() {
@@ -40,6 +48,10 @@ size_t FileStream::write(const uint8_t* buffer, size_t length) {
     return fwrite(buffer, 1, length, _fd);
 }
 
+void FileStream::set_write_buffer(size_t size) {
+    setvbuf(_fd, nullptr, _IOFBF, size);
+}
+
 size_t FileStream::size() {
     return _size;
 }
@@ -57,6 +69,9 @@ void FileStream::setup(const char* mode) {
         throw opening ? Error::FsFailedOpenFile : Error::FsFailedCreateFile;
     }
     _size = stdfs::file_size(_fpath);
+    if (is_write_mode(mode)) {
+        DirCache::invalidate(_fpath);
+    }
 }
 
 FileStream::FileStream(const char* filename, const char* mode, const Volume& fs) : Channel(filename), _fpath(filename, fs), _mode(mode) {
@@ -73,7 +88,7 @@ void FileStream::set_position(size_t pos) {
 }
 
 void FileStream::save() {
-    _saved_position = position();
+    _saved_position = FileStream::position();
     fclose(_fd);
     _fd = nullptr;
 }
@@ -89,6 +104,12 @@ void FileStream::restore() {
 
 FileStream::~FileStream() {
     if (_fd) {
+        size_t end = FileStream::position();
         fclose(_fd);
+        // The size in any cached listing is now out of date
+        if (is_write_mode(_mode)) {
+            DirCache::invalidate(_fpath);
+            LocalFSMaint::write_finished(_fpath, end > _size ? end - _size : 0);
+        }
     }
 }
@@ -53,6 +53,10 @@ public:
     size_t write(uint8_t c) override;
     size_t write(const uint8_t* buffer, size_t length) override;
 
+    // Collects writes into chunks of this size, typically the filesystem
+    // block size.  Must be called before the first write.
+    void set_write_buffer(size_t size);
+
     size_t size();
     size_t position() override;
     void   set_position(size_t) override;
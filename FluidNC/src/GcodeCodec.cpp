@@ -0,0 +1,284 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "GcodeCodec.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace GcodeCodec {
+    static const uint8_t magic[] = { 'F', 'N', 'Z' };
+
+    bool is_compressed(const uint8_t* data, size_t len) {
+        return len >= header_size && memcmp(data, magic, sizeof(magic)) == 0 && Decoder::window_ok(data[3]);
+    }
+
+    Encoder::Encoder(Sink sink, uint32_t window_log2) :
+        _sink(sink), _window(1 << window_log2), _max_match(_window / 8), _buf(2 * _window), _table(ways << hash_log2, 0) {
+        _out.reserve(out_buffer);
+        for (auto c : magic) {
+            put(c);
+        }
+        put(window_log2);
+    }
+
+    uint32_t Encoder::hash(const uint8_t* p) {
+        uint32_t v = p[0] | (p[1] << 8) | (p[2] << 16) | (uint32_t(p[3]) << 24);
+        return (v * 2654435761u) >> (32 - hash_log2);
+    }
+
+    bool Encoder::write(const uint8_t* data, size_t len) {
+        while (len && _ok) {
+            size_t n = std::min(len, _buf.size() - _fill);
+            memcpy(&_buf[_fill], data, n);
+            _fill += n;
+            _bytes_in += n;
+            data += n;
+            len -= n;
+            if (_fill == _buf.size()) {
+                encode(false);
+                slide();
+            }
+        }
+        return _ok;
+    }
+
+    bool Encoder::finish() {
+        encode(true);
+        return flush();
+    }
+
+    void Encoder::insert(uint32_t h, uint32_t position) {
+        uint32_t* bucket = &_table[h * ways];
+        std::copy_backward(bucket, bucket + ways - 1, bucket + ways);
+        bucket[0] = position;
+    }
+
+    // Returns the length of the longest match for the bytes at cursor among
+    // the candidates in the bucket, or 0 if there is none
+    size_t Encoder::longest_match(size_t cursor, uint32_t h, uint32_t& dist) {
+        const uint8_t* p       = &_buf[cursor];
+        uint32_t       here    = uint32_t(_base + cursor);
+        size_t         max_len = std::min<size_t>(_max_match, _fill - cursor);
+        size_t         best    = 0;
+        for (uint32_t way = 0; way < ways; ++way) {
+            uint32_t d = here - _table[h * ways + way];
+            if (!d || d >= _window || d > cursor) {
+                // Empty, or older than what the buffer holds
+                continue;
+            }
+            size_t len = 0;
+            while (len < max_len && p[len - d] == p[len]) {
+                ++len;
+            }
+            if (len >= min_match && len > best) {
+                best = len;
+                dist = d;
+            }
+        }
+        return best;
+    }
+
+    // Greedy parse, keeping a few candidates per hash because G-code repeats
+    // short fragments such as " Y10.000" far more often than whole passes.
+    // Unless this is the end of the input, the last _max_match bytes are
+    // left for the next call so matches can run their full length.
+    void Encoder::encode(bool final) {
+        size_t limit = final ? _fill : _fill - _max_match;
+        while (_cursor < limit) {
+            if (_cursor + min_match <= _fill) {
+                uint32_t h    = hash(&_buf[_cursor]);
+                uint32_t dist = 0;
+                size_t   len  = longest_match(_cursor, h, dist);
+                insert(h, uint32_t(_base + _cursor));
+                if (len) {
+                    sequence(_cursor - _lit_start, dist, len, false);
+                    for (size_t i = 1; i < len && _cursor + i + min_match <= _fill; ++i) {
+                        insert(hash(&_buf[_cursor + i]), uint32_t(_base + _cursor + i));
+                    }
+                    _cursor += len;
+                    _lit_start = _cursor;
+                    continue;
+                }
+            }
+            ++_cursor;
+            // Bound the literal run so that sliding never discards pending literals
+            if (_cursor - _lit_start >= _window / 2) {
+                sequence(_cursor - _lit_start, 0, 0, false);
+                _lit_start = _cursor;
+            }
+        }
+        if (final) {
+            sequence(_cursor - _lit_start, 0, 0, true);
+            _lit_start = _cursor;
+        }
+    }
+
+    // Discards what is older than the window
+    void Encoder::slide() {
+        size_t drop = std::min(_cursor > _window ? _cursor - _window : 0, _lit_start);
+        if (!drop) {
+            return;
+        }
+        memmove(&_buf[0], &_buf[drop], _fill - drop);
+        _base += drop;
+        _cursor -= drop;
+        _lit_start -= drop;
+        _fill -= drop;
+    }
+
+    void Encoder::put(uint8_t c) {
+        _out.push_back(c);
+        if (_out.size() >= out_buffer) {
+            flush();
+        }
+    }
+
+    void Encoder::put_length(uint32_t n) {
+        for (; n >= 255; n -= 255) {
+            put(255);
+        }
+        put(n);
+    }
+
+    void Encoder::sequence(size_t literals, uint32_t offset, uint32_t length, bool last) {
+        uint32_t match = offset ? length - min_match : (last ? 1 : 0);
+        put((std::min<size_t>(literals, 15) << 4) | std::min<uint32_t>(match, 15));
+        if (literals >= 15) {
+            put_length(literals - 15);
+        }
+        for (size_t i = 0; i < literals; ++i) {
+            put(_buf[_lit_start + i]);
+        }
+        put(offset & 0xff);
+        put(offset >> 8);
+        if (offset && match >= 15) {
+            put_length(match - 15);
+        }
+    }
+
+    bool Encoder::flush() {
+        if (!_out.empty()) {
+            _ok = _ok && _sink(_out.data(), _out.size());
+            _bytes_out += _out.size();
+            _out.clear();
+        }
+        return _ok;
+    }
+
+    Decoder::Decoder(Source source, uint32_t window_log2) : _source(source), _window(1 << window_log2), _mask((1 << window_log2) - 1) {}
+
+    void Decoder::reset() {
+        _in_len   = 0;
+        _in_pos   = 0;
+        _pos      = 0;
+        _literals = 0;
+        _match    = 0;
+        _offset   = 0;
+        _ended    = false;
+        _failed   = false;
+    }
+
+    int Decoder::in() {
+        if (_in_pos == _in_len) {
+            _in_len = _source(_in, sizeof(_in));
+            _in_pos = 0;
+            if (!_in_len) {
+                return -1;
+            }
+        }
+        return _in[_in_pos++];
+    }
+
+    bool Decoder::get_length(uint32_t& n) {
+        int b;
+        do {
+            if ((b = in()) < 0) {
+                return false;
+            }
+            n += b;
+        } while (b == 255);
+        return true;
+    }
+
+    bool Decoder::start_sequence() {
+        int b = in();
+        if (b < 0) {
+            // The input ended without an end marker
+            return false;
+        }
+        _token    = b;
+        _literals = _token >> 4;
+        if (_literals == 15 && !get_length(_literals)) {
+            return false;
+        }
+        return _literals || start_match();
+    }
+
+    bool Decoder::start_match() {
+        int lo = in();
+        int hi = in();
+        if (lo < 0 || hi < 0) {
+            return false;
+        }
+        _offset        = lo | (hi << 8);
+        uint32_t match = _token & 15;
+        if (!_offset) {
+            _ended = match == 1;
+            return match <= 1;
+        }
+        if (match == 15 && !get_length(match)) {
+            return false;
+        }
+        _match = match + 4;
+        return _offset <= _pos && _offset <= _window.size();
+    }
+
+    int Decoder::fail() {
+        _failed = true;
+        return -1;
+    }
+
+    int Decoder::get() {
+        if (_failed) {
+            return -1;
+        }
+        while (!_literals && !_match) {
+            if (_ended) {
+                return -1;
+            }
+            if (!start_sequence()) {
+                return fail();
+            }
+        }
+        uint8_t c;
+        bool    run_ended = false;
+        if (_literals) {
+            int b = in();
+            if (b < 0) {
+                return fail();
+            }
+            c         = b;
+            run_ended = --_literals == 0;
+        } else {
+            c = _window[(_pos - _offset) & _mask];
+            --_match;
+        }
+        _window[_pos & _mask] = c;
+        ++_pos;
+        if (run_ended && !start_match()) {
+            // Return this byte; the next call reports the failure
+            _failed = true;
+        }
+        return c;
+    }
+
+    size_t Decoder::read(uint8_t* data, size_t len) {
+        size_t n = 0;
+        int    c;
+        while (n < len && (c = get()) >= 0) {
+            data[n++] = c;
+        }
+        return n;
+    }
+}
@@ -0,0 +1,129 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+// GcodeCodec is a byte-oriented LZ77 codec in the style of LZ4, for
+// storing G-code files compressed and running them without expanding
+// them first.  Decoding needs only a window buffer and a few counters,
+// so InputFile can decompress a line at a time as a job runs.
+//
+// A compressed file starts with the four bytes "FNZ" and log2 of the
+// window size, followed by sequences of
+//   token         high nibble literal count, low nibble match length - 4
+//   [count ext]   if a nibble is 15, bytes added to it until one is not 255
+//   literals
+//   offset        2 bytes little-endian, distance back to the match
+//   [length ext]
+// An offset of 0 means that the sequence has no match; its low nibble
+// is then 1 for the last sequence in the stream and 0 otherwise.
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace GcodeCodec {
+    const size_t header_size = 4;
+
+    // True if the data starts with a compressed stream header
+    bool is_compressed(const uint8_t* data, size_t len);
+
+    class Encoder {
+    public:
+        // Receives compressed output; returns false on a write error
+        using Sink = std::function<bool(const uint8_t* data, size_t len)>;
+
+        explicit Encoder(Sink sink, uint32_t window_log2 = 13);
+
+        Encoder(const Encoder&)            = delete;
+        Encoder& operator=(const Encoder&) = delete;
+
+        bool write(const uint8_t* data, size_t len);
+
+        // Compresses the remaining input and ends the stream
+        bool finish();
+
+        uint64_t bytes_in() const { return _bytes_in; }
+        uint64_t bytes_out() const { return _bytes_out; }
+
+    private:
+        static const uint32_t min_match  = 4;
+        static const uint32_t hash_log2  = 9;
+        static const uint32_t ways       = 4;  // Candidates kept per hash, most recent first
+        static const size_t   out_buffer = 256;
+
+        Sink                  _sink;
+        uint32_t              _window;
+        uint32_t              _max_match;
+        std::vector<uint8_t>  _buf;    // History and lookahead
+        std::vector<uint32_t> _table;  // Recent absolute positions of each hash
+        std::vector<uint8_t>  _out;
+        size_t                _fill      = 0;
+        size_t                _cursor    = 0;  // Next byte to encode
+        size_t                _lit_start = 0;  // First byte of pending literals
+        uint64_t              _base      = 0;  // Absolute position of _buf[0]
+        uint64_t              _bytes_in  = 0;
+        uint64_t              _bytes_out = 0;
+        bool                  _ok        = true;
+
+        static uint32_t hash(const uint8_t* p);
+
+        void   insert(uint32_t h, uint32_t position);
+        size_t longest_match(size_t cursor, uint32_t h, uint32_t& dist);
+        void   encode(bool final);
+        void   slide();
+        void   put(uint8_t c);
+        void   put_length(uint32_t n);
+        void   sequence(size_t literals, uint32_t offset, uint32_t length, bool last);
+        bool   flush();
+    };
+
+    class Decoder {
+    public:
+        // Fills data with up to len compressed bytes; returns 0 at the end of the input
+        using Source = std::function<size_t(uint8_t* data, size_t len)>;
+
+        // Call after the header has been read, with the header's window size
+        Decoder(Source source, uint32_t window_log2);
+
+        Decoder(const Decoder&)            = delete;
+        Decoder& operator=(const Decoder&) = delete;
+
+        static bool window_ok(uint32_t window_log2) { return window_log2 >= 8 && window_log2 <= 16; }
+
+        // Returns the next decompressed byte, or -1 at the end or on corrupt data
+        int get();
+
+        size_t read(uint8_t* data, size_t len);
+
+        // Decompressed bytes returned so far
+        uint64_t position() const { return _pos; }
+
+        // Starts over; the caller repositions the source after the header
+        void reset();
+
+        bool failed() const { return _failed; }
+
+    private:
+        Source               _source;
+        std::vector<uint8_t> _window;
+        uint32_t             _mask;
+        uint8_t              _in[128];
+        size_t               _in_len   = 0;
+        size_t               _in_pos   = 0;
+        uint64_t             _pos      = 0;
+        uint32_t             _literals = 0;
+        uint32_t             _match    = 0;
+        uint32_t             _offset   = 0;
+        uint8_t              _token    = 0;
+        bool                 _ended    = false;
+        bool                 _failed   = false;
+
+        int  in();
+        bool get_length(uint32_t& n);
+        bool start_sequence();
+        bool start_match();
+        int  fail();
+    };
+}
@@ -5,7 +5,43 @@
 
 #include "Report.h"
 
-InputFile::InputFile(const Volume& defaultFs, const char* path) : FileStream(path, "r", defaultFs) {}
+InputFile::InputFile(const Volume& defaultFs, const char* path) : FileStream(path, "r", defaultFs) {
+    uint8_t header[GcodeCodec::header_size];
+    size_t  len = FileStream::read(header, sizeof(header));
+    if (GcodeCodec::is_compressed(header, len)) {
+        _decoder = std::make_unique<GcodeCodec::Decoder>([this](uint8_t* data, size_t len) { return size_t(FileStream::read(data, len)); },
+                                                         header[3]);
+    } else {
+        FileStream::set_position(0);
+    }
+}
+
+int InputFile::read() {
+    return _decoder ? _decoder->get() : FileStream::read();
+}
+
+int InputFile::read(char* buffer, size_t length) {
+    return _decoder ? _decoder->read((uint8_t*)buffer, length) : FileStream::read(buffer, length);
+}
+
+size_t InputFile::position() {
+    return _decoder ? _decoder->position() : FileStream::position();
+}
+
+// Compressed data can only be decoded from the start, so seeking back
+// decodes again up to pos.  Loops are usually short, and the seek is
+// to a line that was read recently, so this is rarely far.
+void InputFile::set_position(size_t pos) {
+    if (!_decoder) {
+        FileStream::set_position(pos);
+        return;
+    }
+    if (pos < _decoder->position()) {
+        FileStream::set_position(GcodeCodec::header_size);
+        _decoder->reset();
+    }
+    while (_decoder->position() < pos && _decoder->get() >= 0) {}
+}
 /*
   Read a line from the file
   Returns Error::Ok if a line was read, even if the line was empty.
@@ -82,7 +118,9 @@ Error InputFile::pollLine(char* line) {
     }
     switch (auto err = readLine(line, Channel::maxLine)) {
         case Error::Ok: {
-            float percent_complete = ((float)position()) * 100.0f / size();
+            // Progress through the stored bytes, which for a compressed file
+            // tracks progress through the G-code closely enough
+            float percent_complete = ((float)FileStream::position()) * 100.0f / size();
 
             std::ostringstream s;
             s << "SD:" << std::fixed << std::setprecision(2) << percent_complete << "," << path().c_str();
@@ -90,6 +128,11 @@ Error InputFile::pollLine(char* line) {
         }
             return Error::Ok;
         case Error::Eof:
+            if (corrupt()) {
+                log_error("Corrupt compressed data in " << name() << " after line " << lineNumber());
+                _progress = "";
+                return Error::FsFailedRead;
+            }
             end_message();
             return Error::Eof;
         default:
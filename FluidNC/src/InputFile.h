@@ -8,6 +8,7 @@
 //  - For reporting the progress of GCode execution, counts the number of lines read and
 //    the percentage of the file size that has currently been read.
 //  - For reporting status, remembers the I/O channel that started the process of using the file.
+//  - Decompresses files that were stored with GcodeCodec, as they are read.
 // FileStream's Channel member is not that same Channel that FileStream ultimately
 // inherits from; rather it is a separate channel that is use for status reporting.
 
@@ -16,8 +17,10 @@
 #include "WebUI/Authentication.h"
 #include "FileStream.h"  // FileStream and Channel
 #include "Error.h"
+#include "GcodeCodec.h"
 
 #include <cstdint>
+#include <memory>
 
 class InputFile : public FileStream {
 private:
@@ -26,6 +29,10 @@ private:
 
     size_t _blank_lines = 0;
 
+    // Set if the file is compressed.  The stream position is then the
+    // position in the decompressed data, so that loops can seek back.
+    std::unique_ptr<GcodeCodec::Decoder> _decoder;
+
 public:
     // fsname is the default file system on which the file is located, in case the path does not specify
     // path is the full path to the file
@@ -47,6 +54,17 @@ public:
 
     Error readLine(char* line, size_t len);
 
+    bool compressed() { return _decoder != nullptr; }
+    bool corrupt() { return _decoder && _decoder->failed(); }
+
+    int    read() override;
+    int    read(char* buffer, size_t length);
+    int    read(uint8_t* buffer, size_t length) { return read((char*)buffer, length); }
+    size_t readBytes(char* buffer, size_t length) override { return read(buffer, length); }
+
+    size_t position() override;
+    void   set_position(size_t pos) override;
+
     // Channel methods
     size_t write(uint8_t c) override { return 0; }
     void   ack(Error status) override;
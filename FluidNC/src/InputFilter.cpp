@@ -0,0 +1,53 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "InputFilter.h"
+#include "Platform.h"  // IRAM_ATTR
+
+void InputFilter::set_samples(int input, uint32_t samples, bool level) {
+    if (samples > max_samples) {
+        samples = max_samples;
+    }
+    _needed[input] = uint8_t(samples);
+    _count[input]  = 0;
+    set_level(input, level);
+    if (samples > 1) {
+        _filtered = _filtered | bit(input);
+    } else {
+        _filtered = _filtered & ~bit(input);
+    }
+}
+
+void InputFilter::set_level(int input, bool level) {
+    if (level) {
+        _stable = _stable | bit(input);
+    } else {
+        _stable = _stable & ~bit(input);
+    }
+}
+
+void IRAM_ATTR InputFilter::sample(mask_t raw) {
+    mask_t filtered = _filtered;
+    mask_t stable   = _stable;
+    mask_t differ   = (raw ^ stable) & filtered;
+
+    _sample_count = _sample_count + 1;
+    while (filtered) {
+        int    input = __builtin_ctzll(filtered);
+        mask_t m     = bit(input);
+        filtered &= ~m;
+
+        if (differ & m) {
+            if (++_count[input] >= _needed[input]) {
+                stable ^= m;
+                _count[input] = 0;
+            }
+        } else if (_count[input]) {
+            // The input went back to its filtered level before
+            // it had been stable long enough, so it was a glitch
+            _count[input] = 0;
+            _glitches[input] = _glitches[input] + 1;
+        }
+    }
+    _stable = stable;
+}
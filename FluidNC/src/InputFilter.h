@@ -0,0 +1,48 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+
+// InputFilter rejects short glitches on digital inputs.  Inputs are
+// sampled together as a bitmask, typically from a periodic timer
+// interrupt.  A filtered input must be seen at a new level for a
+// configured number of consecutive samples before its filtered level
+// changes; a change that does not last that long is counted as a
+// rejected glitch.  Inputs that are not filtered pass through unchanged.
+
+class InputFilter {
+public:
+    using mask_t = uint64_t;
+
+    static const int      max_inputs  = 64;
+    static const uint32_t max_samples = 255;
+
+    // samples of 0 or 1 disables filtering for the input
+    void     set_samples(int input, uint32_t samples, bool level);
+    uint32_t samples(int input) const { return _needed[input]; }
+
+    // Force the filtered level, for example when the input is inverted
+    void set_level(int input, bool level);
+
+    // Add one sample of all inputs.  Safe to call from an ISR.
+    void sample(mask_t raw);
+
+    // Substitute filtered levels for the filtered bits of raw
+    mask_t apply(mask_t raw) const { return (raw & ~_filtered) | (_stable & _filtered); }
+
+    mask_t   filtered() const { return _filtered; }
+    uint32_t glitches(int input) const { return _glitches[input]; }
+    uint32_t sample_count() const { return _sample_count; }
+
+private:
+    static mask_t bit(int input) { return mask_t(1) << input; }
+
+    volatile mask_t   _filtered             = 0;  // Inputs that have a filter
+    volatile mask_t   _stable               = 0;  // Filtered levels
+    uint8_t           _needed[max_inputs]   = { 0 };
+    uint8_t           _count[max_inputs]    = { 0 };
+    volatile uint32_t _glitches[max_inputs] = { 0 };
+    volatile uint32_t _sample_count         = 0;
+};
@@ -0,0 +1,80 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "LittleFSUsage.h"
+
+namespace stdfs = std::filesystem;
+
+namespace LittleFSUsage {
+    // Each metadata entry has tags for its name and its struct, and
+    // commits carry a CRC tag; this is the average cost per entry.
+    static const uint32_t entry_overhead = 16;
+
+    uint32_t Report::overhead_percent() const {
+        if (used_blocks <= min_blocks || !used_blocks) {
+            return 0;
+        }
+        return uint32_t((used_blocks - min_blocks) * 100 / used_blocks);
+    }
+
+    // Block 0 of a skip-list holds only data.  Block n also holds
+    // ctz(n)+1 pointers to earlier blocks, 4 bytes each.
+    uint64_t file_blocks(uint64_t size, const Geometry& geometry) {
+        uint64_t blocks = 0;
+        while (size) {
+            uint32_t capacity = geometry.block_size;
+            if (blocks) {
+                capacity -= 4 * (__builtin_ctzll(blocks) + 1);
+            }
+            size -= size < capacity ? size : capacity;
+            ++blocks;
+        }
+        return blocks;
+    }
+
+    // A metadata block is compacted when it fills, and split when compaction
+    // cannot get it below half full, so a pair holds about half a block.
+    uint64_t dir_pairs(uint64_t metadata_bytes, const Geometry& geometry) {
+        uint64_t per_pair = geometry.block_size / 2;
+        return metadata_bytes ? (metadata_bytes + per_pair - 1) / per_pair : 1;
+    }
+
+    uint64_t write_blocks(uint64_t size, const Geometry& geometry) {
+        return (size <= geometry.inline_max ? 0 : file_blocks(size, geometry)) + 1;
+    }
+
+    static void analyze_dir(const stdfs::path& dir, const Geometry& geometry, Report& report) {
+        std::error_code ec;
+        uint64_t        metadata = 0;
+
+        ++report.dirs;
+        for (auto it = stdfs::directory_iterator { dir, ec }; !ec && it != stdfs::directory_iterator(); it.increment(ec)) {
+            auto name = it->path().filename().string();
+            metadata += entry_overhead + name.length();
+            if (it->is_directory(ec)) {
+                analyze_dir(it->path(), geometry, report);
+                continue;
+            }
+            uint64_t size = it->file_size(ec);
+            if (ec) {
+                ec.clear();
+                continue;
+            }
+            ++report.files;
+            report.data_bytes += size;
+            if (size <= geometry.inline_max) {
+                ++report.inline_files;
+                metadata += size;
+            } else {
+                report.min_blocks += file_blocks(size, geometry);
+            }
+        }
+        report.min_blocks += 2 * dir_pairs(metadata, geometry);
+    }
+
+    Report analyze(const stdfs::path& root, const Geometry& geometry) {
+        Report report;
+        analyze_dir(root, geometry, report);
+        return report;
+    }
+}
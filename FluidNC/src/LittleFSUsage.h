@@ -0,0 +1,47 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+// Estimates how a directory tree is laid out on a LittleFS volume, from
+// the sizes of its files and directories.  LittleFS does not report its
+// block usage per file, so comparing these estimates with the number of
+// blocks in use shows how much space is tied up in metadata logs and
+// piecemeal file histories.
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace LittleFSUsage {
+    struct Geometry {
+        uint32_t block_size = 4096;
+        uint32_t inline_max = 512;  // Files up to this size live in their directory's metadata
+    };
+
+    struct Report {
+        uint32_t files        = 0;
+        uint32_t dirs         = 0;  // Including the root
+        uint32_t inline_files = 0;
+        uint64_t data_bytes   = 0;
+        uint64_t min_blocks   = 0;  // Blocks that the contents need, at a minimum
+        uint64_t used_blocks  = 0;  // Blocks that the filesystem says are in use
+        uint64_t total_blocks = 0;
+
+        // Blocks in use beyond what the contents need, as a percentage of the blocks in use
+        uint32_t overhead_percent() const;
+    };
+
+    // Blocks in the CTZ skip-list of a file that is not stored inline
+    uint64_t file_blocks(uint64_t size, const Geometry& geometry);
+
+    // Metadata pairs that hold a directory's entries
+    uint64_t dir_pairs(uint64_t metadata_bytes, const Geometry& geometry);
+
+    // Blocks that writing a file of this size takes, including a metadata commit
+    uint64_t write_blocks(uint64_t size, const Geometry& geometry);
+
+    // Walks the tree at root.  used_blocks and total_blocks are left for the caller.
+    Report analyze(const std::filesystem::path& root, const Geometry& geometry);
+}
@@ -0,0 +1,160 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "LocalFSMaint.h"
+
+#include "Driver/localfs.h"
+#include "Settings.h"  // nvs
+#include "Module.h"
+#include "NutsBolts.h"  // get_ms()
+#include "Logging.h"
+#include "string_util.h"
+
+#include <mutex>
+
+namespace LocalFSMaint {
+    // Lifetime write statistics, kept in NVS.  LittleFS does not expose the
+    // erase counts of its blocks, so wear is estimated from what was written.
+    struct Wear {
+        uint64_t bytes  = 0;
+        uint64_t blocks = 0;
+        uint32_t files  = 0;
+    };
+
+    static const char*    wear_key         = "lfsWear";
+    static const uint32_t save_interval_ms = 60000;
+
+    static std::mutex maint_mutex;
+    static Wear       wear;
+    static bool       wear_dirty    = false;
+    static uint32_t   wear_saved_ms = 0;
+    static uint64_t   session_bytes = 0;
+    static uint32_t   session_files = 0;
+
+    static bool is_localfs(const stdfs::path& path) {
+        const auto& name = path.string();
+        const auto& root = LocalFS.prefix;
+        return !root.empty() && string_util::starts_with_ignore_case(name, root) && (name.length() == root.length() || name[root.length()] == '/');
+    }
+
+    bool geometry(LittleFSUsage::Geometry& geometry) {
+        return localfs_littlefs_geometry(geometry.block_size, geometry.inline_max);
+    }
+
+    bool analyze(LittleFSUsage::Report& report) {
+        LittleFSUsage::Geometry g;
+        if (!geometry(g)) {
+            return false;
+        }
+        std::error_code ec;
+        auto            space = stdfs::space(LocalFS.prefix, ec);
+        if (ec) {
+            return false;
+        }
+        report              = LittleFSUsage::analyze(LocalFS.prefix, g);
+        report.total_blocks = space.capacity / g.block_size;
+        report.used_blocks  = (space.capacity - space.available) / g.block_size;
+        return true;
+    }
+
+    void report(Channel& out) {
+        LittleFSUsage::Report r;
+        if (!analyze(r)) {
+            log_string(out, "The local filesystem is not LittleFS");
+            return;
+        }
+        LittleFSUsage::Geometry g;
+        geometry(g);
+
+        std::lock_guard<std::mutex> lock(maint_mutex);
+        log_stream(out, "Blocks: " << r.used_blocks << " of " << r.total_blocks << " used, " << g.block_size << " bytes each");
+        log_stream(out,
+                   "Contents: " << r.files << " files (" << r.inline_files << " small), " << r.dirs << " directories, " << r.data_bytes
+                                << " bytes");
+        log_stream(out, "Overhead: " << r.overhead_percent() << "% - contents need about " << r.min_blocks << " blocks");
+        log_stream(out, "Writes since boot: " << session_files << " files, " << session_bytes << " bytes");
+        log_stream(out, "Writes lifetime: " << wear.files << " files, " << wear.bytes << " bytes, " << wear.blocks << " blocks");
+        if (r.total_blocks) {
+            log_stream(out, "Wear: about " << float(wear.blocks) / r.total_blocks << " program/erase cycles per block");
+        }
+    }
+
+    bool has_room(const stdfs::path& path, uint64_t size) {
+        std::error_code ec;
+        auto            space = stdfs::space(path.parent_path(), ec);
+        if (ec) {
+            // Let the write itself report the problem
+            return true;
+        }
+
+        LittleFSUsage::Geometry g;
+        if (!is_localfs(path) || !geometry(g)) {
+            // FAT frees the old clusters as soon as the file is truncated
+            uint64_t existing = 0;
+            if (stdfs::is_regular_file(path, ec)) {
+                existing = stdfs::file_size(path, ec);
+                if (ec) {
+                    existing = 0;
+                }
+            }
+            return size <= space.available + existing;
+        }
+        return LittleFSUsage::write_blocks(size, g) * g.block_size <= space.available;
+    }
+
+    static void count_write(uint64_t bytes) {
+        LittleFSUsage::Geometry g;
+        geometry(g);
+
+        std::lock_guard<std::mutex> lock(maint_mutex);
+        ++session_files;
+        session_bytes += bytes;
+        ++wear.files;
+        wear.bytes += bytes;
+        wear.blocks += LittleFSUsage::write_blocks(bytes, g);
+        wear_dirty = true;
+    }
+
+    void write_finished(const stdfs::path& path, uint64_t bytes) {
+        if (is_localfs(path)) {
+            count_write(bytes);
+        }
+    }
+
+    static void load_wear() {
+        size_t len = sizeof(wear);
+        if (nvs.get_blob(wear_key, &wear, &len) || len != sizeof(wear)) {
+            wear = {};
+        }
+        wear_saved_ms = get_ms();
+    }
+
+    static void save_wear() {
+        Wear copy;
+        {
+            std::lock_guard<std::mutex> lock(maint_mutex);
+            copy       = wear;
+            wear_dirty = false;
+        }
+        nvs.set_blob(wear_key, &copy, sizeof(copy));
+        wear_saved_ms = get_ms();
+    }
+
+    void poll() {
+        uint32_t now = get_ms();
+        if (wear_dirty && int32_t(now - wear_saved_ms) > int32_t(save_interval_ms)) {
+            save_wear();
+        }
+    }
+
+    class LocalFSMaintModule : public Module {
+    public:
+        explicit LocalFSMaintModule(const char* name) : Module(name) {}
+
+        void init() override { load_wear(); }
+
+        void poll() override { LocalFSMaint::poll(); }
+    };
+
+    ModuleFactory::InstanceBuilder<LocalFSMaintModule> localfs_maint_module("localfs_maint", true);
+}
@@ -0,0 +1,36 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+// Upkeep of a LittleFS local filesystem: usage and wear statistics,
+// and space checks for uploads.
+
+#include "FluidPath.h"
+#include "LittleFSUsage.h"
+#include "Channel.h"
+
+#include <cstdint>
+
+namespace LocalFSMaint {
+    // False if the local filesystem is not LittleFS
+    bool geometry(LittleFSUsage::Geometry& geometry);
+
+    // Analyzes the local filesystem, filling in the block counts too
+    bool analyze(LittleFSUsage::Report& report);
+
+    void report(Channel& out);
+
+    // Checks whether a file of size bytes can be written at path.
+    // LittleFS keeps the old file's blocks until the new file is
+    // closed, so replacing a file needs room for both.  The existing
+    // file is never removed to make room, since the write may not
+    // complete.
+    bool has_room(const stdfs::path& path, uint64_t size);
+
+    // FileStream calls this when it closes a written file, so that the
+    // wear statistics include every write.
+    void write_finished(const stdfs::path& path, uint64_t bytes);
+
+    void poll();
+}
@@ -7,6 +7,9 @@
 #include "SettingsDefinitions.h"
 #include "Channel.h"
 
+#include <atomic>
+#include <freertos/task.h>  // xTaskGetTickCount
+
 const EnumItem messageLevels2[] = { { MsgLevelNone, "None" }, { MsgLevelError, "Error" }, { MsgLevelWarning, "Warn" },
                                     { MsgLevelInfo, "Info" }, { MsgLevelDebug, "Debug" }, { MsgLevelVerbose, "Verbose" },
                                     EnumItem(MsgLevelNone) };
@@ -15,8 +18,96 @@ bool atMsgLevel(MsgLevel level) {
     return message_level == nullptr || message_level->get() >= level;
 }
 
+// Message buffer pool.  A bit in log_buffers_free is set for each free buffer,
+// so buffers can be taken and returned from any task without a lock.
+static_assert(LOG_BUFFER_COUNT <= 32, "The free buffer mask has 32 bits");
+
+static char                  log_buffers[LOG_BUFFER_COUNT][LOG_BUFFER_SIZE];
+static std::atomic<uint32_t> log_buffers_free(uint32_t((uint64_t(1) << LOG_BUFFER_COUNT) - 1));
+static std::atomic<uint32_t> log_buffers_peak(0);    // Most buffers in use at once
+static std::atomic<uint32_t> log_buffers_missed(0);  // Messages that found the pool empty
+
+static char* log_acquire() {
+    uint32_t free = log_buffers_free.load();
+    while (free) {
+        uint32_t bit = free & (~free + 1);  // Lowest free buffer
+        if (log_buffers_free.compare_exchange_weak(free, free & ~bit)) {
+            uint32_t in_use = LOG_BUFFER_COUNT - __builtin_popcount(free & ~bit);
+            uint32_t peak   = log_buffers_peak.load();
+            while (in_use > peak && !log_buffers_peak.compare_exchange_weak(peak, in_use)) {}
+            return log_buffers[__builtin_ctz(bit)];
+        }
+    }
+    ++log_buffers_missed;
+    return nullptr;
+}
+
+void log_release(const char* line) {
+    if (line >= log_buffers[0] && line < log_buffers[0] + sizeof(log_buffers)) {
+        log_buffers_free |= uint32_t(1) << ((line - log_buffers[0]) / LOG_BUFFER_SIZE);
+    }
+}
+
+// Per-level rate limiting, in messages per second.  0 means no limit.
+static const uint32_t log_rate_limits[] = { 0, 0, 0, 0, LOG_DEBUG_RATE_LIMIT, LOG_VERBOSE_RATE_LIMIT };
+
+struct LogLevelCounters {
+    std::atomic<uint32_t> second;        // Current rate limit window
+    std::atomic<uint32_t> count;         // Messages admitted in this window
+    std::atomic<uint32_t> rate_dropped;  // Dropped by the rate limit since the last report
+    std::atomic<uint32_t> rate_total;    // Dropped by the rate limit since startup
+    std::atomic<uint32_t> full_total;    // Dropped because the message queue was full
+};
+
+static LogLevelCounters log_counters[MsgLevelVerbose + 1];
+
+bool log_admit(MsgLevel level) {
+    if (!atMsgLevel(level)) {
+        return false;
+    }
+    uint32_t limit = log_rate_limits[level];
+    if (limit == 0) {
+        return true;
+    }
+    auto&    counters = log_counters[level];
+    uint32_t second   = xTaskGetTickCount() / configTICK_RATE_HZ;
+    uint32_t previous = counters.second.exchange(second);
+    if (previous != second) {
+        counters.count = 0;
+        if (uint32_t dropped = counters.rate_dropped.exchange(0)) {
+            log_warn(dropped << " " << messageLevels2[level].name << " messages dropped by rate limit");
+        }
+    }
+    if (++counters.count > limit) {
+        ++counters.rate_dropped;
+        ++counters.rate_total;
+        return false;
+    }
+    return true;
+}
+
+void log_dropped(MsgLevel level) {
+    ++log_counters[level].full_total;
+}
+
+void log_report_stats(Channel& out) {
+    for (int level = MsgLevelError; level <= MsgLevelVerbose; ++level) {
+        auto& counters = log_counters[level];
+        auto  limit    = log_rate_limits[level];
+        log_stream(out,
+                   messageLevels2[level].name << ": limit " << (limit ? std::to_string(limit) + "/s" : "none") << " rate dropped "
+                                              << counters.rate_total.load() << " queue full dropped " << counters.full_total.load());
+    }
+    log_stream(out,
+               "Buffers: " << (LOG_BUFFER_COUNT - __builtin_popcount(log_buffers_free.load())) << "/" << LOG_BUFFER_COUNT << " in use, peak "
+                           << log_buffers_peak.load() << ", pool empty " << log_buffers_missed.load());
+}
+
 LogStream::LogStream(Channel& channel, MsgLevel level) : _channel(channel), _level(level) {
-    _line = new std::string();
+    _buffer = log_acquire();
+    if (!_buffer) {
+        _line = new std::string();
+    }
 }
 
 LogStream::LogStream(Channel& channel, MsgLevel level, const char* name) : LogStream(channel, level) {
@@ -27,11 +118,30 @@ LogStream::LogStream(Channel& channel, const char* name) : LogStream(channel, Ms
 LogStream::LogStream(MsgLevel level, const char* name) : LogStream(allChannels, level, name) {}
 
 size_t LogStream::write(uint8_t c) {
+    if (_buffer) {
+        // Leave room for the closing ']' and the terminator
+        if (_length < LOG_BUFFER_SIZE - 2) {
+            _buffer[_length++] = c;
+            return 1;
+        }
+        _line = new std::string(_buffer, _length);
+        log_release(_buffer);
+        _buffer = nullptr;
+    }
     *_line += (char)c;
     return 1;
 }
 
 LogStream::~LogStream() {
+    if (_buffer) {
+        if (_length && _buffer[0] == '[') {
+            _buffer[_length++] = ']';
+        }
+        _buffer[_length] = '\0';
+        // The buffer is returned to the pool once the line has been sent
+        _channel.sendLine(_level, static_cast<const char*>(_buffer));
+        return;
+    }
     if ((*_line).length() && (*_line)[0] == '[') {
         *_line += ']';
     }
@@ -52,6 +52,10 @@ extern const EnumItem messageLevels2[];
 
 #    include "MyIOStream.h"
 
+// A LogStream builds its message in a fixed-size buffer from a preallocated
+// pool, so logging does not touch the heap.  A message that outgrows its
+// buffer, or that is built while every buffer is in use, continues in a
+// heap-allocated std::string as before.
 class LogStream : public Print {
 public:
     LogStream(Channel& channel, MsgLevel level);
@@ -63,32 +67,67 @@ public:
 
 private:
     Channel&     _channel;
-    std::string* _line;
+    char*        _buffer = nullptr;
+    size_t       _length = 0;
+    std::string* _line   = nullptr;
     MsgLevel     _level;
 };
 
 extern bool atMsgLevel(MsgLevel level);
 
+// atMsgLevel() plus the per-level rate limit.  Messages over the limit are
+// counted as dropped instead of being formatted.
+extern bool log_admit(MsgLevel level);
+
+// Counts a message that was dropped because the message queue was full.
+extern void log_dropped(MsgLevel level);
+
+// Returns a message buffer to the pool after the line has been sent.  Lines
+// that did not come from the pool, such as string constants, are ignored.
+extern void log_release(const char* line);
+
+// Reports drop counters and buffer pool usage
+extern void log_report_stats(Channel& out);
+
+// Messages above LOG_LEVEL_LIMIT are compiled out entirely, so neither the
+// level test nor the formatting code is generated.  Build with e.g.
+// -DLOG_LEVEL_LIMIT=MsgLevelInfo to remove all debug and verbose messages.
+// Timing-critical files such as Stepper.cpp define LOG_HOT_PATH before any
+// include, which applies the lower LOG_HOT_PATH_LEVEL_LIMIT, so that turning
+// on debug logging does not change the step timing that is being debugged.
+#    ifndef LOG_LEVEL_LIMIT
+#        define LOG_LEVEL_LIMIT MsgLevelVerbose
+#    endif
+#    ifndef LOG_HOT_PATH_LEVEL_LIMIT
+#        define LOG_HOT_PATH_LEVEL_LIMIT MsgLevelInfo
+#    endif
+#    ifdef LOG_HOT_PATH
+#        define LOG_COMPILED_LEVEL (LOG_HOT_PATH_LEVEL_LIMIT < LOG_LEVEL_LIMIT ? LOG_HOT_PATH_LEVEL_LIMIT : LOG_LEVEL_LIMIT)
+#    else
+#        define LOG_COMPILED_LEVEL LOG_LEVEL_LIMIT
+#    endif
+#    define log_enabled(level) ((level) <= LOG_COMPILED_LEVEL && log_admit(level))
+
 // clang-format off
 
 // Note: these '{'..'}' scopes are here for a reason: the destructor should flush.
 
 // #define log_bare(prefix, x) { LogStream ss(prefix); ss << x; }
 #define log_msg(x) { LogStream ss(MsgLevelNone, "[MSG:"); ss << x; }
-#define log_verbose(x) if (atMsgLevel(MsgLevelVerbose)) { LogStream ss(MsgLevelVerbose, "[MSG:VRB: "); ss << x; }
-#define log_debug(x) if (atMsgLevel(MsgLevelDebug)) { LogStream ss(MsgLevelDebug, "[MSG:DBG: "); ss << x; }
-#define log_info(x) if (atMsgLevel(MsgLevelInfo)) { LogStream ss(MsgLevelInfo, "[MSG:INFO: "); ss << x; }
-#define log_warn(x) if (atMsgLevel(MsgLevelWarning)) { LogStream ss(MsgLevelWarning, "[MSG:WARN: "); ss << x; }
-#define log_error(x) if (atMsgLevel(MsgLevelError)) { LogStream ss(MsgLevelError, "[MSG:ERR: "); ss << x; }
-#define log_config_error(x) if (atMsgLevel(MsgLevelError)) { LogStream ss(MsgLevelError, "[MSG:ERR: "); ss << x; set_state(State::ConfigAlarm); }
+#define log_verbose(x) if (log_enabled(MsgLevelVerbose)) { LogStream ss(MsgLevelVerbose, "[MSG:VRB: "); ss << x; }
+#define log_debug(x) if (log_enabled(MsgLevelDebug)) { LogStream ss(MsgLevelDebug, "[MSG:DBG: "); ss << x; }
+#define log_info(x) if (log_enabled(MsgLevelInfo)) { LogStream ss(MsgLevelInfo, "[MSG:INFO: "); ss << x; }
+#define log_warn(x) if (log_enabled(MsgLevelWarning)) { LogStream ss(MsgLevelWarning, "[MSG:WARN: "); ss << x; }
+#define log_error(x) if (log_enabled(MsgLevelError)) { LogStream ss(MsgLevelError, "[MSG:ERR: "); ss << x; }
+#define log_config_error(x) if (log_enabled(MsgLevelError)) { LogStream ss(MsgLevelError, "[MSG:ERR: "); ss << x; set_state(State::ConfigAlarm); }
 #define log_fatal(x) { LogStream ss(MsgLevelNone, "[MSG:FATAL: "); ss << x;  Assert(false, "A fatal error occurred"); }
 
 #define log_msg_to(out, x) { LogStream ss(out, MsgLevelNone, "[MSG:"); ss << x; }
-#define log_verbose_to(out, x) if (atMsgLevel(MsgLevelVerbose)) { LogStream ss(out, MsgLevelVerbose, "[MSG:VRB: "); ss << x; }
-#define log_debug_to(out, x) if (atMsgLevel(MsgLevelDebug)) { LogStream ss(out, MsgLevelDebug, "[MSG:DBG: "); ss << x; }
-#define log_info_to(out, x) if (atMsgLevel(MsgLevelInfo)) { LogStream ss(out, MsgLevelInfo, "[MSG:INFO: "); ss << x; }
-#define log_warn_to(out, x) if (atMsgLevel(MsgLevelWarning)) { LogStream ss(out, MsgLevelWarning, "[MSG:WARN: "); ss << x; }
-#define log_error_to(out, x) if (atMsgLevel(MsgLevelError)) { LogStream ss(out, MsgLevelError, "[MSG:ERR: "); ss << x; }
+#define log_verbose_to(out, x) if (log_enabled(MsgLevelVerbose)) { LogStream ss(out, MsgLevelVerbose, "[MSG:VRB: "); ss << x; }
+#define log_debug_to(out, x) if (log_enabled(MsgLevelDebug)) { LogStream ss(out, MsgLevelDebug, "[MSG:DBG: "); ss << x; }
+#define log_info_to(out, x) if (log_enabled(MsgLevelInfo)) { LogStream ss(out, MsgLevelInfo, "[MSG:INFO: "); ss << x; }
+#define log_warn_to(out, x) if (log_enabled(MsgLevelWarning)) { LogStream ss(out, MsgLevelWarning, "[MSG:WARN: "); ss << x; }
+#define log_error_to(out, x) if (log_enabled(MsgLevelError)) { LogStream ss(out, MsgLevelError, "[MSG:ERR: "); ss << x; }
 #define log_fatal_to(out, x) { LogStream ss(out, MsgLevelNone, "[MSG:FATAL: "); ss << x;  Assert(false, "A fatal error occurred"); }
 
 // #define log_to(out, prefix, x) { LogStream ss(out, MsgLevelNone, prefix); ss << x; }
@@ -6,7 +6,8 @@
 #include "MotionControl.h"
 #include "Stepper.h"  // stepper_id_t
 #include "Limit.h"
-#include "MachineConfig.h"  // config->
+#include "MachineConfig.h"       // config->
+#include "Pins/I2SOPinDetail.h"  // I2SOBatch
 
 namespace Machine {
     MotorMask Axes::posLimitMask = 0;
@@ -87,11 +88,15 @@ namespace Machine {
     }
 
     void IRAM_ATTR Axes::set_disable(bool disable, bool manual_override) {
-        for (axis_t axis = X_AXIS; axis < _numberAxis; axis++) {
-            set_disable(axis, disable, manual_override);
-        }
+        {
+            // All of the enables on shift registers change in one frame
+            Pins::I2SOBatch batch;
+            for (axis_t axis = X_AXIS; axis < _numberAxis; axis++) {
+                set_disable(axis, disable, manual_override);
+            }
 
-        _sharedStepperDisable.synchronousWrite(disable);
+            _sharedStepperDisable.synchronousWrite(disable);
+        }
 
         if (!disable && disabled) {
             disabled = false;
@@ -112,6 +117,7 @@ namespace Machine {
                 if (a != nullptr) {
                     for (motor_t motor = 0; motor < Axis::MAX_MOTORS_PER_AXIS; motor++) {
                         Stepping::unblock(axis, motor);
+                        Stepping::clear_correction(axis, motor);  // Homing squares the axis
                         auto m = _axis[axis]->_motors[motor];
                         if (m) {
                             if (m->_driver->set_homing_mode(isHoming)) {
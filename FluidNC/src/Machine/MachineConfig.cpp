@@ -86,7 +86,8 @@ namespace Machine {
         handler.item("report_inches", _reportInches);
         handler.item("enable_parking_override_control", _enableParkingOverrideControl);
         handler.item("use_line_numbers", _useLineNumbers);
-        handler.item("planner_blocks", _planner_blocks, 10, 120);
+        handler.item("planner_blocks", _planner_blocks, 10, 4000);
+        handler.item("input_filter_hz", _input_filter_hz, 1000, 50000);
     }
 
     void MachineConfig::afterParse() {
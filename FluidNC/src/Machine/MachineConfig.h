@@ -97,6 +97,9 @@ namespace Machine {
 
         int32_t _planner_blocks = 16;
 
+        // Sample rate for input pins that have a :filter=N attribute
+        uint32_t _input_filter_hz = 10000;
+
         // Enables a special set of M-code commands that enables and disables the parking motion.
         // These are controlled by `M56`, `M56 P1`, or `M56 Px` to enable and `M56 P0` to disable.
         // The command is modal and will be set after a planner sync. Since it is GCode, it is
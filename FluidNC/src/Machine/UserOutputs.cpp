@@ -3,7 +3,8 @@
 // Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
 
 #include "UserOutputs.h"
-#include "Config.h"  // log_*
+#include "Config.h"              // log_*
+#include "Pins/I2SOPinDetail.h"  // I2SOBatch
 
 namespace Machine {
     UserOutputs::UserOutputs() {
@@ -14,6 +15,7 @@ namespace Machine {
     UserOutputs::~UserOutputs() {}
 
     void UserOutputs::init() {
+        Pins::I2SOBatch batch;
         for (int i = 0; i < MaxUserDigitalPin; ++i) {
             Pin& pin = _digitalOutput[i];
             if (pin.defined()) {
@@ -34,6 +36,7 @@ namespace Machine {
     }
 
     void UserOutputs::all_off() {
+        Pins::I2SOBatch batch;
         for (size_t io_num = 0; io_num < MaxUserDigitalPin; io_num++) {
             setDigital(io_num, false);
         }
@@ -47,6 +50,9 @@ namespace Machine {
         if (pin.undefined()) {
             return !isOn;  // It is okay to turn off an undefined pin, for safety
         }
+        // M62-M65 land here; the write joins an enclosing batch such as
+        // all_off(), and otherwise goes out as its own locked commit
+        Pins::I2SOBatch batch;
         pin.synchronousWrite(isOn);
         return true;
     }
@@ -22,6 +22,7 @@
 #    include "FluidPath.h"
 
 #    include "Driver/localfs.h"
+#    include "Driver/fluidnc_gpio.h"
 
 #    include "ToolChangers/atc.h"
 
@@ -143,6 +144,7 @@ void setup() {
             auto spindles = Spindles::SpindleFactory::objects();
             for (auto const& spindle : spindles) {
                 spindle->init();
+                spindle->init_tachometer();
             }
             bool stopped_spindle, new_spindle;
             Spindles::Spindle::switchSpindle(0, spindles, spindle, stopped_spindle, new_spindle);
@@ -158,7 +160,8 @@ void setup() {
         log_config_error("Critical error in main_init: " << ex.what());
     }
 
-    poll_gpios();  // Initial poll to send events for initial pin states
+    gpio_filter_start(config->_input_filter_hz);  // Starts sampling if any input pin has a filter
+    poll_gpios();                                 // Initial poll to send events for initial pin states
 
     allChannels.ready();
     allChannels.deregistration(&startupLog);
@@ -14,8 +14,10 @@
 #include "Platform.h"        // WEAK_LINK
 #include "Settings.h"        // coords
 #include "State.h"           // State
+#include "TaskProfiler.h"    // ProfileWait
 
 #include <cmath>
+#include <algorithm>  // std::min
 
 // M_PI is not defined in standard C/C++ but some compilers
 // support it anyway.  The following suppresses Intellisense
@@ -71,6 +73,7 @@ bool mc_move_motors(float* target, plan_line_data_t* pl_data) {
     // If the buffer is full: good! That means we are well ahead of the robot.
     // Remain in this loop until there is room in the buffer.
 
+    ProfileWait wait;
     while (plan_check_full_buffer()) {
         protocol_auto_cycle_start();  // Auto-cycle start when buffer is full.
 
@@ -277,6 +280,9 @@ bool mc_dwell(int32_t milliseconds) {
 
 volatile bool probing;
 
+volatile bool probe_block_started = false;
+volatile bool probe_guard_started = false;
+
 bool probe_succeeded = false;
 
 // Perform tool length probe cycle. Requires probe switch.
@@ -315,13 +321,16 @@ GCUpdatePos mc_probe_cycle(float* target, plan_line_data_t* pl_data, bool away,
     probing = true;
     // Perform probing cycle. Wait here until probe is triggered or motion completes.
     protocol_send_event(&cycleStartEvent);
-    do {
-        protocol_execute_realtime();
-        if (sys.abort()) {
-            Stepping::endLowLatency();
-            return GCUpdatePos::None;  // Check for system abort
-        }
-    } while (!state_is(State::Idle));
+    {
+        ProfileWait wait;
+        do {
+            protocol_execute_realtime();
+            if (sys.abort()) {
+                Stepping::endLowLatency();
+                return GCUpdatePos::None;  // Check for system abort
+            }
+        } while (!state_is(State::Idle));
+    }
 
     Stepping::endLowLatency();
 
@@ -373,6 +382,192 @@ GCUpdatePos mc_probe_cycle(float* target, plan_line_data_t* pl_data, bool away,
     }
 }
 
+extern void protocol_do_probe(void* arg);
+
+// Queue a move and advance position to its target.
+static bool mc_probe_grid_move(float* target, plan_line_data_t* pl_data, float* position) {
+    if (!mc_linear(target, pl_data, position)) {
+        return false;
+    }
+    copyAxes(position, target);
+    return true;
+}
+
+// Probe a grid of points in one cycle.  Unlike a series of G38.2 commands,
+// there is no planner synchronization between points: the retract, the
+// travel to the next point and the next probe move are queued together so
+// they blend into one continuous motion.  The only stop per point is the
+// one forced by the contact itself.
+//
+// Rows are scanned in alternating directions.  With a clearance, the
+// retract goes only that far above the previous contact, so the probe
+// follows the contour of the surface instead of returning to the starting
+// height at every point.  The surface can rise by more than the clearance
+// between points, so that travel is at the probing feed rate, and a contact
+// on the way stops the machine with an alarm.
+Error mc_probe_grid(const ProbeGrid& grid, Channel& out) {
+    if (!config->_probe->exists()) {
+        log_error_to(out, "Probe pin is not configured");
+        return Error::ProbeFailed;
+    }
+    if (state_is(State::CheckMode)) {
+        return Error::Ok;
+    }
+    protocol_buffer_synchronize();
+    if (sys.abort()) {
+        return Error::Reset;
+    }
+
+    config->_probe->set_direction(false);
+    if (config->_probe->tripped()) {
+        send_alarm(ExecAlarm::ProbeFailInitial);
+        protocol_execute_realtime();
+        return Error::ProbeFailed;
+    }
+
+    plan_line_data_t pl_data = {};
+    pl_data.spindle          = gc_state.modal.spindle;
+    pl_data.spindle_speed    = gc_state.spindle_speed;
+    pl_data.coolant          = gc_state.modal.coolant;
+
+    float position[MAX_N_AXIS];
+    float target[MAX_N_AXIS];
+    copyAxes(position, gc_state.position);
+
+    const float safe_z     = position[Z_AXIS];
+    float       approach_z = safe_z;
+    Error       result     = Error::Ok;
+
+    Stepping::beginLowLatency();
+
+    uint32_t n_points = grid.count[X_AXIS] * grid.count[Y_AXIS];
+    for (uint32_t index = 0; index < n_points && result == Error::Ok; ++index) {
+        uint32_t row    = index / grid.count[X_AXIS];
+        uint32_t column = index % grid.count[X_AXIS];
+        if (row & 1) {
+            column = grid.count[X_AXIS] - 1 - column;
+        }
+
+        probe_block_started = false;
+        probe_guard_started = false;
+
+        // Retract and travel to the point at the approach height.
+        bool queued = true;
+        copyAxes(target, position);
+        pl_data.motion             = {};
+        pl_data.motion.rapidMotion = 1;
+        if (target[Z_AXIS] < approach_z) {
+            target[Z_AXIS] = approach_z;
+            queued         = mc_probe_grid_move(target, &pl_data, position);
+        }
+        if (approach_z < safe_z) {
+            // Below the starting height, the travel is guarded
+            pl_data.motion            = {};
+            pl_data.motion.guardProbe = 1;
+            pl_data.feed_rate         = grid.feed_rate;
+        }
+        target[X_AXIS] = grid.start[X_AXIS] + column * grid.step[X_AXIS];
+        target[Y_AXIS] = grid.start[Y_AXIS] + row * grid.step[Y_AXIS];
+        queued         = queued && mc_probe_grid_move(target, &pl_data, position);
+
+        // The probe move follows in the same planner pass.  The stepper ISR
+        // flags when it begins the move, so monitoring is armed only once the
+        // machine is actually moving down, not when the segment generator
+        // gets there.  The move may span several blocks with non-Cartesian
+        // kinematics; the first one to start arms.
+        pl_data.motion          = {};
+        pl_data.motion.armProbe = 1;
+        pl_data.feed_rate       = grid.feed_rate;
+        target[Z_AXIS]          = grid.depth;
+        queued                  = queued && mc_probe_grid_move(target, &pl_data, position);
+        if (!queued) {
+            result = sys.abort() ? Error::Reset : Error::SoftLimitError;
+            break;
+        }
+
+        probe_succeeded = false;
+        bool armed      = false;
+        bool initial    = false;
+        bool collided   = false;
+        protocol_send_event(&cycleStartEvent);
+        {
+            ProfileWait wait;
+            do {
+                protocol_execute_realtime();
+                if (sys.abort()) {
+                    probing = false;
+                    Stepping::endLowLatency();
+                    return Error::Reset;
+                }
+                if (!armed && !probe_block_started && probe_guard_started && config->_probe->tripped()) {
+                    // The probe ran into the work on the way to the point
+                    mc_critical(ExecAlarm::ProbeHardLimit);
+                    collided = true;
+                    break;
+                }
+                if (!armed && probe_block_started) {
+                    armed = true;
+                    // A probe that is still tripped never released on the retract.
+                    // Decelerate to a stop instead of cutting the steps, so the
+                    // position is kept.
+                    if (config->_probe->tripped()) {
+                        initial = true;
+                        protocol_do_motion_cancel();
+                    } else {
+                        probing = true;
+                        // The probe event only fires on a pin change, which may
+                        // have happened just before probing was enabled
+                        protocol_do_probe(nullptr);
+                    }
+                }
+            } while (!state_is(State::Idle));
+        }
+
+        if (collided) {
+            result = Error::ProbeFailed;
+        } else if (initial) {
+            send_alarm(ExecAlarm::ProbeFailInitial);
+            result = Error::ProbeFailed;
+        } else if (!armed || probing) {
+            send_alarm(ExecAlarm::ProbeFailContact);
+            result = Error::ProbeFailed;
+        } else {
+            probe_succeeded = true;
+        }
+        probing = false;
+        protocol_execute_realtime();
+
+        // The machine is stopped; discard the rest of the probe move and
+        // continue from where it stopped.
+        Stepper::reset();
+        plan_reset();
+        plan_sync_position();
+        steps_to_mpos(position, get_steps());
+
+        if (result == Error::Ok) {
+            float contact[MAX_N_AXIS];
+            steps_to_mpos(contact, probe_steps);
+            report_probe_grid_point(out, column, row, contact);
+            if (grid.clearance > 0) {
+                approach_z = std::min(contact[Z_AXIS] + grid.clearance, safe_z);
+            }
+        }
+    }
+
+    if (result == Error::Ok) {
+        copyAxes(target, position);
+        target[Z_AXIS]             = safe_z;
+        pl_data.motion             = {};
+        pl_data.motion.rapidMotion = 1;
+        mc_linear(target, &pl_data, position);
+        protocol_buffer_synchronize();
+    }
+
+    Stepping::endLowLatency();
+    gc_sync_position();
+    return result;
+}
+
 void mc_override_ctrl_update(Override override_state) {
     // Finish all queued commands before altering override control state
     protocol_buffer_synchronize();
@@ -8,6 +8,7 @@
 #include "Planner.h"
 #include "Config.h"
 #include "Probe.h"
+#include "Error.h"
 
 #include <cstdint>
 
@@ -15,6 +16,9 @@ extern volatile bool probing;  // Probing state value.  Used to coordinate the p
 
 extern bool probe_succeeded;  // Tracks if last probing cycle was successful.
 
+extern volatile bool probe_block_started;  // Set by the stepper ISR when it begins a block marked armProbe.
+extern volatile bool probe_guard_started;  // Set by the stepper ISR when it begins a block marked guardProbe.
+
 // Execute a linear motion in cartesian space.
 bool mc_linear(float* target, plan_line_data_t* pl_data, float* position);
 
@@ -42,6 +46,22 @@ bool mc_dwell(int32_t milliseconds);
 // Perform tool length probe cycle. Requires probe switch.
 GCUpdatePos mc_probe_cycle(float* target, plan_line_data_t* pl_data, bool away, bool no_error, AxisMask offsetAxis, float offset);
 
+// A rectangular grid of Z probe points, in machine coordinates and mm.
+struct ProbeGrid {
+    float    start[2];   // X and Y of the first point
+    float    step[2];    // Spacing between points along X and Y
+    uint32_t count[2];   // Number of points along X and Y
+    float    depth;      // Z where each probe move ends if there is no contact
+    float    clearance;  // Retract height above the previous contact, or 0 to retract to the starting Z
+    float    feed_rate;  // Probing feed rate in mm/min
+};
+
+class Channel;
+
+// Probe every point of a grid without waiting for the sender between points,
+// reporting each contact to out as it happens.  Requires probe switch.
+Error mc_probe_grid(const ProbeGrid& grid, Channel& out);
+
 // Handles updating the override control state.
 void mc_override_ctrl_update(Override override_state);
 
@@ -0,0 +1,419 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "MotionSync.h"
+
+#include "Machine/MachineConfig.h"
+#include "Driver/delay_usecs.h"  // getMicros()
+#include "GCode.h"               // gc_sync_position
+#include "Protocol.h"            // protocol_send_event
+#include "Serial.h"              // allChannels
+#include "State.h"               // state_is
+#include "Stepper.h"             // Stepper::wake_up
+#include "Stepping.h"
+
+#include <cstdlib>
+
+/*
+
+motion_sync:
+  role: leader
+  uart_num: 1
+  start_delay_ms: 30
+  sync_ms: 100
+
+*/
+
+using namespace SyncProtocol;
+
+static const EnumItem roleTypes[] = { { MotionSync::LEADER, "leader" }, { MotionSync::FOLLOWER, "follower" }, EnumItem(MotionSync::LEADER) };
+
+static MotionSync* motion_sync = nullptr;
+
+// Nominal length of a step segment
+static const uint32_t segment_us = 1000000 / ACCELERATION_TICKS_PER_SECOND;
+
+// Segment marks further than this from the local count are from another cycle
+static const int32_t max_mark_skew = 50;
+
+// Follower blocks wait in the queue until the leader's start time, so the
+// queue must hold as many blocks as the leader's planner
+static const UBaseType_t max_queued_blocks = 128;
+
+// Leader: the start time has come, so the steppers can start
+static void leader_start() {
+    if (motion_sync) {
+        motion_sync->begin();
+    }
+}
+static const NoArgEvent leaderStartEvent { leader_start };
+
+static uint8_t motion_bits(const PlMotion& motion) {
+    return motion.rapidMotion | (motion.noFeedOverride << 2) | (motion.inverseTime << 3);
+}
+
+static uint8_t coolant_bits(const CoolantState& coolant) {
+    return coolant.Mist | (coolant.Flood << 1);
+}
+
+void MotionSync::init() {
+    _uart = config->_uarts[_uart_num];
+    if (!_uart) {
+        log_error("Motion sync: Missing uart" << _uart_num << " section");
+        return;
+    }
+
+    if (_role == FOLLOWER) {
+        _blocks = xQueueCreate(max_queued_blocks, sizeof(Block));
+        if (!_blocks) {
+            log_config_error("Motion sync: Not enough memory for the block queue");
+            return;
+        }
+    }
+    if (uint32_t(config->_planner_blocks) > max_queued_blocks) {
+        log_warn("Motion sync: planner_blocks above " << max_queued_blocks << " can overflow the follower's block queue");
+    }
+    motion_sync = this;
+
+    if (!_task) {
+        xTaskCreatePinnedToCore(motion_sync_task,        // task
+                                "motionSyncTaskHandle",  // name for task
+                                3072,                    // size of task stack
+                                this,                    // parameters
+                                2,                       // priority
+                                &_task,
+                                SUPPORT_TASK_CORE  // core
+        );
+    }
+
+    log_info("Motion sync Role:" << roleTypes[_role].name << " Uart:" << _uart_num << " Start delay:" << _start_delay_ms << "ms");
+}
+
+// Reads frames from the other controller.  The follower also pings the
+// leader to measure the clock offset, and the leader sends segment marks
+// while a cycle runs and tells the protocol task when a cycle may start.
+void MotionSync::motion_sync_task(void* arg) {
+    auto     ms      = static_cast<MotionSync*>(arg);
+    Decoder  decoder;
+    uint32_t last_us = getMicros();
+    while (true) {
+        while (ms->_uart->available()) {
+            if (decoder.push(uint8_t(ms->_uart->read()))) {
+                ms->receive(decoder);
+            }
+        }
+
+        uint32_t now = getMicros();
+        if (ms->_role == LEADER && ms->_start_pending && !ms->_start_queued && int32_t(now - ms->_start_us) >= 0) {
+            ms->_start_queued = true;
+            protocol_send_event(&leaderStartEvent);
+        }
+        if (now - last_us >= ms->_sync_ms * 1000) {
+            last_us = now;
+            if (ms->_role == FOLLOWER) {
+                ms->send(encode(Ping { now }));
+            } else if (state_is(State::Cycle)) {
+                uint32_t number, us;
+                Stepping::segmentTime(number, us);
+                ms->send(encode(Segment { number - ms->_segment_base, us }));
+            }
+        }
+        vTaskDelay(1);
+    }
+}
+
+void MotionSync::send(Writer frame) {
+    std::lock_guard<std::mutex> lock(_write_mutex);
+    _uart->write(frame.data(), frame.size());
+}
+
+void MotionSync::receive(const Decoder& decoder) {
+    switch (decoder.type()) {
+        case MsgType::Ping: {
+            Ping ping;
+            if (_role == LEADER && decoder.get(ping)) {
+                send(encode(Pong { ping.follower_us, getMicros() }));
+            }
+            break;
+        }
+        case MsgType::Pong: {
+            Pong pong;
+            if (decoder.get(pong)) {
+                _clock.add(pong.follower_us, pong.leader_us, getMicros());
+            }
+            break;
+        }
+        case MsgType::Block: {
+            Block block;
+            if (_role == FOLLOWER && decoder.get(block) && !xQueueSend(_blocks, &block, 0)) {
+                log_error("Motion sync: Block queue full");
+            }
+            break;
+        }
+        case MsgType::Start: {
+            SyncProtocol::Start msg;
+            if (_role == FOLLOWER && decoder.get(msg)) {
+                if (!_clock.valid()) {
+                    log_warn("Motion sync: Starting before the clocks are synchronized");
+                }
+                _start_us      = _clock.valid() ? _clock.to_local(msg.leader_us) : getMicros();
+                _start_pending = true;
+            }
+            break;
+        }
+        case MsgType::Segment: {
+            Segment mark;
+            if (_role == FOLLOWER && decoder.get(mark)) {
+                align(mark);
+            }
+            break;
+        }
+        case MsgType::Realtime: {
+            Realtime msg;
+            if (_role == FOLLOWER && decoder.get(msg)) {
+                execute_realtime_command(Cmd(msg.cmd), allChannels);
+            }
+            break;
+        }
+        case MsgType::Stop: {
+            SyncProtocol::Stop msg;
+            if (_role == FOLLOWER && decoder.get(msg)) {
+                // A reset stops any motion here.  An alarm that is already
+                // active has stopped it, and the leader often sends a Stop for
+                // both the reset and the alarm it causes.
+                if (!_stop_pending && !state_is(State::Alarm) && !state_is(State::Critical) && !state_is(State::ConfigAlarm)) {
+                    log_info("Motion sync: Leader stopped, alarm " << int(msg.alarm));
+                    _stop_pending = true;
+                    protocol_send_event(&rtResetEvent);
+                }
+            }
+            break;
+        }
+    }
+}
+
+// Compares when the leader started a segment with when this controller
+// started, or will start, the same segment, and trims the step timer
+void MotionSync::align(const Segment& mark) {
+    if (!state_is(State::Cycle) || !_clock.valid()) {
+        return;
+    }
+    uint32_t number, us;
+    Stepping::segmentTime(number, us);
+    int32_t ahead = int32_t(mark.count - (number - _segment_base));
+    if (std::abs(ahead) > max_mark_skew) {
+        return;
+    }
+    int32_t lag = int32_t(us + ahead * int32_t(segment_us) - _clock.to_local(mark.leader_us));
+    Stepping::setTrim(_aligner.update(lag));
+}
+
+// Leader: sends a line that the planner accepted
+void MotionSync::block(float* target, plan_line_data_t* pl_data) {
+    if (_role != LEADER || pl_data->is_jog) {
+        return;
+    }
+    Block block;
+    block.seq           = _seq++;
+    block.feed_rate     = pl_data->feed_rate;
+    block.spindle_speed = pl_data->spindle_speed;
+    block.motion        = motion_bits(pl_data->motion);
+    block.spindle       = uint8_t(pl_data->spindle);
+    block.coolant       = coolant_bits(pl_data->coolant);
+    block.line_number   = pl_data->line_number;
+    block.n_axis        = Axes::_numberAxis;
+    for (axis_t axis = X_AXIS; axis < Axes::_numberAxis; axis++) {
+        block.target[axis] = target[axis];
+    }
+    send(encode(block));
+}
+
+// Both: called as a cycle starts.  The leader tells the follower when to
+// start, and returns false so that the steppers wait for begin().
+bool MotionSync::start() {
+    if (_role == LEADER) {
+        _start_us      = getMicros() + _start_delay_ms * 1000;
+        _start_queued  = false;
+        _start_pending = true;
+        send(encode(SyncProtocol::Start { _start_us }));
+        return false;
+    }
+    _aligner.reset();
+    Stepping::setTrim(0);
+    uint32_t us;
+    Stepping::segmentTime(_segment_base, us);
+    return true;
+}
+
+// Leader: runs in the protocol task at the start time.  A hold that came
+// in while waiting is run by the steppers, and a reset or alarm drops the
+// start.
+void MotionSync::begin() {
+    if (!_start_pending || int32_t(getMicros() - _start_us) < 0) {
+        return;  // From a start that was dropped or replaced
+    }
+    _start_pending = false;
+    if (state_is(State::Cycle) || state_is(State::Hold)) {
+        uint32_t us;
+        Stepping::segmentTime(_segment_base, us);
+        Stepper::wake_up();
+    }
+}
+
+// Leader: repeats a feed hold, safety door or override.  Cycle start goes as
+// a Start message, from start().
+void MotionSync::realtime(Cmd command) {
+    if (_role == LEADER) {
+        send(encode(Realtime { uint8_t(command) }));
+    }
+}
+
+// Both: called for each reset, and for each alarm.  The leader tells the
+// follower to stop.  The follower drops the blocks it has not planned yet
+// and any pending start.
+void MotionSync::stop(ExecAlarm alarm) {
+    if (_role == LEADER) {
+        _start_pending = false;
+        send(encode(SyncProtocol::Stop { uint8_t(alarm) }));
+        return;
+    }
+    flush();
+    if (alarm == ExecAlarm::None) {
+        _stop_pending = false;  // The reset that a Stop asked for has run
+    } else {
+        _leader_alarm = _stop_pending;
+    }
+}
+
+// Follower: moves blocks from the queue to the planner while a cycle runs
+void MotionSync::poll() {
+    if (_role != FOLLOWER || !_blocks) {
+        return;
+    }
+    if (_start_pending && int32_t(getMicros() - _start_us) >= 0) {
+        _start_pending = false;
+        // The leader has been unlocked, so an alarm that it caused here is over
+        if (_leader_alarm && state_is(State::Alarm)) {
+            log_info("Motion sync: Leader started, clearing the alarm");
+            set_state(State::Idle);
+        }
+        _leader_alarm = false;
+        _gate_open    = true;
+        feed();
+        protocol_send_event(&cycleStartEvent);
+        return;
+    }
+    if (_gate_open) {
+        feed();
+        if (state_is(State::Idle) && !plan_get_current_block() && !uxQueueMessagesWaiting(_blocks)) {
+            close();
+        }
+    }
+}
+
+void MotionSync::feed() {
+    Block block;
+    while (!plan_check_full_buffer() && xQueueReceive(_blocks, &block, 0)) {
+        // The leader numbers blocks from 0 after a restart
+        if (block.seq != _seq && block.seq != 0) {
+            log_error("Motion sync: Expected block " << _seq << " got " << block.seq);
+            flush();
+            send_alarm(ExecAlarm::AbortCycle);
+            return;
+        }
+        _seq = block.seq + 1;
+
+        if (block.n_axis != Axes::_numberAxis) {
+            log_error("Motion sync: The leader has " << block.n_axis << " axes");
+            continue;
+        }
+        float target[MAX_N_AXIS] = {};
+        for (axis_t axis = X_AXIS; axis < block.n_axis; axis++) {
+            target[axis] = block.target[axis];
+        }
+
+        plan_line_data_t pl_data      = {};
+        pl_data.feed_rate             = block.feed_rate;
+        pl_data.spindle_speed         = block.spindle_speed;
+        pl_data.motion.rapidMotion    = block.motion & 1;
+        pl_data.motion.noFeedOverride = (block.motion >> 2) & 1;
+        pl_data.motion.inverseTime    = (block.motion >> 3) & 1;
+        pl_data.spindle               = SpindleState(block.spindle);
+        pl_data.coolant.Mist          = block.coolant & 1;
+        pl_data.coolant.Flood         = (block.coolant >> 1) & 1;
+        pl_data.line_number           = block.line_number;
+        pl_data.limits_checked        = true;  // The leader checked them
+        plan_buffer_line(target, &pl_data);
+    }
+}
+
+// Drops the blocks that are not planned yet and any pending start
+void MotionSync::flush() {
+    if (_blocks) {
+        xQueueReset(_blocks);
+    }
+    _start_pending = false;
+    close();
+}
+
+// The cycle is over, so the gcode position follows the planned moves
+void MotionSync::close() {
+    _gate_open = false;
+    Stepping::setTrim(0);
+    gc_sync_position();
+}
+
+void MotionSync::validate() {
+    Assert(_uart_num != -1, "Motion sync: needs uart_num");
+}
+
+void MotionSync::group(Configuration::HandlerBase& handler) {
+    handler.item("role", _role, roleTypes);
+    handler.item("uart_num", _uart_num);
+    handler.item("start_delay_ms", _start_delay_ms, 5, 1000);
+    handler.item("sync_ms", _sync_ms, 20, 1000);
+    handler.item("max_trim_ppm", _aligner._max_trim, 0, 20000);
+}
+
+void motion_sync_block(float* target, plan_line_data_t* pl_data) {
+    if (motion_sync) {
+        motion_sync->block(target, pl_data);
+    }
+}
+
+bool motion_sync_start() {
+    return !motion_sync || motion_sync->start();
+}
+
+void motion_sync_override(Cmd command) {
+    if (motion_sync && command >= Cmd::FeedOvrReset && command <= Cmd::CoolantMistOvrToggle) {
+        motion_sync->realtime(command);
+    }
+}
+
+void motion_sync_realtime(Cmd command) {
+    if (motion_sync) {
+        motion_sync->realtime(command);
+    }
+}
+
+void motion_sync_stop(ExecAlarm alarm) {
+    if (motion_sync) {
+        motion_sync->stop(alarm);
+    }
+}
+
+bool motion_sync_follower() {
+    return motion_sync && motion_sync->follower();
+}
+
+void motion_sync_poll() {
+    if (motion_sync) {
+        motion_sync->poll();
+    }
+}
+
+// Configuration registration
+namespace {
+    ConfigurableModuleFactory::InstanceBuilder<MotionSync> registration("motion_sync");
+}
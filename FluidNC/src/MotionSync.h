@@ -0,0 +1,115 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include "Config.h"
+#include "Module.h"
+#include "EnumItem.h"
+#include "Alarm.h"        // ExecAlarm
+#include "Planner.h"      // plan_line_data_t
+#include "RealtimeCmd.h"  // Cmd
+#include "SyncProtocol.h"
+#include "Uart.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <mutex>
+
+// Motion sync runs two controllers as one machine, for machines with more
+// motors than one controller can drive.  Both have the same axes section,
+// but each has motors only on the axes it drives.  G-code goes to the
+// leader, which sends every block it plans to the follower over a UART.
+// The follower plans the same blocks, starts each cycle at the time the
+// leader gives, and trims its step timer so that its segments stay lined
+// up with the leader's.  Feed holds, safety door, resets, alarms and
+// overrides on the leader are repeated on the follower.
+class MotionSync : public ConfigurableModule {
+public:
+    enum Role : uint32_t {
+        LEADER,
+        FOLLOWER,
+    };
+
+    MotionSync(const char* name) : ConfigurableModule(name) {}
+
+    MotionSync(const MotionSync&)            = delete;
+    MotionSync(MotionSync&&)                 = delete;
+    MotionSync& operator=(const MotionSync&) = delete;
+    MotionSync& operator=(MotionSync&&)      = delete;
+
+    virtual ~MotionSync() = default;
+
+    void init() override;
+
+    // Hooks into the protocol loop, through the motion_sync_* functions
+    void block(float* target, plan_line_data_t* pl_data);
+    bool start();
+    void begin();
+    void realtime(Cmd command);
+    void stop(ExecAlarm alarm);
+    void poll();
+
+    bool follower() { return _role == FOLLOWER; }
+
+    // Configuration handlers:
+    void validate() override;
+    void group(Configuration::HandlerBase& handler) override;
+
+private:
+    static void motion_sync_task(void* arg);
+
+    void send(SyncProtocol::Writer frame);
+    void receive(const SyncProtocol::Decoder& decoder);
+    void align(const SyncProtocol::Segment& mark);
+    void feed();
+    void flush();
+    void close();
+
+    uint32_t _role           = LEADER;
+    int32_t  _uart_num       = -1;
+    uint32_t _start_delay_ms = 30;   // How far ahead the leader schedules a cycle start
+    uint32_t _sync_ms        = 100;  // Time between Ping or Segment messages
+
+    SyncProtocol::SegmentAligner _aligner;
+    SyncProtocol::ClockSync      _clock;
+
+    Uart*         _uart   = nullptr;
+    TaskHandle_t  _task   = nullptr;
+    QueueHandle_t _blocks = nullptr;  // Blocks from the leader, waiting for the planner
+    std::mutex    _write_mutex;
+
+    uint32_t _seq          = 0;      // Sequence number of the next block
+    uint32_t _segment_base = 0;      // Stepping segment number when the cycle started
+    bool     _gate_open    = false;  // Follower blocks go to the planner
+
+    volatile bool     _start_pending = false;
+    volatile bool     _start_queued  = false;  // Leader: leaderStartEvent is sent
+    volatile uint32_t _start_us      = 0;      // Local time of the pending start
+
+    volatile bool _stop_pending = false;  // A Stop from the leader waits for the protocol task
+    bool          _leader_alarm = false;  // The current alarm came from a Stop
+};
+
+// Called from the planner for each planned line
+void motion_sync_block(float* target, plan_line_data_t* pl_data);
+
+// Called just before the steppers start a cycle.  False if they must wait
+// for the leader's start time, when an event starts them.
+bool motion_sync_start();
+
+// Called for each realtime command character, to repeat overrides
+void motion_sync_override(Cmd command);
+
+// Called when a feed hold or safety door event runs
+void motion_sync_realtime(Cmd command);
+
+// Called when a reset or alarm event runs, with ExecAlarm::None for a reset
+void motion_sync_stop(ExecAlarm alarm);
+
+// True if the blocks come from a leader, which also says when to start them
+bool motion_sync_follower();
+
+// Called from the protocol loop
+void motion_sync_poll();
@@ -24,8 +24,7 @@
 #include <cmath>
 
 namespace MotorDrivers {
-    Uart*                    Dynamixel2::_uart  = nullptr;
-    TimerHandle_t            Dynamixel2::_timer = nullptr;
+    Uart*                    Dynamixel2::_uart = nullptr;
     std::vector<Dynamixel2*> Dynamixel2::_instances;
     bool                     Dynamixel2::_has_errors = false;
 
@@ -143,7 +142,7 @@ namespace MotorDrivers {
         add_uint8(_id);  // ID of the servo
 
         // map motor steps to the servo range
-        steps_t  steps    = get_axis_steps(_axis);
+        steps_t  steps    = target_steps(_axis, _timer_ms);
         uint32_t position = mapConstrain(steps, _min_steps, _max_steps, _countMin, _countMax);
         add_uint32(position);
     }
@@ -163,7 +162,7 @@ namespace MotorDrivers {
         }
         finish_message();
     }
-    // This is called from the update timer that is created by schedule_update()
+    // This is called by the servo scheduler, via schedule_update().
     // It is only called from the one Dynamixel instance that starts the uart.
     void Dynamixel2::update() {
         update_all();
@@ -51,8 +51,6 @@ namespace MotorDrivers {
 
         static uint16_t dxl_update_crc(uint16_t crc_accum, uint8_t* data_blk_ptr, uint8_t data_blk_size);
 
-        static TimerHandle_t _timer;
-
         static std::vector<Dynamixel2*> _instances;
 
         axis_t _axis;
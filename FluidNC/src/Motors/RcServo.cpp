@@ -99,7 +99,7 @@ namespace MotorDrivers {
  
         read_settings();  
 
-        steps_t steps = get_axis_steps(_axis);  // get the axis machine position in mm
+        steps_t steps = target_steps(_axis, _timer_ms);  // get the axis machine position in steps
 
         // determine the pulse length
         uint32_t pulse_count = mapConstrain(steps, _min_steps, _max_steps, (int32_t)_min_pulse_cnt, (int32_t)_max_pulse_cnt);
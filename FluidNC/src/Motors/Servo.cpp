@@ -17,28 +17,90 @@
 
 #include "Servo.h"
 #include "Machine/MachineConfig.h"
+#include "Stepper.h"  // get_realtime_rate()
 
-#include <atomic>
+#include <numeric>  // std::gcd
+#include <cmath>
 
 namespace MotorDrivers {
-    void Servo::update_servo(TimerHandle_t timer) {
-        Servo* servo = static_cast<Servo*>(pvTimerGetTimerID(timer));
-        servo->update();
+    Servo*                Servo::_servos[MAX_SERVOS];
+    std::atomic<size_t>   Servo::_n_servos { 0 };
+    std::atomic<uint32_t> Servo::_tick_ms { 0 };
+    TaskHandle_t          Servo::_task = nullptr;
+    steps_t               Servo::_last_steps[MAX_N_AXIS];
+    float                 Servo::_steps_per_ms[MAX_N_AXIS];
+
+    void Servo::measure_velocities(uint32_t elapsed_ms) {
+        // Only extrapolate while steps are being generated, so servos do not
+        // overshoot by a tick when motion stops
+        bool moving = Stepper::get_realtime_rate() != 0.0f && elapsed_ms;
+        for (axis_t axis = X_AXIS; axis < Axes::_numberAxis; axis++) {
+            steps_t steps       = get_axis_steps(axis);
+            _steps_per_ms[axis] = moving ? float(steps - _last_steps[axis]) / elapsed_ms : 0.0f;
+            _last_steps[axis]   = steps;
+        }
+    }
+
+    steps_t Servo::target_steps(axis_t axis, uint32_t lead_ms) {
+        return get_axis_steps(axis) + lroundf(_steps_per_ms[axis] * lead_ms);
+    }
+
+    void Servo::scheduler_task(void* arg) {
+        TickType_t last_wake = xTaskGetTickCount();
+        uint32_t   last_ms   = get_ms();
+        while (true) {
+            uint32_t tick_ms = _tick_ms;
+            vTaskDelayUntil(&last_wake, tick_ms / portTICK_PERIOD_MS);
+
+            uint32_t now = get_ms();
+            measure_velocities(now - last_ms);
+            last_ms = now;
+
+            // Update every servo that is due in one pass
+            size_t n_servos = _n_servos;
+            for (size_t i = 0; i < n_servos; i++) {
+                auto servo = _servos[i];
+                if (int32_t(now - servo->_next_ms) >= 0) {
+                    servo->_next_ms += servo->_interval_ms;
+                    if (int32_t(now - servo->_next_ms) >= 0) {
+                        // Fell behind, e.g. after a long bus transaction; do not try to catch up
+                        servo->_next_ms = now + servo->_interval_ms;
+                    }
+                    servo->update();
+                }
+            }
+        }
     }
 
     void Servo::schedule_update(Servo* object, uint32_t interval) {
-        auto timer = xTimerCreate("",
-                                  interval,
-                                  true,  // auto reload
-                                  (void*)object,
-                                  update_servo);
-        if (!timer) {
-            log_error("Failed to create timer for " << object->name());
+        if (interval == 0) {
+            interval = 1;
+        }
+        size_t n = _n_servos;
+        if (n == MAX_SERVOS) {
+            log_error("Too many servos to schedule " << object->name());
             return;
         }
-        if (xTimerStart(timer, 0) == pdFAIL) {
-            log_error("Failed to start timer for " << object->name());
+        object->_interval_ms = interval;
+        object->_next_ms     = get_ms() + interval;
+        _servos[n]           = object;
+        _n_servos            = n + 1;
+        _tick_ms             = std::gcd(_tick_ms.load(), interval);
+
+        if (!_task) {
+            xTaskCreatePinnedToCore(scheduler_task,     // task
+                                    "servoTaskHandle",  // name for task
+                                    4096,               // size of task stack
+                                    nullptr,            // parameters
+                                    2,                  // priority
+                                    &_task,
+                                    SUPPORT_TASK_CORE  // core
+            );
+            if (!_task) {
+                log_error("Failed to create servo scheduler task");
+                return;
+            }
         }
-        log_info("    Update timer for " << object->name() << " at " << interval << " ms");
+        log_info("    Update " << object->name() << " every " << interval << " ms, servo tick " << _tick_ms.load() << " ms");
     }
 }
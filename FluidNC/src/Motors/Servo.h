@@ -3,7 +3,7 @@
 
 #pragma once
 #include <freertos/FreeRTOS.h>
-#include <freertos/timers.h>  // TimerHandle_t
+#include <freertos/task.h>  // TaskHandle_t
 
 /*
     This is a base class for servo-type motors - ones that autonomously
@@ -12,6 +12,10 @@
 */
 
 #include "MotorDriver.h"
+#include "Machine/Axis.h"  // MAX_MOTORS_PER_AXIS
+#include "System.h"  // steps_t
+
+#include <atomic>
 
 namespace MotorDrivers {
     class Servo : public MotorDriver {
@@ -24,7 +28,34 @@ namespace MotorDrivers {
         bool can_self_home() override { return true; }
 
     protected:
-        static void update_servo(TimerHandle_t timer);
+        // All servos are updated from one scheduler task, which ticks at the
+        // greatest common divisor of the requested intervals and calls each
+        // servo's update() when its interval is due.  Servos that share a bus
+        // should schedule one object that writes all of them in one message.
         static void schedule_update(Servo* object, uint32_t interval);
+
+        // The axis position, in steps, that a servo should command now.  It is
+        // extrapolated from the recent axis velocity by lead_ms, normally the
+        // servo's update interval, so the servo does not trail the motion by
+        // the time it takes to get there.
+        static steps_t target_steps(axis_t axis, uint32_t lead_ms);
+
+    private:
+        static const size_t MAX_SERVOS = MAX_N_AXIS * Machine::Axis::MAX_MOTORS_PER_AXIS;
+
+        static Servo*                _servos[MAX_SERVOS];
+        static std::atomic<size_t>   _n_servos;
+        static std::atomic<uint32_t> _tick_ms;
+        static TaskHandle_t          _task;
+
+        // Axis velocities measured on each scheduler tick
+        static steps_t _last_steps[MAX_N_AXIS];
+        static float   _steps_per_ms[MAX_N_AXIS];
+
+        static void scheduler_task(void* arg);
+        static void measure_velocities(uint32_t elapsed_ms);
+
+        uint32_t _interval_ms = 0;
+        uint32_t _next_ms     = 0;
     };
 }
@@ -81,7 +81,7 @@ namespace MotorDrivers {
             return;
         }
 
-        float mpos = steps_to_motor_pos(get_axis_steps(_axis), _axis);  // get the axis machine position in mm
+        float mpos = steps_to_motor_pos(target_steps(_axis, _update_rate_ms), _axis);  // get the axis machine position in mm
 
         _dir_invert ? is_solenoid_on = (mpos < 0.0) : is_solenoid_on = (mpos > 0.0);
 
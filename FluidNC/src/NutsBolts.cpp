@@ -4,7 +4,8 @@
 // Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
 
 #include "Machine/MachineConfig.h"
-#include "Protocol.h"  // protocol_exec_rt_system
+#include "Protocol.h"      // protocol_exec_rt_system
+#include "TaskProfiler.h"  // ProfileWait
 
 #include <cstring>
 #include <cstdint>
@@ -23,6 +24,7 @@ void delay_ms(uint32_t ms) {
 
 // Non-blocking delay function used for general operation and suspend features.
 bool dwell_ms(uint32_t milliseconds, DwellMode mode) {
+    ProfileWait wait;
     while (milliseconds--) {
         if (mode == DwellMode::Dwell) {
             protocol_execute_realtime();
@@ -126,6 +126,19 @@ const std::array<const std::string, 6> unsupported_sys = {
 
 std::map<std::string, float> global_named_params;
 
+// Global named parameters that will be set when they are first read
+static std::map<std::string, std::function<bool(float&)>> pending_named_params;
+
+static std::string canonical_param_name(const std::string& name) {
+    std::string canonical_name(name);
+    std::transform(canonical_name.begin(), canonical_name.end(), canonical_name.begin(), ::toupper);
+    return canonical_name;
+}
+
+static bool global_named_param_exists(const std::string& canonical_name) {
+    return global_named_params.count(canonical_name) != 0 || pending_named_params.count(canonical_name) != 0;
+}
+
 bool ngc_param_is_rw(ngc_param_id_t id) {
     return true;
 }
@@ -425,9 +438,7 @@ bool named_param_exists(std::string& name) {
             return true;
         }
         // Convert to uppercase for global named param lookup
-        std::string canonical_name(search);
-        std::transform(canonical_name.begin(), canonical_name.end(), canonical_name.begin(), ::toupper);
-        return global_named_params.count(canonical_name) != 0;
+        return global_named_param_exists(canonical_param_name(search));
     }
     // If the name does not start with _ it is local so we look for a job-local parameter
     // If no job is active, we treat the interpretive context like a local context
@@ -436,15 +447,24 @@ bool named_param_exists(std::string& name) {
     }
 #endif
     // Convert to uppercase for global named param lookup
-    std::string canonical_name(search);
-    std::transform(canonical_name.begin(), canonical_name.end(), canonical_name.begin(), ::toupper);
-    return global_named_params.count(canonical_name) != 0;
+    return global_named_param_exists(canonical_param_name(search));
 }
 
 bool get_global_named_param(const std::string& name, float& value) {
     // Convert parameter name to uppercase for canonical form lookup
-    std::string canonical_name(name);
-    std::transform(canonical_name.begin(), canonical_name.end(), canonical_name.begin(), ::toupper);
+    std::string canonical_name = canonical_param_name(name);
+
+    auto pending = pending_named_params.find(canonical_name);
+    if (pending != pending_named_params.end()) {
+        auto resolve = std::move(pending->second);
+        pending_named_params.erase(pending);
+        if (!resolve(value)) {
+            return false;
+        }
+        global_named_params[canonical_name] = value;
+        return true;
+    }
+
     auto it = global_named_params.find(canonical_name);
     if (it == global_named_params.end()) {
         return false;
@@ -615,12 +635,16 @@ bool get_param_ref(const char* line, size_t& pos, param_ref_t& param_ref) {
 
 bool set_named_param(const char* name, float value) {
     // Convert parameter name to uppercase for canonical form
-    std::string canonical_name(name);
-    std::transform(canonical_name.begin(), canonical_name.end(), canonical_name.begin(), ::toupper);
+    std::string canonical_name = canonical_param_name(name);
+    pending_named_params.erase(canonical_name);
     global_named_params[canonical_name] = value;
     return true;
 }
 
+void set_named_param_pending(const char* name, std::function<bool(float&)> resolve) {
+    pending_named_params[canonical_param_name(name)] = std::move(resolve);
+}
+
 bool set_numbered_param(ngc_param_id_t id, float value) {
 #ifndef UNIT_TEST
     axis_t axis;
@@ -5,6 +5,7 @@
 
 #include <stddef.h>
 #include <string>
+#include <functional>
 
 #include <cstdint>
 // TODO - make ngc_param_id_t an enum, give names to numbered parameters where
@@ -19,6 +20,12 @@ bool named_param_exists(std::string& name);
 bool set_named_param(const char* name, float value);
 bool set_numbered_param(ngc_param_id_t, float value);
 
+// Marks a global named parameter whose value is still being produced, for example by an
+// asynchronous $HTTP/Command.  The first read of the parameter calls resolve, which waits
+// for the value and stores it in value; if resolve returns false, the read fails.
+// Setting the parameter before it is read cancels the pending value.
+void set_named_param_pending(const char* name, std::function<bool(float&)> resolve);
+
 // Forward declarations
 class Channel;
 
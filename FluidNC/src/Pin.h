@@ -7,6 +7,7 @@
 #include "Pins/PinDetail.h"
 #include "Pins/VoidPinDetail.h"
 #include "Pins/ErrorPinDetail.h"
+#include "Pins/ResolvedPin.h"
 
 #include <cstdint>
 #include <string>
@@ -81,6 +82,10 @@ public:
     static const int DEASSERTING = 0x11;
 
     static Pin  create(std::string_view str);
+#ifdef UNIT_TEST
+    // Lets tests drive code through a PinDetail of their own
+    static Pin wrap(Pins::PinDetail* detail) { return Pin(detail); }
+#endif
     static bool validate(const char* str);
 
     // We delete the copy constructor, and implement the move constructor. The move constructor is required to support
@@ -127,6 +132,10 @@ public:
 
     inline bool read() const { return _detail->read() != 0; }
 
+    // A handle that writes the pin without a virtual call, for the stepping
+    // engine and other hot paths.  Call it after setAttr().
+    inline Pins::ResolvedPin resolve() const { return _detail->resolve(); }
+
     inline void setAttr(Attr attributes, uint32_t frequency = 0) const { _detail->setAttr(attributes, frequency); }
 
     inline Attr getAttr() const { return _detail->getAttr(); }
@@ -67,6 +67,16 @@ namespace Pins {
             } else if (opt.is("ds3")) {
                 setDriveStrength(3, PinAttributes::DS3);
                 _name += ":ds3";
+            } else if (opt.is("filter")) {
+                auto samples = opt.iValue();
+                if (!_capabilities.has(PinCapabilities::Input)) {
+                    log_config_error(name() << " does not support :filter attribute");
+                } else if (samples < 2 || samples > 255) {
+                    log_config_error(name() << " :filter must be between 2 and 255 samples");
+                } else {
+                    _filterSamples = samples;
+                    _name += ":filter=" + std::to_string(samples);
+                }
             } else {
                 Assert(false, "Bad GPIO option passed to pin %d: %.*s", int(index), static_cast<int>(opt().length()), opt().data());
             }
@@ -160,6 +170,9 @@ namespace Pins {
 
     void GPIOPinDetail::registerEvent(InputPin* obj) {
         gpio_set_event(_index, reinterpret_cast<void*>(obj), _attributes.has(Pin::Attr::ActiveLow));
+        if (_filterSamples) {
+            gpio_set_filter(_index, _filterSamples);
+        }
     }
 
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "PinDetail.h"
+#include "ResolvedPin.h"
 #include "Driver/PwmPin.h"
 
 namespace Pins {
@@ -17,10 +18,13 @@ namespace Pins {
 
         bool _lastWrittenValue = false;
 
-        PwmPin* _pwm;
+        PwmPin* _pwm = nullptr;
 
         int8_t _driveStrength = -1;
 
+        // Consecutive samples needed to accept an input change; 0 means unfiltered
+        uint32_t _filterSamples = 0;
+
         void setDriveStrength(uint8_t n, PinAttributes attr);
 
     public:
@@ -39,6 +43,8 @@ namespace Pins {
 
         int8_t driveStrength() override { return _driveStrength; }
 
+        ResolvedPin resolve() override { return ResolvedPin::gpio(_index, _inverted, _pwm); }
+
         bool canStep() override { return true; }
 
         void registerEvent(InputPin* obj) override;
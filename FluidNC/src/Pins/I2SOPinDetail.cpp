@@ -6,7 +6,72 @@
 #    include "I2SOPinDetail.h"
 #    include "Driver/i2s_out.h"  // i2s_out_write() etc
 
+#    include <freertos/FreeRTOS.h>
+#    include <freertos/task.h>
+
 namespace Pins {
+    // The open batch, the task that opened it, and the nesting depth
+    static i2s_out_batch_t batch;
+    static TaskHandle_t    batch_owner = nullptr;
+    static uint32_t        batch_depth = 0;
+    static bool            batch_sync  = false;  // A synchronous write is in the batch
+    static portMUX_TYPE    batch_mux   = portMUX_INITIALIZER_UNLOCKED;
+
+    // Returns true if the write was added to the batch of the current task
+    static bool IRAM_ATTR batch_write(pinnum_t index, bool level, bool sync) {
+        if (batch_depth == 0 || xPortInIsrContext() || xTaskGetCurrentTaskHandle() != batch_owner) {
+            return false;
+        }
+        i2s_out_batch_write(&batch, index, level);
+        batch_sync = batch_sync || sync;
+        return true;
+    }
+
+    IRAM_ATTR I2SOBatch::I2SOBatch() {
+        if (xPortInIsrContext()) {
+            return;
+        }
+        auto task = xTaskGetCurrentTaskHandle();
+        portENTER_CRITICAL(&batch_mux);
+        if (batch_depth == 0) {
+            i2s_out_batch_begin(&batch);
+            batch_sync  = false;
+            batch_owner = task;
+        }
+        if (batch_owner == task) {
+            ++batch_depth;
+            _open = true;
+        }
+        portEXIT_CRITICAL(&batch_mux);
+    }
+
+    IRAM_ATTR I2SOBatch::~I2SOBatch() {
+        if (!_open) {
+            return;
+        }
+        // Take the batch and release ownership in one step, so another task
+        // cannot start a new batch over writes that are not yet committed
+        i2s_out_batch_t commit = {};
+        bool            sync   = false;
+        portENTER_CRITICAL(&batch_mux);
+        bool last = --batch_depth == 0;
+        if (last) {
+            commit      = batch;
+            sync        = batch_sync;
+            batch_owner = nullptr;
+            i2s_out_batch_begin(&batch);
+            batch_sync = false;
+        }
+        portEXIT_CRITICAL(&batch_mux);
+        if (!last) {
+            return;
+        }
+        i2s_out_batch_commit(&commit);
+        if (sync) {
+            i2s_out_delay();
+        }
+    }
+
     std::vector<bool> I2SOPinDetail::_claimed(nI2SOPins, false);
 
     I2SOPinDetail::I2SOPinDetail(pinnum_t index, const PinOptionsParser& options) :
@@ -43,7 +108,9 @@ namespace Pins {
     void IRAM_ATTR I2SOPinDetail::write(bool high) {
         if (high != _lastWrittenValue) {
             _lastWrittenValue = high;
-            i2s_out_write(_index, _inverted ^ (bool)high);
+            if (!batch_write(_index, _inverted ^ (bool)high, false)) {
+                i2s_out_write(_index, _inverted ^ (bool)high);
+            }
         }
     }
 
@@ -53,8 +120,10 @@ namespace Pins {
         if (high != _lastWrittenValue) {
             _lastWrittenValue = high;
 
-            i2s_out_write(_index, _inverted ^ (bool)high);
-            i2s_out_delay();
+            if (!batch_write(_index, _inverted ^ (bool)high, true)) {
+                i2s_out_write(_index, _inverted ^ (bool)high);
+                i2s_out_delay();
+            }
         }
     }
 
@@ -4,8 +4,34 @@
 #pragma once
 
 #include "Config.h"
+
+namespace Pins {
+    // While one of these is in scope, the I2SO writes made by the task that
+    // created it are collected, and are sent together when it goes out of
+    // scope, so related outputs change in the same I2S frame.  Batches nest;
+    // the outermost one commits.  Writes from other tasks and from ISRs go
+    // out immediately as usual.
+    class I2SOBatch {
+    public:
+#if MAX_N_I2SO
+        I2SOBatch();
+        ~I2SOBatch();
+
+    private:
+        bool _open = false;
+
+    public:
+#else
+        I2SOBatch() {}
+#endif
+        I2SOBatch(const I2SOBatch&)            = delete;
+        I2SOBatch& operator=(const I2SOBatch&) = delete;
+    };
+}
+
 #if MAX_N_I2SO
 #    include "PinDetail.h"
+#    include "ResolvedPin.h"
 
 namespace Pins {
     class I2SOPinDetail : public PinDetail {
@@ -31,6 +57,8 @@ namespace Pins {
 
         bool canStep() override { return true; }
 
+        ResolvedPin resolve() override { return ResolvedPin::i2so(_index, _inverted); }
+
         ~I2SOPinDetail() override { _claimed[_index] = false; }
     };
 }
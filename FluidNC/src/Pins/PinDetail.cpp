@@ -2,6 +2,7 @@
 // Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
 
 #include "PinDetail.h"
+#include "ResolvedPin.h"
 
 namespace Pins {
     // cppcheck-suppress unusedFunction
@@ -13,4 +14,8 @@ namespace Pins {
     void IRAM_ATTR PinDetail::synchronousWrite(bool high) {
         write(high);
     }
+
+    ResolvedPin PinDetail::resolve() {
+        return ResolvedPin(this);
+    }
 }
@@ -15,6 +15,7 @@
 class InputPin;
 
 namespace Pins {
+    class ResolvedPin;
 
     // Implementation details of pins.
     class PinDetail {
@@ -46,6 +47,9 @@ namespace Pins {
 
         virtual void registerEvent(InputPin* obj);
 
+        // Binds the pin to a non-virtual handle for hot paths; see ResolvedPin.h
+        virtual ResolvedPin resolve();
+
         const char* name() { return _name.c_str(); }
 
         inline pinnum_t number() const { return _index; }
@@ -0,0 +1,32 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "ResolvedPin.h"
+
+#include <utility>
+
+namespace Pins {
+    ResolvedPin ResolvedPin::gpio(pinnum_t index, bool inverted, PwmPin* pwm) {
+        ResolvedPin pin;
+        pin._index    = index;
+        pin._inverted = inverted;
+        pin._pwm      = pwm;
+        if (gpio_output_regs(index, &pin._on_reg, &pin._off_reg, &pin._mask)) {
+            if (inverted) {
+                std::swap(pin._on_reg, pin._off_reg);
+            }
+            pin._kind = Kind::GpioReg;
+        } else {
+            pin._kind = Kind::Gpio;
+        }
+        return pin;
+    }
+
+    ResolvedPin ResolvedPin::i2so(pinnum_t index, bool inverted) {
+        ResolvedPin pin;
+        pin._kind     = Kind::I2SO;
+        pin._index    = index;
+        pin._inverted = inverted;
+        return pin;
+    }
+}
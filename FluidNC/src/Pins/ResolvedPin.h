@@ -0,0 +1,120 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include "Config.h"
+#include "PinDetail.h"
+#include "Driver/fluidnc_gpio.h"
+#include "Driver/PwmPin.h"
+#if MAX_N_I2SO
+#    include "Driver/i2s_out.h"
+#endif
+
+#include <cstdint>
+
+namespace Pins {
+    // A pin bound at configuration time to the cheapest way of driving it.
+    // Pin::write() makes a virtual PinDetail call and applies the inversion
+    // on every call.  A ResolvedPin does the operation inline: a GPIO output
+    // is a single store to the set or clear register, with active-low folded
+    // into which register is which, and an I2SO output is a shadow bit update.
+    // Pin types without a fast path fall back to the PinDetail.
+    //
+    // Get one with Pin::resolve() after setAttr(), which creates the PWM
+    // channel.  The handle does not remember the last value written, so a
+    // pin should be written either through its handle or through the Pin.
+    class ResolvedPin {
+    public:
+        enum class Kind : uint8_t {
+            None,     // Undefined pin; does nothing
+            GpioReg,  // GPIO with direct register access
+            Gpio,     // GPIO through the gpio driver
+            I2SO,     // I2S shift register output
+            Detail,   // Anything else, through the PinDetail
+        };
+
+        ResolvedPin() = default;
+        explicit ResolvedPin(PinDetail* detail) : _kind(Kind::Detail), _detail(detail) {}
+
+        static ResolvedPin gpio(pinnum_t index, bool inverted, PwmPin* pwm);
+        static ResolvedPin i2so(pinnum_t index, bool inverted);
+
+        Kind kind() const { return _kind; }
+
+        inline void IRAM_ATTR write(bool on) const {
+            switch (_kind) {
+                case Kind::GpioReg:
+                    *(on ? _on_reg : _off_reg) = _mask;
+                    break;
+                case Kind::Gpio:
+                    gpio_write(_index, on ^ _inverted);
+                    break;
+#if MAX_N_I2SO
+                case Kind::I2SO:
+                    i2s_out_write(_index, on ^ _inverted);
+                    break;
+#endif
+                case Kind::Detail:
+                    _detail->write(on);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // For I2SO, waits for the shift register when the level changes
+        inline void IRAM_ATTR synchronousWrite(bool on) const {
+            switch (_kind) {
+#if MAX_N_I2SO
+                case Kind::I2SO:
+                    if (i2s_out_read(_index) != uint8_t(on ^ _inverted)) {
+                        i2s_out_write(_index, on ^ _inverted);
+                        i2s_out_delay();
+                    }
+                    break;
+#endif
+                case Kind::Detail:
+                    _detail->synchronousWrite(on);
+                    break;
+                default:
+                    write(on);
+                    break;
+            }
+        }
+
+        inline void IRAM_ATTR setDuty(uint32_t duty) const {
+            if (_pwm) {
+                _pwm->setDuty(duty);
+            } else if (_kind == Kind::Detail) {
+                _detail->setDuty(duty);
+            }
+        }
+
+        inline bool read() const {
+            switch (_kind) {
+                case Kind::GpioReg:
+                case Kind::Gpio:
+                    return gpio_read(_index) ^ _inverted;
+#if MAX_N_I2SO
+                case Kind::I2SO:
+                    return bool(i2s_out_read(_index)) ^ _inverted;
+#endif
+                case Kind::Detail:
+                    return _detail->read();
+                default:
+                    return false;
+            }
+        }
+
+    private:
+        Kind               _kind     = Kind::None;
+        pinnum_t           _index    = INVALID_PINNUM;
+        bool               _inverted = false;
+        volatile uint32_t* _on_reg   = nullptr;
+        volatile uint32_t* _off_reg  = nullptr;
+        uint32_t           _mask     = 0;
+        PwmPin*            _pwm      = nullptr;
+        PinDetail*         _detail   = nullptr;
+    };
+}
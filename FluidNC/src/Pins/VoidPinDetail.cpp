@@ -27,5 +27,8 @@ namespace Pins {
     PinAttributes VoidPinDetail::getAttr() const {
         return PinAttributes::None;
     }
+    ResolvedPin VoidPinDetail::resolve() {
+        return ResolvedPin();
+    }
     VoidPinDetail undefinedPin;
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "PinDetail.h"
+#include "ResolvedPin.h"
 #include "PinOptionsParser.h"
 
 namespace Pins {
@@ -20,6 +21,8 @@ namespace Pins {
         void          setAttr(PinAttributes value, uint32_t frequency) override;
         PinAttributes getAttr() const override;
 
+        ResolvedPin resolve() override;
+
         ~VoidPinDetail() override {}
     };
     extern VoidPinDetail undefinedPin;
@@ -8,23 +8,79 @@
   Planner.cpp - buffers movement commands and manages the acceleration profile plan
 */
 
+// Debug logging while planning would change the motion timing, so it is compiled out; see Logging.h
+#define LOG_HOT_PATH
+
 #include "Planner.h"
 #include "Machine/MachineConfig.h"
+#include "Driver/fluidnc_memory.h"
+#include "MotionSync.h"  // motion_sync_block
 
 #include <cstdlib>  // PSoc Required for labs
 #include <cmath>
-
-static plan_block_t* block_buffer = nullptr;  // A ring buffer for motion instructions
-static uint8_t       block_buffer_tail;       // Index of the block to process now
-static uint8_t       block_buffer_head;       // Index of the next block to be pushed
-static uint8_t       next_buffer_head;        // Index of the next buffer head
-static uint8_t       block_buffer_planned;    // Index of the optimally planned block
+#include <new>  // std::bad_alloc
+
+// The rate limits of a block are read when the block is added, when an override
+// changes, and by the stepper prep when it loads the block or its nominal speed is
+// recomputed.  They are kept apart from the block data that the planner passes read
+// all the time, and are in the same memory as block_buffer.
+struct plan_block_rates_t {
+    float max_junction_speed_sqr;  // Junction entry speed limit based on direction vectors in (mm/min)^2
+    float rapid_rate;              // Axis-limit adjusted maximum rate for this block direction in (mm/min)
+    float programmed_rate;         // Programmed rate of this block (mm/min).
+};
+
+static plan_block_t*       block_buffer = nullptr;  // A ring buffer for motion instructions
+static plan_block_rates_t* block_rates  = nullptr;  // Rate limits, indexed like block_buffer
+static uint16_t            block_buffer_tail;       // Index of the block to process now
+static uint16_t            block_buffer_head;       // Index of the next block to be pushed
+static uint16_t            next_buffer_head;        // Index of the next buffer head
+static uint16_t            block_buffer_planned;    // Index of the optimally planned block
+
+// The most blocks that are allocated in internal RAM.  Deeper buffers need PSRAM,
+// and then the whole ring is there, including the fields that the planner
+// passes and the stepper prep reads in place.  There is no internal copy of
+// the blocks near the tail, because the planner updates them in place while
+// prep is using them.  Prep touches one block per segment, not per step, so
+// PSRAM costs a few cache misses per segment.
+static const int32_t max_internal_blocks = 120;
+
+static plan_block_rates_t* rates(plan_block_t* block) {
+    return &block_rates[block - block_buffer];
+}
 
 void plan_init() {
-    if (block_buffer) {
-        delete[] block_buffer;
+    memory_free(block_buffer);
+    memory_free(block_rates);
+
+    int32_t blocks = config->_planner_blocks;
+    if (blocks > max_internal_blocks && !memory_has_external()) {
+        log_error("planner_blocks above " << max_internal_blocks << " needs PSRAM; using " << max_internal_blocks);
+        blocks = max_internal_blocks;
+    }
+    MemoryTier tier = blocks > max_internal_blocks ? MemoryTier::External : MemoryTier::Internal;
+    block_buffer    = static_cast<plan_block_t*>(memory_alloc(blocks * sizeof(plan_block_t), tier));
+    block_rates     = static_cast<plan_block_rates_t*>(memory_alloc(blocks * sizeof(plan_block_rates_t), tier));
+    if (!block_buffer || !block_rates) {
+        log_error("Not enough memory for " << blocks << " planner blocks; " << memory_free_bytes(tier) << " bytes free");
+        memory_free(block_buffer);
+        memory_free(block_rates);
+        blocks       = max_internal_blocks < config->_planner_blocks ? max_internal_blocks : 16;
+        block_buffer = static_cast<plan_block_t*>(memory_alloc(blocks * sizeof(plan_block_t), MemoryTier::Internal));
+        block_rates  = static_cast<plan_block_rates_t*>(memory_alloc(blocks * sizeof(plan_block_rates_t), MemoryTier::Internal));
+        tier         = MemoryTier::Internal;
+        if (!block_buffer || !block_rates) {
+            memory_free(block_buffer);
+            memory_free(block_rates);
+            block_buffer = nullptr;
+            block_rates  = nullptr;
+            throw std::bad_alloc();
+        }
+    }
+    config->_planner_blocks = blocks;
+    if (tier == MemoryTier::External) {
+        log_info("Planner: " << blocks << " blocks in PSRAM");
     }
-    block_buffer = new plan_block_t[config->_planner_blocks];
 }
 
 // Define planner variables
@@ -38,7 +94,7 @@ typedef struct {
 static planner_t pl;
 
 // Returns the index of the next block in the ring buffer. Also called by stepper segment buffer.
-static uint8_t plan_next_block_index(uint8_t block_index) {
+static uint16_t plan_next_block_index(uint16_t block_index) {
     block_index++;
     if (block_index == config->_planner_blocks) {
         block_index = 0;
@@ -47,7 +103,7 @@ static uint8_t plan_next_block_index(uint8_t block_index) {
 }
 
 // Returns the index of the previous block in the ring buffer
-static uint8_t plan_prev_block_index(uint8_t block_index) {
+static uint16_t plan_prev_block_index(uint16_t block_index) {
     if (block_index == 0) {
         block_index = config->_planner_blocks;
     }
@@ -126,7 +182,7 @@ static void planner_recalculate() {
         return;
     }
     // Initialize block index to the last block in the planner buffer.
-    uint8_t block_index = plan_prev_block_index(block_buffer_head);
+    uint16_t block_index = plan_prev_block_index(block_buffer_head);
     // Bail. Can't do anything with one only one plan-able block.
     if (block_index == block_buffer_planned) {
         return;
@@ -209,7 +265,7 @@ void plan_reset_buffer() {
 // Called from stepper pulse function when the block is complete
 void plan_discard_current_block() {
     if (block_buffer_head != block_buffer_tail) {  // Discard non-empty buffer.
-        uint8_t block_index = plan_next_block_index(block_buffer_tail);
+        uint16_t block_index = plan_next_block_index(block_buffer_tail);
         // Push block_buffer_planned pointer, if encountered.
         if (block_buffer_tail == block_buffer_planned) {
             block_buffer_planned = block_index;
@@ -232,7 +288,7 @@ plan_block_t* plan_get_current_block() {
 }
 
 float plan_get_exec_block_exit_speed_sqr() {
-    uint8_t block_index = plan_next_block_index(block_buffer_tail);
+    uint16_t block_index = plan_next_block_index(block_buffer_tail);
     if (block_index == block_buffer_head) {
         return 0.0f;
     }
@@ -244,18 +300,23 @@ uint8_t plan_check_full_buffer() {
     return block_buffer_tail == next_buffer_head;
 }
 
+float plan_get_programmed_rate(plan_block_t* block) {
+    return rates(block)->programmed_rate;
+}
+
 // Computes and returns block nominal speed based on running condition and override values.
 // NOTE: All system motion commands, such as homing/parking, are not subject to overrides.
 float plan_compute_profile_nominal_speed(plan_block_t* block) {
-    float nominal_speed = block->programmed_rate;
+    plan_block_rates_t* r             = rates(block);
+    float               nominal_speed = r->programmed_rate;
     if (block->motion.rapidMotion) {
         nominal_speed *= (0.01f * sys.r_override());
     } else {
         if (!(block->motion.noFeedOverride)) {
-            nominal_speed *= (0.01f * sys.f_override());
+            nominal_speed *= (0.0001f * sys.f_override() * sys.a_override());
         }
-        if (nominal_speed > block->rapid_rate) {
-            nominal_speed = block->rapid_rate;
+        if (nominal_speed > r->rapid_rate) {
+            nominal_speed = r->rapid_rate;
         }
     }
     if (nominal_speed > MINIMUM_FEED_RATE) {
@@ -274,14 +335,15 @@ static void plan_compute_profile_parameters(plan_block_t* block, float nominal_s
         block->max_entry_speed_sqr = nominal_speed * nominal_speed;
     }
 
-    if (block->max_entry_speed_sqr > block->max_junction_speed_sqr) {
-        block->max_entry_speed_sqr = block->max_junction_speed_sqr;
+    float max_junction_speed_sqr = rates(block)->max_junction_speed_sqr;
+    if (block->max_entry_speed_sqr > max_junction_speed_sqr) {
+        block->max_entry_speed_sqr = max_junction_speed_sqr;
     }
 }
 
 // Re-calculates buffered motions profile parameters upon a motion-based override change.
 void plan_update_velocity_profile_parameters() {
-    uint8_t       block_index = block_buffer_tail;
+    uint16_t      block_index = block_buffer_tail;
     plan_block_t* block;
     float         nominal_speed;
     float         prev_nominal_speed = SOME_LARGE_VALUE;  // Set high for first block nominal speed calculation.
@@ -300,7 +362,8 @@ void plan_update_velocity_profile_parameters() {
 
 bool plan_buffer_line(float* target, plan_line_data_t* pl_data) {
     // Prepare and initialize new block. Copy relevant pl_data for block execution.
-    plan_block_t* block = &block_buffer[block_buffer_head];
+    plan_block_t*       block = &block_buffer[block_buffer_head];
+    plan_block_rates_t* r     = &block_rates[block_buffer_head];
     memset(block, 0, sizeof(plan_block_t));  // Zero all block values.
     block->motion        = pl_data->motion;
     block->coolant       = pl_data->coolant;
@@ -350,22 +413,22 @@ bool plan_buffer_line(float* target, plan_line_data_t* pl_data) {
     // if they are also orthogonal/independent. Operates on the absolute value of the unit vector.
     block->millimeters  = convert_delta_vector_to_unit_vector(unit_vec);
     block->acceleration = limit_acceleration_by_axis_maximum(unit_vec);
-    block->rapid_rate   = limit_rate_by_axis_maximum(unit_vec);
+    r->rapid_rate       = limit_rate_by_axis_maximum(unit_vec);
     // Store programmed rate.
     if (block->motion.rapidMotion) {
-        block->programmed_rate = block->rapid_rate;
+        r->programmed_rate = r->rapid_rate;
     } else {
-        block->programmed_rate = pl_data->feed_rate;
+        r->programmed_rate = pl_data->feed_rate;
         if (block->motion.inverseTime) {
-            block->programmed_rate *= block->millimeters;
+            r->programmed_rate *= block->millimeters;
         }
     }
     // TODO: Need to check this method handling zero junction speeds when starting from rest.
     if ((block_buffer_head == block_buffer_tail) || (block->motion.systemMotion)) {
         // Initialize block entry speed as zero. Assume it will be starting from rest. Planner will correct this later.
         // If system motion, the system motion block always is assumed to start from rest and end at a complete stop.
-        block->entry_speed_sqr        = 0.0;
-        block->max_junction_speed_sqr = 0.0;  // Starting from rest. Enforce start from zero velocity.
+        block->entry_speed_sqr    = 0.0;
+        r->max_junction_speed_sqr = 0.0;  // Starting from rest. Enforce start from zero velocity.
     } else {
         // Compute maximum allowable entry speed at junction by centripetal acceleration approximation.
         // Let a circle be tangent to both previous and current path line segments, where the junction
@@ -397,16 +460,16 @@ bool plan_buffer_line(float* target, plan_line_data_t* pl_data) {
         // NOTE: Computed without any expensive trig, sin() or acos(), by trig half angle identity of cos(theta).
         if (junction_cos_theta > 0.999999) {
             //  For a 0 degree acute junction, just set minimum junction speed.
-            block->max_junction_speed_sqr = MINIMUM_JUNCTION_SPEED * MINIMUM_JUNCTION_SPEED;
+            r->max_junction_speed_sqr = MINIMUM_JUNCTION_SPEED * MINIMUM_JUNCTION_SPEED;
         } else {
             if (junction_cos_theta < -0.999999) {
                 // Junction is a straight line or 180 degrees. Junction speed is infinite.
-                block->max_junction_speed_sqr = SOME_LARGE_VALUE;
+                r->max_junction_speed_sqr = SOME_LARGE_VALUE;
             } else {
                 convert_delta_vector_to_unit_vector(junction_unit_vec);
                 float junction_acceleration = limit_acceleration_by_axis_maximum(junction_unit_vec);
                 float sin_theta_d2          = sqrtf(0.5f * (1.0f - junction_cos_theta));  // Trig half angle identity. Always positive.
-                block->max_junction_speed_sqr =
+                r->max_junction_speed_sqr =
                     MAX(MINIMUM_JUNCTION_SPEED * MINIMUM_JUNCTION_SPEED,
                         (junction_acceleration * config->_junctionDeviation * sin_theta_d2) / (1.0f - sin_theta_d2));
             }
@@ -425,6 +488,7 @@ bool plan_buffer_line(float* target, plan_line_data_t* pl_data) {
         next_buffer_head  = plan_next_block_index(block_buffer_head);
         // Finish up by recalculating the plan with the new block.
         planner_recalculate();
+        motion_sync_block(target, pl_data);
     }
     return true;
 }
@@ -440,7 +504,7 @@ void plan_sync_position() {
 
 // Returns the number of available blocks are in the planner buffer.
 // Called from report_realtime_status
-uint8_t plan_get_block_buffer_available() {
+uint16_t plan_get_block_buffer_available() {
     if (block_buffer_head >= block_buffer_tail) {
         return (config->_planner_blocks - 1) - (block_buffer_head - block_buffer_tail);
     } else {
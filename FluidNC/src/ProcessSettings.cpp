@@ -23,13 +23,19 @@
 #include "FileStream.h"           // FileStream()
 #include "StartupLog.h"           // startupLog
 #include "Driver/gpio_dump.h"     // gpio_dump()
+#include "Driver/fluidnc_gpio.h"  // gpio_filter_*()
 #include "Driver/backtrace.h"     // backtrace_get(), etc.
 #include "FileCommands.h"         // make_file_commands()
 #include "Job.h"                  // Job::active()
+#include "BufferTuner.h"          // tuner_report()
+#include "StepBenchmark.h"        // step_benchmark()
+#include "TaskProfiler.h"         // profile_report()
+#include "SideCommands.h"         // side_commands_mutex
 
 #include "FluidPath.h"
 #include "HashFS.h"
 
+#include <cmath>
 #include <cstring>
 #include <string_view>
 #include <map>
@@ -384,6 +390,10 @@ static Error cmd_log_verbose(const char* value, AuthenticationLevel auth_level,
     }
     return Error::Ok;
 }
+static Error cmd_log_stats(const char* value, AuthenticationLevel auth_level, Channel& out) {
+    log_report_stats(out);
+    return Error::Ok;
+}
 static Error home(AxisMask axisMask, Channel& out) {
     // see if blocking control switches are active
     if (config->_control->pins_block_unlock()) {
@@ -492,6 +502,61 @@ static Error home_v(const char* value, AuthenticationLevel auth_level, Channel&
 static Error home_w(const char* value, AuthenticationLevel auth_level, Channel& out) {
     return home(bitnum_to_mask(W_AXIS), out);
 }
+
+// $Probe/Grid=X<x> Y<y> I<x spacing> J<y spacing> P<columns> Q<rows> Z<depth> F<feed> [R<clearance>]
+// X, Y and Z are in work coordinates and all values are in the current G20/G21 units.
+static Error probe_grid(const char* value, AuthenticationLevel auth_level, Channel& out) {
+    if (!value) {
+        return Error::InvalidStatement;
+    }
+    const char* letters = "XYIJPQZFR";
+    float       words[9];
+    uint32_t    seen = 0;
+    size_t      pos  = 0;
+    while (value[pos]) {
+        char c = toupper(value[pos++]);
+        if (isspace(c)) {
+            continue;
+        }
+        const char* letter = strchr(letters, c);
+        if (!letter) {
+            return Error::GcodeUnusedWords;
+        }
+        int word = letter - letters;
+        if (bitnum_is_true(seen, word)) {
+            return Error::GcodeWordRepeated;
+        }
+        if (!read_number(value, pos, words[word])) {
+            return Error::BadNumberFormat;
+        }
+        set_bitnum(seen, word);
+    }
+    if ((seen & 0xff) != 0xff) {  // Everything but R is required
+        return Error::GcodeValueWordMissing;
+    }
+    if (words[4] < 1 || words[5] < 1 || words[7] <= 0 || (bitnum_is_true(seen, 8) && words[8] < 0)) {
+        return Error::InvalidValue;
+    }
+
+    float scale = gc_state.modal.units == Units::Inches ? MM_PER_INCH : 1.0f;
+    auto  wco   = get_wco();
+
+    ProbeGrid grid;
+    grid.start[X_AXIS] = words[0] * scale + wco[X_AXIS];
+    grid.start[Y_AXIS] = words[1] * scale + wco[Y_AXIS];
+    grid.step[X_AXIS]  = words[2] * scale;
+    grid.step[Y_AXIS]  = words[3] * scale;
+    grid.count[X_AXIS] = uint32_t(words[4]);
+    grid.count[Y_AXIS] = uint32_t(words[5]);
+    grid.depth         = words[6] * scale + wco[Z_AXIS];
+    grid.feed_rate     = words[7] * scale;
+    grid.clearance     = bitnum_is_true(seen, 8) ? words[8] * scale : 0;
+
+    if (grid.depth >= gc_state.position[Z_AXIS]) {
+        return Error::InvalidValue;  // The probe moves down from the current height
+    }
+    return mc_probe_grid(grid, out);
+}
 static std::string limit_set(uint32_t mask) {
     std::string s;
     for (axis_t axis = X_AXIS; axis < MAX_N_AXIS; axis++) {
@@ -685,6 +750,60 @@ static Error motors_init(const char* value, AuthenticationLevel auth_level, Chan
     return Error::Ok;
 }
 
+static void report_skew(Channel& out, axis_t axis) {
+    auto a = config->_axes->_axis[axis];
+    log_stream(out,
+               Axes::axisName(axis) << " skew offset:" << Stepping::offset(axis, 1) / a->_stepsPerMm
+                                    << "mm pending:" << Stepping::correction(axis, 1) / a->_stepsPerMm << "mm");
+}
+
+// $Motor/Skew=Y0.05 says that the second Y motor is 0.05 mm ahead of the
+// first one.  The second motor is moved back by that amount, a step at a
+// time, as the axis moves.  The value can be a parameter or an expression,
+// so a macro can set it from the results of probing a squareness artifact.
+// It is allowed in any state, including during motion: it only adds to the
+// pending correction, which the stepper ISR updates atomically, and it does
+// not touch the planner or the parser state.  In a job, it takes effect on
+// the motion that is still queued when the line is read.
+static Error motor_skew(const char* value, AuthenticationLevel auth_level, Channel& out) {
+    if (state_is(State::ConfigAlarm)) {
+        return Error::ConfigurationInvalid;
+    }
+    auto axes = config->_axes;
+
+    if (!value || *value == '\0') {
+        for (axis_t axis = X_AXIS; axis < axes->_numberAxis; axis++) {
+            if (axes->_axis[axis] && axes->_axis[axis]->hasDualMotor()) {
+                report_skew(out, axis);
+            }
+        }
+        return Error::Ok;
+    }
+
+    axis_t axis = Axes::axisNum(std::string_view(value, 1));
+    if (axis == INVALID_AXIS || axis >= axes->_numberAxis || axes->_axis[axis] == nullptr) {
+        return Error::InvalidValue;
+    }
+    auto a = axes->_axis[axis];
+    if (!a->hasDualMotor()) {
+        log_error(Axes::axisName(axis) << " does not have two motors");
+        return Error::InvalidStatement;
+    }
+    if (value[1] == '\0') {
+        report_skew(out, axis);
+        return Error::Ok;
+    }
+
+    size_t pos = 1;
+    float  skew_mm;
+    if (!read_number(value, pos, skew_mm) || value[pos] != '\0') {
+        return Error::BadNumberFormat;
+    }
+    Stepping::correct(axis, 1, -lroundf(skew_mm * a->_stepsPerMm));
+    report_skew(out, axis);
+    return Error::Ok;
+}
+
 static Error macros_run(const char* value, AuthenticationLevel auth_level, Channel& out) {
     if (value) {
         size_t macro_num = (*value) - '0';
@@ -928,6 +1047,27 @@ static Error readGPIO(const char* value, AuthenticationLevel auth_level, Channel
     return Error::Ok;
 }
 
+static Error showGPIOFilters(const char* value, AuthenticationLevel auth_level, Channel& out) {
+    auto rate = gpio_filter_rate();
+    if (rate) {
+        log_stream(out, "Input filters sampled at " << rate << " Hz");
+    } else {
+        log_stream(out, "Input filters sampled by the polling loop");
+    }
+    bool any = false;
+    for (pinnum_t pin = 0; pin < MAX_N_GPIO; ++pin) {
+        auto samples = gpio_filter_samples(pin);
+        if (samples) {
+            any = true;
+            log_stream(out, "gpio." << int(pin) << " samples:" << samples << " glitches:" << gpio_filter_glitches(pin));
+        }
+    }
+    if (!any) {
+        log_stream(out, "No input pins have filters");
+    }
+    return Error::Ok;
+}
+
 static Error writeGPIOOn(const char* value, AuthenticationLevel auth_level, Channel& out) {
     if (pins.find(value) == pins.end()) {
         Pin* thePin = new Pin(Pin::create(value));
@@ -997,6 +1137,38 @@ static Error showHeap(const char* value, AuthenticationLevel auth_level, Channel
     return Error::Ok;
 }
 
+static Error buffers_tune(const char* value, AuthenticationLevel auth_level, Channel& out) {
+    if (value && string_util::equal_ignore_case(value, "reset")) {
+        tuner_reset();
+        return Error::Ok;
+    }
+    tuner_report(out);
+    return Error::Ok;
+}
+
+static Error tasks_profile(const char* value, AuthenticationLevel auth_level, Channel& out) {
+    if (value && string_util::equal_ignore_case(value, "reset")) {
+        profile_reset();
+        return Error::Ok;
+    }
+    profile_report(out);
+    return Error::Ok;
+}
+
+static Error stepping_benchmark(const char* value, AuthenticationLevel auth_level, Channel& out) {
+    uint32_t pulses = 2000;
+    if (value) {
+        if (!string_util::from_decimal(value, pulses)) {
+            return Error::BadNumberFormat;
+        }
+        if (pulses < 2 || pulses > 1000000) {
+            return Error::NumberRange;
+        }
+    }
+    step_benchmark(out, pulses);
+    return Error::Ok;
+}
+
 static Error list_parameters(const char* value, AuthenticationLevel auth_level, Channel& out) {
     list_global_params(out);
     list_local_params(out);
@@ -1009,17 +1181,18 @@ static Error list_parameters(const char* value, AuthenticationLevel auth_level,
 // to performing some system state change.  Each command is responsible
 // for decoding its own value string, if it needs one.
 void make_user_commands() {
-    new UserCommand("GD", "GPIO/Dump", showGPIOs, anyState);
+    new ReadOnlyUserCommand("GD", "GPIO/Dump", showGPIOs, anyState);
     new UserCommand("GI", "GPIO/Input", setGPIOInput, anyState);
     new UserCommand("GO", "GPIO/Output", setGPIOOutput, anyState);
     new UserCommand("G+", "GPIO/On", writeGPIOOn, anyState);
     new UserCommand("G-", "GPIO/Off", writeGPIOOff, anyState);
     new UserCommand("GR", "GPIO/Read", readGPIO, anyState);
+    new ReadOnlyUserCommand("GF", "GPIO/Filters", showGPIOFilters, anyState);
 
-    new UserCommand("CI", "Channel/Info", showChannelInfo, anyState);
+    new ReadOnlyUserCommand("CI", "Channel/Info", showChannelInfo, anyState);
     new UserCommand("CD", "Config/Dump", dump_config, anyState);
-    new UserCommand("", "Help", show_help, anyState);
-    new UserCommand("T", "State", showState, anyState);
+    new ReadOnlyUserCommand("", "Help", show_help, anyState);
+    new ReadOnlyUserCommand("T", "State", showState, anyState);
 
     new UserCommand("$", "GrblSettings/List", report_normal_settings, cycleOrHold);
     new UserCommand("L", "GrblNames/List", list_grbl_names, cycleOrHold);
@@ -1027,8 +1200,8 @@ void make_user_commands() {
     new UserCommand("S", "Settings/List", list_settings, cycleOrHold);
     new UserCommand("SC", "Settings/ListChanged", list_changed_settings, cycleOrHold);
     new UserCommand("CMD", "Commands/List", list_commands, cycleOrHold);
-    new UserCommand("A", "Alarms/List", listAlarms, anyState);
-    new UserCommand("E", "Errors/List", listErrors, anyState);
+    new ReadOnlyUserCommand("A", "Alarms/List", listAlarms, anyState);
+    new ReadOnlyUserCommand("E", "Errors/List", listErrors, anyState);
     new UserCommand("C", "GCode/Check", toggle_check_mode, anyState);
     new UserCommand("X", "Alarm/Disable", disable_alarm_lock, anyState);
     new UserCommand("NVX", "Settings/Erase", Setting::eraseNVS, notIdleOrAlarm, WA);
@@ -1037,6 +1210,7 @@ void make_user_commands() {
     new UserCommand("MD", "Motor/Disable", motor_disable, notIdleOrAlarm);
     new UserCommand("ME", "Motor/Enable", motor_enable, notIdleOrAlarm);
     new UserCommand("MI", "Motors/Init", motors_init, notIdleOrAlarm);
+    new UserCommand("MS", "Motor/Skew", motor_skew, anyState);
 
     new UserCommand("RM", "Macros/Run", macros_run, nullptr);
     new UserCommand("PL", "Parameters/List", list_parameters, nullptr);
@@ -1052,6 +1226,8 @@ void make_user_commands() {
     new UserCommand("HV", "Home/V", home_v, allowConfigStates);
     new UserCommand("HW", "Home/W", home_w, allowConfigStates);
 
+    new UserCommand("PG", "Probe/Grid", probe_grid, notIdle);
+
     new UserCommand("MU0", "Msg/Uart0", msg_to_uart0, anyState);
     new UserCommand("MU1", "Msg/Uart1", msg_to_uart1, anyState);
     new UserCommand("MC", "Msg/Channel", msg_to_channel, anyState);
@@ -1061,15 +1237,19 @@ void make_user_commands() {
     new UserCommand("LI", "Log/Info", cmd_log_info, anyState);
     new UserCommand("LD", "Log/Debug", cmd_log_debug, anyState);
     new UserCommand("LV", "Log/Verbose", cmd_log_verbose, anyState);
+    new ReadOnlyUserCommand("LS", "Log/Stats", cmd_log_stats, anyState);
 
     new UserCommand("SLP", "System/Sleep", go_to_sleep, notIdleOrAlarm);
-    new UserCommand("I", "Build/Info", get_report_build_info, allowConfigStates);
+    new ReadOnlyUserCommand("I", "Build/Info", get_report_build_info, allowConfigStates);
     new UserCommand("RST", "Settings/Restore", restore_settings, notIdleOrAlarm, WA);
 
     new UserCommand("SA", "Alarm/Send", sendAlarm, anyState);
-    new UserCommand("Heap", "Heap/Show", showHeap, anyState);
-    new UserCommand("SS", "Startup/Show", showStartupLog, anyState);
-    new UserCommand("BS", "Backtrace/Show", showBacktrace, anyState);
+    new ReadOnlyUserCommand("Heap", "Heap/Show", showHeap, anyState);
+    new UserCommand("BT", "Buffers/Tune", buffers_tune, anyState);
+    new UserCommand("SB", "Stepping/Benchmark", stepping_benchmark, notIdle);
+    new UserCommand("TP", "Tasks/Profile", tasks_profile, anyState);
+    new ReadOnlyUserCommand("SS", "Startup/Show", showStartupLog, anyState);
+    new ReadOnlyUserCommand("BS", "Backtrace/Show", showBacktrace, anyState);
 #ifdef CRASH_TEST
     new UserCommand("CRASH", "Crash/Test", forceCrash, anyState);
 #endif
@@ -1236,6 +1416,7 @@ Error execute_line(const char* line, Channel& channel, AuthenticationLevel auth_
             return Error::Ok;
         }
 
+        std::lock_guard<std::recursive_mutex> lock(side_commands_mutex);
         return settings_execute_line(line, channel, auth_level);
     }
     // Everything else is gcode. Block if in alarm or jog mode.
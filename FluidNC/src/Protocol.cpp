@@ -20,6 +20,10 @@
 #include "Job.h"
 #include "Driver/restart.h"
 #include "Driver/watchdog.h"
+#include "BufferTuner.h"   // tuner_*
+#include "SideCommands.h"  // side_commands_poll()
+#include "MotionSync.h"    // motion_sync_*
+#include "TaskProfiler.h"  // ProfileRun
 
 volatile ExecAlarm lastAlarm;  // The most recent alarm code
 
@@ -85,6 +89,7 @@ static int32_t idleEndTime = 0;
   PRIMARY LOOP:
 */
 static void request_safety_door() {
+    motion_sync_realtime(Cmd::SafetyDoor);
     rtSafetyDoor = true;
 }
 
@@ -99,10 +104,12 @@ void drain_messages() {
 }
 
 void output_loop(void* unused) {
+    ProfileSlot profile = profile_task(ProfiledTask::Output);
     while (true) {
         // Block until a message is received
         LogMessage message;
         if (xQueueReceive(message_queue, &message, portMAX_DELAY)) {
+            ProfileRun run(profile);
             if (message.isString) {
                 std::string* s = static_cast<std::string*>(message.line);
                 message.channel->print_msg(message.level, s->c_str());
@@ -110,6 +117,7 @@ void output_loop(void* unused) {
             } else {
                 const char* cp = static_cast<const char*>(message.line);
                 message.channel->print_msg(message.level, cp);
+                log_release(cp);
             }
         }
     }
@@ -124,6 +132,7 @@ char activeLine[Channel::maxLine];
 bool pollingPaused = false;
 void polling_loop(void* unused) {
     add_watchdog_to_task();
+    ProfileSlot profile = profile_task(ProfiledTask::Poller);
 
     // Poll the input sources waiting for a complete line to arrive
     for (; true; /*feedLoopWDT(), */ vTaskDelay(1)) {
@@ -132,6 +141,7 @@ void polling_loop(void* unused) {
             vTaskDelay(100);
             continue;
         }
+        ProfileRun run(profile);
 
         // Polling without an argument checks for realtime characters
         // Polling with an argument both checks for realtime characters and
@@ -142,6 +152,9 @@ void polling_loop(void* unused) {
             feed_watchdog();
         }
 
+        // Lines from channels other than the job's, while a job is active
+        side_commands_poll(Job::active(), Job::leader);
+
         // If activeChannel is non-null, it means that we have received a line
         // but the task running protocol_main_loop() has not yet picked it up.
         // activeChannel is thus a form of flow control between the protocol
@@ -240,12 +253,14 @@ int32_t  heapLowWaterReportTime = 0;
 void protocol_main_loop() {
     add_watchdog_to_task();
     start_polling();
+    ProfileSlot profile = profile_task(ProfiledTask::Protocol);
 
     // ---------------------------------------------------------------------------------
     // Primary loop! Upon a system abort, this exits back to main() to reset the system.
     // This is also where the system idles while waiting for something to do.
     // ---------------------------------------------------------------------------------
     for (;; vTaskDelay(1)) {
+        ProfileRun run(profile);
         if (activeChannel) {
             // The input polling task has collected a line of input
             if (gcode_echo->get()) {
@@ -254,6 +269,7 @@ void protocol_main_loop() {
 
             Channel* out_channel = Job::leader ? Job::leader : activeChannel;
 
+            tuner_line_received();
             Error status_code = execute_line(activeLine, *out_channel, AuthenticationLevel::LEVEL_GUEST);
 
             // Tell the channel that the line has been processed.
@@ -265,8 +281,11 @@ void protocol_main_loop() {
             // Tell the input polling task that the line has been processed,
             // so it can give us another one when available
             activeChannel = nullptr;
+            tuner_line_done();
         }
 
+        motion_sync_poll();
+
         // Auto-cycle start any queued moves.
         protocol_auto_cycle_start();
         protocol_execute_realtime();  // Runtime command check point.
@@ -317,6 +336,7 @@ void protocol_main_loop() {
 // Block until all buffered steps are executed or in a cycle state. Works with feed hold
 // during a synchronize call, if it should happen. Also, waits for clean cycle end.
 void protocol_buffer_synchronize() {
+    ProfileWait wait;
     do {
         // Restart motion if there are blocks in the planner queue
         protocol_auto_cycle_start();
@@ -333,8 +353,13 @@ void protocol_buffer_synchronize() {
 // when one of these conditions exist respectively: There are no more blocks sent (i.e. streaming// is finished, single commands), a command that needs to wait for the motions in the buffer to
 // execute calls a buffer sync, or the planner buffer is full and ready to go.
 void protocol_auto_cycle_start() {
-    if (plan_get_current_block() != NULL && !state_is(State::Cycle) && !state_is(State::Hold)) {  // Check if there are any blocks in the buffer.
-        protocol_send_event(&cycleStartEvent);                                                    // If so, execute them
+    plan_block_t* pb = plan_get_current_block();
+    // A motion sync follower starts the leader's blocks when the leader says so
+    if (pb != NULL && motion_sync_follower() && !pb->is_jog) {
+        return;
+    }
+    if (pb != NULL && !state_is(State::Cycle) && !state_is(State::Hold)) {  // Check if there are any blocks in the buffer.
+        protocol_send_event(&cycleStartEvent);                              // If so, execute them
     }
 }
 
@@ -443,6 +468,7 @@ static void protocol_do_start() {
 
 static void protocol_do_alarm(void* alarmVoid) {
     lastAlarm = (ExecAlarm)((int)(intptr_t)alarmVoid);
+    motion_sync_stop(lastAlarm);
     if (spindle->_off_on_alarm) {
         spindle->stop();
     }
@@ -547,6 +573,7 @@ static void protocol_do_feedhold() {
         runLimitLoop = false;  // Hack to stop show_limits()
         return;
     }
+    motion_sync_realtime(Cmd::FeedHold);
     // log_debug("protocol_do_feedhold " << state_name());
     // Execute a feed hold with deceleration, if required. Then, suspend system.
     switch (sys.state()) {
@@ -705,7 +732,9 @@ static void protocol_do_initiate_cycle() {
         sys.set_suspend(suspend);
         set_state(pb->is_jog ? State::Jog : State::Cycle);
         Stepper::prep_buffer();  // Initialize step segment buffer before beginning cycle.
-        Stepper::wake_up();
+        if (pb->is_jog || motion_sync_start()) {
+            Stepper::wake_up();
+        }
     } else {  // Otherwise, do nothing. Set and resume IDLE state.
         auto suspend  = sys.suspend();
         suspend.value = 0;  // Break suspend state.
@@ -842,6 +871,7 @@ void protocol_do_cycle_stop() {
                 gc_sync_position();
                 plan_sync_position();
             }
+            Stepper::sync_offset();                  // A torch height offset carried past a stop
             if (sys.suspend().bit.safetyDoorAjar) {  // Only occurs when safety door opens during jog.
                 auto suspend             = sys.suspend();
                 suspend.bit.jogCancel    = false;
@@ -908,9 +938,13 @@ void protocol_exec_rt_system() {
         case State::Hold:
         case State::SafetyDoor:
         case State::Homing:
-        case State::Jog:
+        case State::Jog: {
+            ProfileWork work;  // Counted even while the protocol task waits
+            int32_t     start = tuner_prep_start();
             Stepper::prep_buffer();
+            tuner_prep_end(start);
             break;
+        }
     }
 }
 
@@ -965,6 +999,7 @@ static void protocol_exec_rt_suspend() {
         protocol_send_event(&accessoryOverrideEvent, (void*)AccessoryOverride::SpindleStopOvr);
     }
 
+    ProfileWait wait;
     while (sys.suspend().value) {
         if (sys.abort()) {
             return;
@@ -1054,6 +1089,16 @@ static void protocol_do_feed_override(void* incrementvp) {
     }
 }
 
+// Adaptive feed scales the feed rate along with the feed override, so the
+// operator's override still applies on top of it
+static void protocol_do_adaptive_feed(void* percentvp) {
+    Percent percent = Percent(intptr_t(percentvp));
+    if (percent != sys.a_override()) {
+        sys.set_a_override(percent);
+        plan_update_velocity_profile_parameters();
+    }
+}
+
 static void protocol_do_rapid_override(void* percentvp) {
     Percent percent = Percent(intptr_t(percentvp));
     if (percent != sys.r_override()) {
@@ -1160,6 +1205,7 @@ void protocol_do_rt_reset() {
     } else if (!state_is(State::Alarm)) {
         set_state(State::Idle);
     }
+    motion_sync_stop(ExecAlarm::None);
     protocol_do_late_reset();
     protocol_send_event(&restartEvent);
 }
@@ -1182,6 +1228,7 @@ void report_realtime_status_wrap(void* arg) {
 }
 
 const ArgEvent feedOverrideEvent { protocol_do_feed_override };
+const ArgEvent adaptiveFeedEvent { protocol_do_adaptive_feed };
 const ArgEvent rapidOverrideEvent { protocol_do_rapid_override };
 const ArgEvent spindleOverrideEvent { protocol_do_spindle_override };
 const ArgEvent accessoryOverrideEvent { protocol_do_accessory_override };
@@ -1229,6 +1276,7 @@ void protocol_handle_events() {
     feed_watchdog();
     EventItem item;
     while (xQueueReceive(event_queue, &item, 0)) {
+        ProfileWork work;
         item.event->run(item.arg);
         feed_watchdog();
     }
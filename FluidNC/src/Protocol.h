@@ -64,6 +64,7 @@ enum AccessoryOverride {
 };
 
 extern const ArgEvent feedOverrideEvent;
+extern const ArgEvent adaptiveFeedEvent;
 extern const ArgEvent rapidOverrideEvent;
 extern const ArgEvent spindleOverrideEvent;
 extern const ArgEvent accessoryOverrideEvent;
@@ -5,9 +5,11 @@
 #include "Report.h"
 #include "System.h"
 #include "Machine/Macros.h"  // macroNEvent
+#include "MotionSync.h"      // motion_sync_override
 
 // Act upon a realtime character
 void execute_realtime_command(Cmd command, Channel& channel) {
+    motion_sync_override(command);
     switch (command) {
         case Cmd::Reset:
             protocol_send_event(&rtResetEvent);
@@ -199,6 +199,12 @@ void report_probe_parameters(Channel& channel) {
     log_stream(channel, "[PRB:" << report_util_axis_values(print_position) << ":" << probe_succeeded);
 }
 
+// Prints one contact of a probe grid, in machine coordinates like [PRB:], prefixed by the
+// column and row of the point so that a sender can build its height map as the lines arrive.
+void report_probe_grid_point(Channel& channel, uint32_t column, uint32_t row, const float* contact) {
+    log_stream(channel, "[PRBG:" << column << "," << row << ":" << report_util_axis_values(contact));
+}
+
 // Prints NGC parameters (coordinate offsets, probing)
 void report_g92(Channel& channel) {}
 void report_tlo(Channel& channel) {}
@@ -537,6 +543,14 @@ void report_realtime_status(Channel& channel) {
     }
     msg << "|FS:" << setprecision(0) << rate << "," << sys.spindle_speed();
 
+    if (spindle && spindle->_tach) {
+        msg << "|Tach:" << spindle->_tach->rpm();
+    }
+
+    if (sys.a_override() != FeedOverride::Default) {
+        msg << "|AF:" << int(sys.a_override());
+    }
+
     if (report_pin_string.length()) {
         msg << "|Pn:" << report_pin_string;
     }
@@ -67,6 +67,9 @@ void report_realtime_status(Channel& channel);
 // Prints recorded probe position
 void report_probe_parameters(Channel& channel);
 
+// Prints one contact of a probe grid
+void report_probe_grid_point(Channel& channel, uint32_t column, uint32_t row, const float* contact);
+
 void report_ngc_coord(CoordIndex coord, Channel& channel);
 
 // Prints NGC parameters (coordinate offsets, probe)
@@ -39,6 +39,7 @@ void SDCard::init() {
 
     config_ok = true;
 
+    sd_set_read_cache(_cache_kb * 1024);
     if (_cardDetect.defined()) {
         _cardDetect.setAttr(Pin::Attr::Input);
         auto cdPin = _cardDetect.getNative(Pin::Capabilities::Input | Pin::Capabilities::Native);
@@ -54,5 +55,9 @@ void SDCard::afterParse() {
     // }
 }
 
+void SDCard::validate() {
+    Assert(_cache_kb == 0 || _cache_kb >= 4, "sdcard cache_kb must be 0 or 4-32");
+}
+
 SDCard::~SDCard() {}
 #endif
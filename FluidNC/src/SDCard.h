@@ -28,6 +28,7 @@ private:
     Pin   _cs;
 
     uint32_t _frequency_hz = 8000000;  // Set to nonzero to override the default
+    uint32_t _cache_kb     = 8;        // Read-ahead chunk size, 0 to disable
 
 public:
     SDCard();
@@ -35,6 +36,7 @@ public:
     SDCard& operator=(const SDCard&) = delete;
 
     void afterParse() override;
+    void validate() override;
 
     const char* filename();
     bool        config_ok = false;
@@ -46,7 +48,8 @@ public:
     void group(Configuration::HandlerBase& handler) override {
         handler.item("cs_pin", _cs);
         handler.item("card_detect_pin", _cardDetect);
-        handler.item("frequency_hz", _frequency_hz, 400000, 20000000);
+        handler.item("frequency_hz", _frequency_hz, 400000, 40000000);
+        handler.item("cache_kb", _cache_kb, 0, 32);
     }
 
     ~SDCard();
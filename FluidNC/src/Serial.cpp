@@ -183,7 +183,7 @@ Channel* AllChannels::find(const std::string_view name) {
     _mutex_general.unlock();
     return nullptr;
 }
-Channel* AllChannels::poll(char* line) {
+Channel* AllChannels::poll(char* line, Channel* except, bool skipUnread) {
     Channel* deadChannel;
     while (xQueueReceive(_killQueue, &deadChannel, 0)) {
         deregistration(deadChannel);
@@ -197,7 +197,8 @@ Channel* AllChannels::poll(char* line) {
 
     for (auto channel : _channelq) {
         // Skip the last channel in the loop
-        if (channel != _lastChannel && channel->pollLine(line) == Error::Ok) {
+        if (channel != _lastChannel && channel != except && !(skipUnread && channel->hasUnreadLine()) &&
+            channel->pollLine(line) == Error::Ok) {
             _lastChannel = channel;
             _mutex_pollLine.unlock();
             return _lastChannel;
@@ -205,7 +206,8 @@ Channel* AllChannels::poll(char* line) {
     }
     _mutex_pollLine.unlock();
     // If no other channel returned a line, try the last one
-    if (_lastChannel && _lastChannel->pollLine(line) == Error::Ok) {
+    if (_lastChannel && _lastChannel != except && !(skipUnread && _lastChannel->hasUnreadLine()) &&
+        _lastChannel->pollLine(line) == Error::Ok) {
         return _lastChannel;
     }
     _lastChannel = nullptr;
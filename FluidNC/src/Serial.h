@@ -53,7 +53,7 @@ public:
     void listChannels(Channel& out);
 
     Channel* find(const std::string_view name);
-    Channel* poll(char* line);
+    Channel* poll(char* line, Channel* except = nullptr, bool skipUnread = false);
 };
 
 extern AllChannels allChannels;
@@ -44,6 +44,9 @@ bool paramIsJSON(const char* cmd_params) {
 bool anyState() {
     return false;
 }
+bool notIdle() {
+    return !state_is(State::Idle);
+}
 bool notIdleOrJog() {
     return !state_is(State::Idle) && !state_is(State::Jog);
 }
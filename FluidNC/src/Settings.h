@@ -79,6 +79,7 @@ public:
 class Command : public Word {
 protected:
     bool (*_cmdChecker)();
+    bool _concurrent = false;
 
 private:
     bool _synchronous = true;
@@ -103,6 +104,7 @@ public:
 
     virtual Error action(const char* value, AuthenticationLevel auth_level, Channel& out) = 0;
     bool          synchronous() { return _synchronous; }
+    bool          concurrent() { return _concurrent; }
 };
 
 extern NVS nvs;
@@ -330,6 +332,7 @@ public:
     int8_t get() { return _currentValue; }
 };
 
+extern bool notIdle();
 extern bool notIdleOrJog();
 extern bool notIdleOrAlarm();
 extern bool anyState();
@@ -403,6 +406,21 @@ public:
         UserCommand(grblName, name, action, cmdChecker, auth, false) {}
 };
 
+// A command that only reports state that is safe to read from outside the
+// protocol task, so it may be run from other channels while a job is active.
+// See SideCommands.cpp.
+class ReadOnlyUserCommand : public UserCommand {
+public:
+    ReadOnlyUserCommand(const char* grblName,
+                        const char* name,
+                        Error (*action)(const char*, AuthenticationLevel, Channel&),
+                        bool (*cmdChecker)(),
+                        permissions_t auth = WG) :
+        UserCommand(grblName, name, action, cmdChecker, auth, false) {
+        _concurrent = true;
+    }
+};
+
 // Execute the startup script lines stored in non-volatile storage upon initialization
 Error settings_execute_line(const char* line, Channel& out, AuthenticationLevel);
 Error do_command_or_setting(std::string_view key, std::string_view value, AuthenticationLevel auth_level, Channel&);
@@ -0,0 +1,67 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "SideCommands.h"
+
+#include "Settings.h"     // Command, settings_execute_line()
+#include "Serial.h"       // allChannels
+#include "string_util.h"  // split(), trim(), equal_ignore_case()
+
+#include <cctype>
+
+std::recursive_mutex side_commands_mutex;
+
+static char side_line[Channel::maxLine];
+
+// A command is allowed if it is marked read-only.  Displaying a setting or
+// config item is allowed, but setting one is not.
+static bool allowed(const char* line) {
+    while (isspace(*line)) {
+        ++line;
+    }
+    if (*line != '$') {
+        return false;
+    }
+    std::string_view key(line + 1);
+    std::string_view value;
+    bool             has_value = string_util::split(key, value, '=');
+    key                        = string_util::trim(key);
+
+    for (Command* cp : Command::List) {
+        bool usedGrblName = cp->getGrblName() && string_util::equal_ignore_case(cp->getGrblName(), key);
+        if (usedGrblName || string_util::equal_ignore_case(cp->getName(), key)) {
+            return cp->concurrent();
+        }
+    }
+    return !has_value;
+}
+
+void side_commands_poll(bool job_active, Channel* job_leader) {
+    if (!job_active) {
+        return;
+    }
+
+    // The protocol task can hold the lock for a long time, for example while
+    // homing, so try again on the next poll instead of waiting.  Waiting would
+    // stop the polling of realtime characters.  The lock is taken before a
+    // line is read, so no line is kept here across polls.
+    std::unique_lock<std::recursive_mutex> lock(side_commands_mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return;
+    }
+
+    // Channels are deleted only inside allChannels.poll(), in this task, so
+    // the channel stays valid until the line has run.
+    Channel* channel = allChannels.poll(side_line, job_leader, true);
+    if (!channel) {
+        return;
+    }
+    if (!allowed(side_line)) {
+        // Leave the line for the protocol task, which reads it after the job,
+        // and skip this channel until then so its lines keep their order
+        channel->unreadLine(side_line);
+        return;
+    }
+    Error status = settings_execute_line(side_line, *channel, AuthenticationLevel::LEVEL_GUEST);
+    channel->ack(status);
+}
@@ -0,0 +1,25 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include "Channel.h"
+
+#include <mutex>
+
+// While a job runs, the protocol task accepts lines only from the job
+// channel, so other channels could only send realtime characters.  Lines
+// from those channels are instead handled here, in the low-priority polling
+// task, so that a monitoring program can query the controller during a job.
+// Only read-only commands and displays of settings and config items are
+// run; these never touch gc_state or the planner.  Any other line is left
+// unread, with the lines behind it, until the job ends.
+
+// Held while a $ line runs, in both the protocol and the polling task.
+// Settings and config items are only changed by $ lines, so holding it
+// makes it safe to read them.
+extern std::recursive_mutex side_commands_mutex;
+
+// Called from the polling task.  Lines are read only while a job is active,
+// and never from the channel that started the job.
+void side_commands_poll(bool job_active, Channel* job_leader);
@@ -30,6 +30,7 @@ namespace Spindles {
         _direction_pin.setAttr(Pin::Attr::Output);
         _forward_pin.setAttr(Pin::Attr::Output);
         _reverse_pin.setAttr(Pin::Attr::Output);
+        resolve_pins();
 
         if (_speeds.size() == 0) {
             shelfSpeeds(6000, 20000);
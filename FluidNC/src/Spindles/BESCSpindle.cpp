@@ -35,6 +35,7 @@ namespace Spindles {
 
         _output_pin.setAttr(Pin::Attr::PWM, _pwm_freq);
         _enable_pin.setAttr(Pin::Attr::Output);
+        resolve_pins();
 
         // BESC PWM typically represents 0 speed as a 1ms pulse and max speed as a 2ms pulse
 
@@ -74,7 +75,7 @@ namespace Spindles {
         // represents full on.  Typically the off value is a 1ms pulse length and the
         // full on value is a 2ms pulse.
         // uint32_t pulse_counts = _min_pulse_counts + (_pulse_span_counts * (uint64_t) duty)/_pwm->period();
-        _output_pin.setDuty(_min_pulse_counts + (_pulse_span_counts * (uint64_t)duty) / _output_pin.maxDuty());
+        _output_fast.setDuty(_min_pulse_counts + (_pulse_span_counts * (uint64_t)duty) / _output_pin.maxDuty());
         // _output_pin.setDuty(_min_pulse_counts+duty); // More efficient by keeping math within 32bits??
         // log_info(name() << " duty:" << duty << " _min_pulse_counts:" << _min_pulse_counts
         //                 << " _pulse_span_counts:" << _pulse_span_counts << " pulse_counts" << pulse_counts);
@@ -34,6 +34,7 @@ namespace Spindles {
 
         _enable_pin.setAttr(Pin::Attr::Output);
         _direction_pin.setAttr(Pin::Attr::Output);
+        resolve_pins();
 
         if (_speeds.size() == 0) {
             // The default speed map for a PWM spindle is linear from 0=0% to 10000=100%
@@ -49,6 +50,19 @@ namespace Spindles {
         set_output(dev_speed);
     }
 
+    void PWM::resolve_pins() {
+        _output_fast = _output_pin.resolve();
+        _enable_fast = _enable_pin.resolve();
+    }
+
+    void IRAM_ATTR PWM::set_enable(bool enable) {
+        if (_disable_with_zero_speed && sys.spindle_speed() == 0) {
+            enable = false;
+        }
+
+        _enable_fast.synchronousWrite(enable);
+    }
+
     // XXX this is the same as OnOff::setState so it might be possible to combine them
     void PWM::setState(SpindleState state, SpindleSpeed speed) {
         if (sys.abort()) {
@@ -97,7 +111,7 @@ namespace Spindles {
         }
 
         _current_pwm_duty = duty;
-        _output_pin.setDuty(duty);
+        _output_fast.setDuty(duty);
     }
 
     void PWM::deinit() {
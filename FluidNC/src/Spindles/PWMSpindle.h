@@ -30,6 +30,7 @@ namespace Spindles {
         void setSpeedfromISR(uint32_t dev_speed) override;
         void setState(SpindleState state, SpindleSpeed speed) override;
         void config_message() override;
+        void set_enable(bool enable) override;
         // Configuration handlers:
         void validate() override { Spindle::validate(); }
 
@@ -56,6 +57,16 @@ namespace Spindles {
     protected:
         uint32_t _current_pwm_duty = 0;
 
+        // The output and enable are written for every step segment in laser
+        // mode, from the stepper ISR, so they are resolved to handles without
+        // virtual calls.  init() and every subclass init() must call
+        // resolve_pins() after setting the pin attributes; until then the
+        // handles are no-ops.
+        Pins::ResolvedPin _output_fast;
+        Pins::ResolvedPin _enable_fast;
+
+        void resolve_pins();
+
         // Configurable
         uint32_t _pwm_freq = 5000;
 
@@ -9,6 +9,9 @@ PlasmaSpindle:
   enable_pin: gpio.14
   arc_ok_pin: 'gpio.33:low'
   arc_wait_ms: 1200
+  thc:
+    adc_pin: gpio.36
+    target_volts: 120
   tool_num: 0
   speed_map: 0=0.00% 1=100.00%
   off_on_alarm: true
@@ -41,6 +44,10 @@ namespace Spindles {
         setupSpeeds(1);
         init_atc();
         config_message();
+
+        if (_thc) {
+            _thc->init();
+        }
     }
 
     // prints the startup message of the spindle config
@@ -58,6 +65,9 @@ namespace Spindles {
             _arc_on = false;
             set_enable(false);
             sys.set_spindle_speed(0);
+            if (_thc) {
+                _thc->stop();
+            }
         } else {
             sys.set_spindle_speed(speed);
 
@@ -79,6 +89,9 @@ namespace Spindles {
                 return;
             }
             _arc_on = true;
+            if (_thc) {
+                _thc->start();
+            }
         }
     }
 
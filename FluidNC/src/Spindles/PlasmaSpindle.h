@@ -8,6 +8,7 @@
 */
 
 #include "Spindle.h"
+#include "TorchHeightControl.h"
 #include "MotionControl.h"  // mc_critical
 
 namespace Spindles {
@@ -42,6 +43,7 @@ namespace Spindles {
             handler.item("enable_pin", _enable_pin);
             handler.item("arc_ok_pin", _arcOkEventPin);
             handler.item("arc_wait_ms", _max_arc_wait, 0, 3000);
+            handler.section("thc", _thc);
             Spindle::group(handler);
         }
 
@@ -77,6 +79,8 @@ namespace Spindles {
 
         uint32_t _max_arc_wait = 1000;
 
+        TorchHeightControl* _thc = nullptr;
+
         bool         _arc_on = false;
         bool         use_delay_settings() const override { return false; }
         virtual void set_output(uint32_t speed);
@@ -8,6 +8,8 @@
 
 #include "System.h"  //sys.spindle_speed_ovr
 
+#include <algorithm>
+
 Spindles::Spindle* spindle = nullptr;
 
 namespace Spindles {
@@ -98,11 +100,25 @@ namespace Spindles {
         _speeds[i].scale  = scaler;
     }
 
+    static void checkCurve(const char* name, std::vector<float>& curve) {
+        float last = 0.0f;
+        for (auto ms : curve) {
+            if (ms < last) {
+                log_error(name << " times must increase. Using spinup_ms/spindown_ms");
+                curve.clear();
+                return;
+            }
+            last = ms;
+        }
+    }
+
     void Spindle::afterParse() {
         if (_speeds.size() && !maxSpeed()) {
             log_error("Speed map max speed is 0. Using default");
             _speeds.clear();
         }
+        checkCurve("spinup_curve_ms", _spinup_curve);
+        checkCurve("spindown_curve_ms", _spindown_curve);
     }
 
     void Spindle::linearSpeeds(SpindleSpeed maxSpeed, float maxPercent) {
@@ -201,8 +217,64 @@ namespace Spindles {
         // log_debug("rpm " << speed << " speed " << dev_speed); // This will spew quite a bit of data on your output
         return dev_speed;
     }
+    // Time in ms for the spindle to go between standstill and speed.  The
+    // points of a curve are at equal steps of max_speed / n, and the time
+    // is interpolated between them.  Without a curve the ramp is linear.
+    uint32_t Spindle::rampTime(uint32_t full_ms, const std::vector<float>& curve, SpindleSpeed speed) {
+        uint32_t max_speed = maxSpeed();
+        if (!max_speed) {
+            return 0;
+        }
+        if (speed >= max_speed) {
+            return curve.empty() ? full_ms : uint32_t(curve.back());
+        }
+        if (curve.empty()) {
+            return uint32_t(uint64_t(full_ms) * speed / max_speed);
+        }
+        uint64_t scaled = uint64_t(speed) * curve.size();
+        size_t   i      = scaled / max_speed;
+        uint32_t t0     = i ? uint32_t(curve[i - 1]) : 0;
+        uint32_t t1     = uint32_t(curve[i]);
+        return t0 + uint32_t((t1 - t0) * (scaled % max_speed) / max_speed);
+    }
+
+    // Waits out a speed change.  With a tachometer the wait ends when the
+    // measured speed gets there, with the modeled time as a guide to how
+    // long is too long.
+    void Spindle::rampWait(uint32_t dwell, SpindleSpeed target, uint32_t tolerance) {
+        if (!_tach) {
+            dwell_ms(dwell, DwellMode::SysSuspend);
+            return;
+        }
+        uint32_t percent = target ? std::max<uint32_t>(tolerance * 100 / target, 2) : 0;
+        uint32_t limit   = 2 * dwell + 1000;
+        uint32_t waited  = 0;
+        while (!_tach->at_speed(target, percent)) {
+            if (waited >= limit) {
+                log_warn("Spindle did not reach " << target << " RPM; measured " << _tach->rpm());
+                return;
+            }
+            if (!dwell_ms(_tach->sample_ms(), DwellMode::SysSuspend)) {
+                return;
+            }
+            waited += _tach->sample_ms();
+        }
+        log_debug("Spindle at speed after ms:" << waited);
+    }
+
+    int32_t Spindle::load_percent() {
+        return _tach ? _tach->load_percent(_current_speed) : -1;
+    }
+
+    void Spindle::init_tachometer() {
+        if (_tach) {
+            _tach->init(this);
+        }
+    }
+
     void Spindle::spindleDelay(SpindleState state, SpindleSpeed speed) {
-        uint32_t up = 0, down = 0;
+        // The spindle slows from down_from to down_to, then speeds up from up_from to up_to
+        SpindleSpeed down_from = 0, down_to = 0, up_from = 0, up_to = 0;
         switch (state) {
             case SpindleState::Unknown:
                 // Unknown is only used for an initializer value,
@@ -211,69 +283,57 @@ namespace Spindles {
             case SpindleState::Disable:
                 switch (_current_state) {
                     case SpindleState::Unknown:
-                        down = maxSpeed();
+                        down_from = maxSpeed();
                         break;
                     case SpindleState::Disable:
                         break;
                     case SpindleState::Cw:
                     case SpindleState::Ccw:
-                        down = _current_speed;
+                        down_from = _current_speed;
                         break;
                 }
                 break;
             case SpindleState::Cw:
-                switch (_current_state) {
-                    case SpindleState::Unknown:
-                        down = maxSpeed();
-                        // fall through
-                    case SpindleState::Disable:
-                        up = speed;
-                        break;
-                    case SpindleState::Cw:
-                        if (speed > _current_speed) {
-                            up = speed - _current_speed;
-                        } else {
-                            down = _current_speed - speed;
-                        }
-                        break;
-                    case SpindleState::Ccw:
-                        down = _current_speed;
-                        up   = speed;
-                        break;
-                }
-                break;
             case SpindleState::Ccw:
-                switch (_current_state) {
-                    case SpindleState::Unknown:
-                        down = maxSpeed();
-                        // fall through
-                    case SpindleState::Disable:
-                        up = speed;
-                        break;
-                    case SpindleState::Cw:
-                        down = _current_speed;
-                        up   = speed;
-                        break;
-                    case SpindleState::Ccw:
-                        if (speed > _current_speed) {
-                            up = speed - _current_speed;
-                        } else {
-                            down = speed - _current_speed;
-                        }
-                        break;
+                if (_current_state == state) {
+                    if (speed > _current_speed) {
+                        up_from = _current_speed;
+                        up_to   = speed;
+                    } else {
+                        down_from = _current_speed;
+                        down_to   = speed;
+                    }
+                } else {
+                    // Reversing, starting, or starting from an unknown state
+                    switch (_current_state) {
+                        case SpindleState::Unknown:
+                            down_from = maxSpeed();
+                            break;
+                        case SpindleState::Disable:
+                            break;
+                        default:
+                            down_from = _current_speed;
+                            break;
+                    }
+                    up_to = speed;
                 }
                 break;
         }
-        int32_t dwell = 0;
-        if (down) {
-            dwell = (down < maxSpeed() ? _spindown_ms * down / maxSpeed() : _spindown_ms);
+
+        // Motion can resume when the speed is within tolerance of the
+        // target, or at a stop when the spindle has stopped
+        uint32_t tolerance = speed * _speed_tolerance / 100;
+        if (down_from > down_to) {
+            SpindleSpeed near  = (down_to && down_to + tolerance < down_from) ? down_to + tolerance : down_to;
+            uint32_t     dwell = rampTime(_spindown_ms, _spindown_curve, down_from) - rampTime(_spindown_ms, _spindown_curve, near);
             log_debug("Spin down delay ms:" << dwell);
-            dwell_ms((uint32_t)dwell, DwellMode::SysSuspend);
+            rampWait(dwell, down_to, tolerance);
         }
-        if (up) {
-            dwell = (up < maxSpeed() ? _spinup_ms * up / maxSpeed() : _spinup_ms);
+        if (up_to > up_from) {
+            SpindleSpeed near  = up_to > up_from + tolerance ? up_to - tolerance : up_from;
+            uint32_t     dwell = rampTime(_spinup_ms, _spinup_curve, near) - rampTime(_spinup_ms, _spinup_curve, up_from);
             log_debug("Spin up delay ms:" << dwell);
-            dwell_ms((uint32_t)dwell, DwellMode::SysSuspend);
+            rampWait(dwell, up_to, tolerance);
         }
 
         _current_state = state;
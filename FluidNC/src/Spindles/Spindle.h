@@ -12,6 +12,7 @@
 #include "GCode.h"  // MaxToolNumber
 #include "Module.h"
 #include "ToolChangers/atc.h"
+#include "Tachometer.h"
 
 // ===============  No floats! ===========================
 // ================ NO FLOATS! ==========================
@@ -55,8 +56,11 @@ namespace Spindles {
         static void switchSpindle(uint32_t new_tool, SpindleList spindles, Spindle*& spindle, bool& stop_spindle, bool& new_spindle);
 
         void         spindleDelay(SpindleState state, SpindleSpeed speed);
+        uint32_t     rampTime(uint32_t full_ms, const std::vector<float>& curve, SpindleSpeed speed);
+        void         rampWait(uint32_t dwell, SpindleSpeed target, uint32_t tolerance);
         virtual void init() = 0;  // not in constructor because this also gets called when $$ settings change
         virtual void init_atc();
+        void         init_tachometer();
         std::string  atc_info() { return _atc_info; };
 
         // Used by Protocol.cpp to restore the state during a restart
@@ -69,6 +73,9 @@ namespace Spindles {
         virtual tool_t get_current_tool_num() { return _current_tool; }
         virtual bool   tool_change(uint32_t tool_number, bool pre_select, bool set_tool);
 
+        // Cutting load in percent, or -1 if the spindle cannot measure it
+        virtual int32_t load_percent();
+
         virtual void setSpeedfromISR(uint32_t dev_speed) = 0;
 
         void spinDown() { setState(SpindleState::Disable, 0); }
@@ -82,6 +89,19 @@ namespace Spindles {
         uint32_t _spinup_ms   = 0;
         uint32_t _spindown_ms = 0;
 
+        // Measured ramps, in ms between standstill and equally spaced
+        // speeds up to the maximum.  For a spindle that does not ramp
+        // linearly, these replace _spinup_ms and _spindown_ms.
+        std::vector<float> _spinup_curve;
+        std::vector<float> _spindown_curve;
+
+        // A speed change is complete when the modeled speed is within this
+        // percentage of the target
+        uint32_t _speed_tolerance = 0;
+
+        // Measured speed, for spindles that do not report it
+        Tachometer* _tach = nullptr;
+
         int32_t _tool = 0;
 
         std::vector<Configuration::speedEntry> _speeds;
@@ -101,6 +121,9 @@ namespace Spindles {
             if (use_delay_settings()) {
                 handler.item("spinup_ms", _spinup_ms, 0, 60000);
                 handler.item("spindown_ms", _spindown_ms, 0, 60000);
+                handler.item("spinup_curve_ms", _spinup_curve);
+                handler.item("spindown_curve_ms", _spindown_curve);
+                handler.item("speed_tolerance_percent", _speed_tolerance, 0, 50);
             }
             handler.item("tool_num", _tool, 0, MaxToolNumber);
             handler.item("speed_map", _speeds);
@@ -109,6 +132,7 @@ namespace Spindles {
             handler.item("m6_macro", _m6_macro);
             handler.item("s0_with_disable", _zero_speed_with_disable);
             handler.item("disable_with_s0", _disable_with_zero_speed);
+            handler.section("tachometer", _tach);
         }
 
         // Virtual base classes require a virtual destructor.
@@ -0,0 +1,203 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "Tachometer.h"
+
+#include "Spindle.h"
+#include "Config.h"  // SUPPORT_TASK_CORE
+#include "Driver/pulse_counter.h"
+#include "Protocol.h"  // protocol_send_event
+#include "State.h"     // state_is
+
+#include <algorithm>
+
+/*
+
+Spindle:
+  ...
+  tachometer:
+    pulse_pin: gpio.34
+    pulses_per_rev: 2
+    filter_ns: 1000
+    index_pin: gpio.35
+    sample_ms: 100
+    sag_percent: 20
+    sag_ms: 200
+
+*/
+
+namespace Spindles {
+    void Tachometer::init(Spindle* owner) {
+        _owner = owner;
+
+        if (_pulse_pin.defined() && _counter < 0) {
+            _pulse_pin.setAttr(Pin::Attr::Input);
+            _counter = pulse_counter_attach(_pulse_pin.getNative(Pin::Capabilities::Input | Pin::Capabilities::Native), _filter_ns);
+            if (_counter < 0) {
+                log_error("Tachometer: No pulse counter available for " << _pulse_pin.name());
+                return;
+            }
+            _last_count = pulse_counter_read(_counter);
+        }
+
+        if (_index_pin.defined() && _index == INVALID_PINNUM) {
+            _index_pin.setAttr(Pin::Attr::Input);
+            pinnum_t index = _index_pin.getNative(Pin::Capabilities::Input | Pin::Capabilities::ISR | Pin::Capabilities::Native);
+            if (!pulse_index_attach(index)) {
+                log_error("Tachometer: " << _index_pin.name() << " cannot capture index pulses");
+                return;
+            }
+            _index = index;
+        }
+
+        if (!_task) {
+            _last_us = pulse_time_us();
+            xTaskCreatePinnedToCore(tach_task,        // task
+                                    "tachTaskHandle",  // name for task
+                                    2048,              // size of task stack
+                                    this,              // parameters
+                                    1,                 // priority
+                                    &_task,
+                                    SUPPORT_TASK_CORE  // core
+            );
+        }
+        config_message();
+    }
+
+    void Tachometer::config_message() {
+        std::string index = _index_pin.defined() ? std::string(" Index:") + _index_pin.name() : "";
+        if (_pulse_pin.defined()) {
+            log_info("Tachometer Pulse:" << _pulse_pin.name() << " PPR:" << _pulses_per_rev << index);
+        } else {
+            log_info("Tachometer" << index);
+        }
+    }
+
+    void Tachometer::tach_task(void* arg) {
+        auto tach = static_cast<Tachometer*>(arg);
+        while (true) {
+            tach->update();
+            vTaskDelay(tach->_sample_ms / portTICK_PERIOD_MS);
+        }
+    }
+
+    bool Tachometer::index_time(uint64_t& last_us, uint32_t& period_us) {
+        if (_index == INVALID_PINNUM) {
+            return false;
+        }
+        uint64_t previous_us;
+        if (pulse_index_read(_index, last_us, previous_us) < 2) {
+            return false;
+        }
+        period_us = uint32_t(last_us - previous_us);
+        // Without a pulse for two periods the spindle is stopping or stopped
+        return period_us && pulse_time_us() - last_us < 2 * uint64_t(period_us);
+    }
+
+    // The speed change that one pulse per sample represents
+    uint32_t Tachometer::resolution() const {
+        if (!_pulse_pin.defined()) {
+            return 1;
+        }
+        return std::max<uint32_t>(1, 60000 / (_pulses_per_rev * _sample_ms));
+    }
+
+    bool Tachometer::at_speed(SpindleSpeed target, uint32_t tolerance_percent) const {
+        uint32_t rpm       = _rpm;
+        uint32_t tolerance = std::max<uint32_t>(uint64_t(target) * tolerance_percent / 100, resolution());
+        return rpm + tolerance >= target && rpm <= target + tolerance;
+    }
+
+    int32_t Tachometer::load_percent(SpindleSpeed commanded) const {
+        uint32_t rpm = _rpm;
+        if (!commanded) {
+            return -1;
+        }
+        if (rpm >= commanded) {
+            return 0;
+        }
+        // A healthy spindle droops only a few percent, so the droop is scaled
+        // to the load range that adaptive feed targets
+        return int32_t(uint64_t(commanded - rpm) * 100 * 100 / (uint64_t(commanded) * _full_load_droop_percent));
+    }
+
+    void Tachometer::update() {
+        uint64_t now   = pulse_time_us();
+        uint64_t dt_us = now - _last_us;
+        _last_us       = now;
+
+        uint32_t rpm = 0;
+        if (_counter >= 0) {
+            uint32_t count = pulse_counter_read(_counter);
+            uint32_t delta = count - _last_count;
+            _last_count    = count;
+            _pulses += delta;
+            _revolutions = uint32_t(_pulses / _pulses_per_rev);
+            if (dt_us) {
+                rpm = uint32_t(uint64_t(delta) * 60000000 / (dt_us * _pulses_per_rev));
+            }
+        }
+
+        // The index period is exact where the pulse count is quantized, so
+        // it is preferred while the spindle is turning steadily
+        uint64_t last_us;
+        uint32_t period_us;
+        if (index_time(last_us, period_us)) {
+            rpm = 60000000 / period_us;
+        }
+        if (_counter < 0 && _index != INVALID_PINNUM) {
+            uint64_t previous_us;
+            _revolutions = pulse_index_read(_index, last_us, previous_us);
+        }
+
+        _rpm = rpm;
+        check_sag(rpm);
+    }
+
+    // A cutting tool that breaks or jams drags the spindle down; a feed hold
+    // stops the job before the remaining passes are cut without a tool.
+    void Tachometer::check_sag(uint32_t rpm) {
+        SpindleState state = _owner ? _owner->_current_state : SpindleState::Disable;
+        SpindleSpeed speed = _owner ? _owner->_current_speed : 0;
+        if (!_sag_percent || spindle != _owner || (state != SpindleState::Cw && state != SpindleState::Ccw) || !speed) {
+            _watched = 0;
+            return;
+        }
+        if (speed != _watched) {
+            // A new commanded speed; wait for the spindle to get there
+            _watched     = speed;
+            _armed       = false;
+            _tripped     = false;
+            _sag_elapsed = 0;
+        }
+        if (!_armed) {
+            _armed = at_speed(speed, _sag_percent / 2);
+            return;
+        }
+        if (uint64_t(rpm) * 100 >= uint64_t(speed) * (100 - _sag_percent)) {
+            _sag_elapsed = 0;
+            return;
+        }
+        _sag_elapsed += _sample_ms;
+        if (_sag_elapsed >= _sag_ms && !_tripped && state_is(State::Cycle)) {
+            _tripped = true;
+            log_error("Tachometer: Spindle speed " << rpm << " is more than " << _sag_percent << "% below " << speed << "; check the tool");
+            protocol_send_event(&feedHoldEvent);
+        }
+    }
+
+    void Tachometer::validate() {
+        Assert(_pulse_pin.defined() || _index_pin.defined(), "Tachometer: needs pulse_pin or index_pin");
+    }
+
+    void Tachometer::group(Configuration::HandlerBase& handler) {
+        handler.item("pulse_pin", _pulse_pin);
+        handler.item("pulses_per_rev", _pulses_per_rev, 1, 10000);
+        handler.item("filter_ns", _filter_ns, 0, 12000);
+        handler.item("index_pin", _index_pin);
+        handler.item("sample_ms", _sample_ms, 10, 1000);
+        handler.item("sag_percent", _sag_percent, 0, 90);
+        handler.item("sag_ms", _sag_ms, 0, 10000);
+        handler.item("full_load_droop_percent", _full_load_droop_percent, 1, 100);
+    }
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include "Configuration/Configurable.h"
+#include "Pin.h"
+#include "SpindleDatatypes.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <atomic>
+#include <cstdint>
+
+namespace Spindles {
+    class Spindle;
+
+    // Measured spindle speed, for spindles that cannot report it themselves.
+    // Pulses from a hall sensor, slotted disk or encoder on pulse_pin are
+    // counted in hardware and converted to RPM every sample_ms.  An optional
+    // once-per-revolution index_pin has the time of each edge captured, which
+    // gives the speed with one revolution of latency and the spindle angle
+    // for speed-synchronized motion.
+    //
+    // With sag_percent set, a drop in speed below the commanded speed while
+    // the spindle is cutting, e.g. from a broken or jammed tool, starts a
+    // feed hold.
+    class Tachometer : public Configuration::Configurable {
+    public:
+        Tachometer() = default;
+
+        Tachometer(const Tachometer&)            = delete;
+        Tachometer(Tachometer&&)                 = delete;
+        Tachometer& operator=(const Tachometer&) = delete;
+        Tachometer& operator=(Tachometer&&)      = delete;
+
+        void init(Spindle* owner);
+        void config_message();
+
+        uint32_t rpm() const { return _rpm; }
+
+        // Whole revolutions counted since init
+        uint32_t revolutions() const { return _revolutions; }
+
+        // The time of the last index pulse and the period of the revolution
+        // before it, on the pulse_time_us() clock.  Returns false without an
+        // index pin or when the spindle is stopped.
+        bool index_time(uint64_t& last_us, uint32_t& period_us);
+
+        // True if the measured speed is within tolerance_percent of target,
+        // or within sample resolution of 0 when target is 0
+        bool at_speed(SpindleSpeed target, uint32_t tolerance_percent) const;
+
+        // The measured speed's shortfall from commanded, as a measure of
+        // cutting load: 100% at full_load_droop_percent of droop.  -1 if the
+        // spindle is not commanded to turn.
+        int32_t load_percent(SpindleSpeed commanded) const;
+
+        uint32_t sample_ms() const { return _sample_ms; }
+
+        // Configuration handlers:
+        void validate() override;
+        void group(Configuration::HandlerBase& handler) override;
+
+        ~Tachometer() = default;
+
+    private:
+        static void tach_task(void* arg);
+
+        void     update();
+        void     check_sag(uint32_t rpm);
+        uint32_t resolution() const;
+
+        Pin      _pulse_pin;
+        uint32_t _pulses_per_rev = 1;
+        uint32_t _filter_ns      = 1000;  // Pulses shorter than this are noise
+        Pin      _index_pin;
+        uint32_t _sample_ms   = 100;
+        uint32_t _sag_percent = 0;  // 0 disables tool-break detection
+        uint32_t _sag_ms      = 200;
+
+        uint32_t _full_load_droop_percent = 10;  // Droop read as 100% load
+
+        Spindle*     _owner   = nullptr;
+        int32_t      _counter = -1;
+        pinnum_t     _index   = INVALID_PINNUM;
+        TaskHandle_t _task    = nullptr;
+
+        std::atomic<uint32_t> _rpm { 0 };
+        std::atomic<uint32_t> _revolutions { 0 };
+        uint64_t              _pulses     = 0;
+        uint32_t              _last_count = 0;
+        uint64_t              _last_us    = 0;
+
+        // Sag detection state, armed once the commanded speed is reached
+        SpindleSpeed _watched     = 0;
+        bool         _armed       = false;
+        bool         _tripped     = false;
+        uint32_t     _sag_elapsed = 0;
+    };
+}
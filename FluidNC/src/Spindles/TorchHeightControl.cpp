@@ -0,0 +1,221 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "TorchHeightControl.h"
+
+#include "Machine/MachineConfig.h"
+#include "Driver/fluidnc_adc.h"
+#include "Stepper.h"  // Stepper::enable_offset
+
+#include <cmath>
+#include <cstdlib>
+
+/*
+
+PlasmaSpindle:
+  ...
+  thc:
+    adc_pin: gpio.36
+    divider_ratio: 50
+    target_volts: 120
+    kp: 0.1
+    delay_ms: 500
+    max_offset_mm: 10
+    max_rate_mm_per_s: 10
+    velocity_percent: 90
+    kerf_volts_per_ms: 2
+    kerf_hold_ms: 100
+
+*/
+
+namespace Spindles {
+    void TorchHeightControl::init() {
+        if (_uart_num != -1) {
+            _uart = config->_uarts[_uart_num];
+            if (!_uart) {
+                log_error("THC: Missing uart" << _uart_num << " section");
+                return;
+            }
+        }
+
+        if (_adc_pin.defined()) {
+            _adc_pin.setAttr(Pin::Attr::Input);
+            _adc_native = _adc_pin.getNative(Pin::Capabilities::Input | Pin::Capabilities::ADC | Pin::Capabilities::Native);
+            if (!adc_attach(_adc_native)) {
+                log_error("THC: " << _adc_pin.name() << " cannot be used with WiFi running; use an ADC1 pin");
+                return;
+            }
+        }
+
+        auto z = Axes::_axis[Z_AXIS];
+        if (Axes::_numberAxis <= Z_AXIS || !z) {
+            log_error("THC: Requires a Z axis");
+            return;
+        }
+        _steps_per_mm = z->_stepsPerMm;
+
+        if (!_task) {
+            // Higher priority than the other support tasks, so the loop runs every tick
+            xTaskCreatePinnedToCore(thc_task,        // task
+                                    "thcTaskHandle",  // name for task
+                                    3072,             // size of task stack
+                                    this,             // parameters
+                                    2,                // priority
+                                    &_task,
+                                    SUPPORT_TASK_CORE  // core
+            );
+        }
+        config_message();
+    }
+
+    void TorchHeightControl::config_message() {
+        if (_uart) {
+            _uart->config_message("THC", " Arc voltage");
+        } else {
+            log_info("THC Arc voltage:" << _adc_pin.name() << " Divider:" << _divider_ratio << " Target:" << _target_volts << "V");
+        }
+    }
+
+    void TorchHeightControl::thc_task(void* arg) {
+        auto thc = static_cast<TorchHeightControl*>(arg);
+        while (true) {
+            thc->update();
+            vTaskDelay(1);
+        }
+    }
+
+    bool TorchHeightControl::sample(float& volts) {
+        if (_adc_native != INVALID_PINNUM) {
+            uint32_t mv = 0;
+            for (uint32_t i = 0; i < _oversample; i++) {
+                mv += adc_read_mv(_adc_native);
+            }
+            volts = mv * _divider_ratio / (1000.0f * _oversample);
+            return true;
+        }
+        if (!_uart) {
+            return false;
+        }
+
+        // The divider board sends one voltage per line, e.g. "123.4"
+        bool got = false;
+        while (_uart->available()) {
+            int c = _uart->read();
+            if (c == '\r' || c == '\n') {
+                if (_line_len) {
+                    _line[_line_len] = '\0';
+                    char* end;
+                    float v = strtof(_line, &end);
+                    if (end != _line) {
+                        volts = v;
+                        got   = true;
+                    }
+                    _line_len = 0;
+                }
+            } else if (_line_len < sizeof(_line) - 1) {
+                _line[_line_len++] = c;
+            }
+        }
+        return got;
+    }
+
+    void TorchHeightControl::update() {
+        float volts;
+        if (!sample(volts)) {
+            return;
+        }
+        uint32_t now     = get_ms();
+        uint32_t elapsed = now - _sample_ms;
+        float    change  = volts - _volts;
+        _sample_ms       = now;
+        _volts           = volts;
+
+        if (!_running || elapsed == 0) {
+            return;
+        }
+
+        // A jump in voltage means the torch is crossing a kerf, not that the height changed
+        if (fabsf(change) > _kerf_volts_per_ms * elapsed) {
+            _hold_ms = now + _kerf_hold_ms;
+        }
+
+        // The arc voltage rises as the torch slows down for a corner
+        float nominal   = Stepper::get_nominal_rate();
+        bool  too_slow  = nominal == 0.0f || Stepper::get_realtime_rate() < nominal * _velocity_percent / 100.0f;
+        bool  settling  = int32_t(now - _start_ms) < int32_t(_delay_ms);
+        bool  kerf_hold = int32_t(now - _hold_ms) < 0;
+        if (too_slow || settling || kerf_hold) {
+            _have_error = false;
+            return;
+        }
+
+        float dt    = elapsed / 1000.0f;
+        float error = _volts - _target_volts;  // Positive when the torch is too high
+        _integral += error * dt;
+        if (_ki > 0.0f) {
+            // Keep the integral term from winding up past the rate limit
+            float limit = _max_rate_mm_per_s / _ki;
+            _integral   = std::min(std::max(_integral, -limit), limit);
+        }
+        float derivative = _have_error ? (error - _last_error) / dt : 0.0f;
+        _last_error      = error;
+        _have_error      = true;
+
+        float rate = -(_kp * error + _ki * _integral + _kd * derivative);
+        rate       = std::min(std::max(rate, -_max_rate_mm_per_s), _max_rate_mm_per_s);
+        _offset_mm = std::min(std::max(_offset_mm + rate * dt, -_max_offset_mm), _max_offset_mm);
+        Stepper::set_offset_target(lroundf(_offset_mm * _steps_per_mm));
+    }
+
+    void TorchHeightControl::start() {
+        if (_steps_per_mm == 0.0f) {
+            return;
+        }
+        _integral   = 0.0f;
+        _have_error = false;
+        _offset_mm  = 0.0f;
+        _start_ms   = get_ms();
+        _hold_ms    = _start_ms;
+        Stepper::enable_offset(Z_AXIS, uint32_t(_max_rate_mm_per_s * _steps_per_mm));
+        _running = true;
+    }
+
+    void TorchHeightControl::stop() {
+        if (!_running) {
+            return;
+        }
+        _running      = false;
+        int32_t steps = Stepper::get_offset();
+        Stepper::disable_offset();
+
+        // The offset steps are already in the machine position.  If the planner
+        // is empty, as it is after M5, the planner and parser catch up so the
+        // next cut starts from the programmed heights.  Otherwise, e.g. when a
+        // safety door stops the torch mid-cut, the offset is carried until the
+        // cycle stop that ends the queued motion, or a reset.
+        Stepper::sync_offset();
+        log_debug("THC: Z offset " << steps / _steps_per_mm << "mm");
+    }
+
+    void TorchHeightControl::validate() {
+        Assert(_adc_pin.defined() || _uart_num != -1, "THC: needs adc_pin or uart_num");
+        Assert(!(_adc_pin.defined() && _uart_num != -1), "THC: use either adc_pin or uart_num, not both");
+    }
+
+    void TorchHeightControl::group(Configuration::HandlerBase& handler) {
+        handler.item("adc_pin", _adc_pin);
+        handler.item("divider_ratio", _divider_ratio, 1.0f, 1000.0f);
+        handler.item("oversample", _oversample, 1, 64);
+        handler.item("uart_num", _uart_num);
+        handler.item("target_volts", _target_volts, 0.0f, 500.0f);
+        handler.item("kp", _kp, 0.0f, 100.0f);
+        handler.item("ki", _ki, 0.0f, 100.0f);
+        handler.item("kd", _kd, 0.0f, 100.0f);
+        handler.item("delay_ms", _delay_ms, 0, 10000);
+        handler.item("max_offset_mm", _max_offset_mm, 0.0f, 100.0f);
+        handler.item("max_rate_mm_per_s", _max_rate_mm_per_s, 0.0f, 100.0f);
+        handler.item("velocity_percent", _velocity_percent, 0, 100);
+        handler.item("kerf_volts_per_ms", _kerf_volts_per_ms, 0.0f, 100.0f);
+        handler.item("kerf_hold_ms", _kerf_hold_ms, 0, 10000);
+    }
+}
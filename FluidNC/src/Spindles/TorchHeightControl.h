@@ -0,0 +1,93 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include "Configuration/Configurable.h"
+#include "Pin.h"
+#include "Uart.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <cstdint>
+
+namespace Spindles {
+    // Torch height control for PlasmaSpindle.  The arc voltage is sampled
+    // from an ADC pin behind a voltage divider, or read from a divider board
+    // that sends the voltage as lines of text on a UART.  While the arc is on,
+    // a PID loop raises or lowers Z to hold the voltage at target_volts.  The
+    // correction is applied as a step-level offset in the stepper ISR, so the
+    // planned motion is never replanned.
+    //
+    // Two things change the arc voltage without a change in height, so the
+    // correction is held while they happen:
+    //  - slowing down for a corner, detected when the executing speed falls
+    //    below velocity_percent of the block's nominal speed
+    //  - crossing an existing kerf, detected when the voltage changes faster
+    //    than kerf_volts_per_ms
+    class TorchHeightControl : public Configuration::Configurable {
+    public:
+        TorchHeightControl() = default;
+
+        TorchHeightControl(const TorchHeightControl&)            = delete;
+        TorchHeightControl(TorchHeightControl&&)                 = delete;
+        TorchHeightControl& operator=(const TorchHeightControl&) = delete;
+        TorchHeightControl& operator=(TorchHeightControl&&)      = delete;
+
+        void init();
+        void config_message();
+
+        // Called when arc OK is established
+        void start();
+        // Called after motion has stopped and the arc is off.  The correction
+        // becomes part of the machine position.
+        void stop();
+
+        float voltage() const { return _volts; }
+
+        // Configuration handlers:
+        void validate() override;
+        void group(Configuration::HandlerBase& handler) override;
+
+        ~TorchHeightControl() = default;
+
+    private:
+        static void thc_task(void* arg);
+
+        bool sample(float& volts);
+        void update();
+
+        Pin      _adc_pin;
+        float    _divider_ratio = 50.0f;  // Arc volts per volt at the ADC pin
+        uint32_t _oversample    = 8;      // ADC reads averaged per control period
+        Uart*    _uart          = nullptr;
+        int32_t  _uart_num      = -1;
+
+        float    _target_volts      = 120.0f;
+        float    _kp                = 0.1f;  // mm/sec per volt of error
+        float    _ki                = 0.0f;
+        float    _kd                = 0.0f;
+        uint32_t _delay_ms          = 500;  // Settling time after arc OK before correcting
+        float    _max_offset_mm     = 10.0f;
+        float    _max_rate_mm_per_s = 10.0f;
+        uint32_t _velocity_percent  = 90;
+        float    _kerf_volts_per_ms = 2.0f;
+        uint32_t _kerf_hold_ms      = 100;
+
+        pinnum_t     _adc_native = INVALID_PINNUM;
+        TaskHandle_t _task       = nullptr;
+        char         _line[16];
+        size_t       _line_len = 0;
+
+        volatile bool _running      = false;
+        uint32_t      _start_ms     = 0;
+        uint32_t      _sample_ms    = 0;
+        uint32_t      _hold_ms      = 0;
+        float         _volts        = 0.0f;
+        float         _integral     = 0.0f;
+        float         _last_error   = 0.0f;
+        bool          _have_error   = false;
+        float         _offset_mm    = 0.0f;
+        float         _steps_per_mm = 0.0f;
+    };
+}
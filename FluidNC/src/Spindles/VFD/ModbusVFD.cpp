@@ -128,6 +128,16 @@ namespace Spindles {
                     continue;
                 }
 
+                // handle load keyword, scaled to percent of full load
+                uint32_t load;
+                if (set_data(token, response_view, "load", load, _is_rx_big_endian)) {
+                    if (spindle->_debug > 1) {
+                        log_info("Current load is " << int(load) << "%");
+                    }
+                    spindle->_load_percent = load;
+                    continue;
+                }
+
                 // bypass 'ignore' keywords
                 uint32_t ignore;
                 if (set_data(token, response_view, "ignore", ignore, _is_rx_big_endian)) {
@@ -272,6 +282,17 @@ namespace Spindles {
             };
         }
 
+        VFDProtocol::response_parser ModbusVFD::get_current_load(ModbusCommand& data) {
+            if (_get_load_cmd.empty()) {
+                return nullptr;
+            }
+            send_vfd_command(_get_load_cmd, data, 0);
+            return [](const uint8_t* response, VFDSpindle* spindle, VFDProtocol* protocol) -> bool {
+                auto instance = static_cast<ModbusVFD*>(protocol);
+                return instance->parser(response, spindle, instance);
+            };
+        }
+
         VFDProtocol::response_parser ModbusVFD::initialization_sequence(int index, ModbusCommand& data, VFDSpindle* vfd) {
             // BUG:
             //
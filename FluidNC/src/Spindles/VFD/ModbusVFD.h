@@ -25,6 +25,7 @@ namespace Spindles {
             response_parser initialization_sequence(int index, ModbusCommand& data, VFDSpindle* vfd) override;
             response_parser get_current_speed(ModbusCommand& data) override;
             response_parser get_current_direction(ModbusCommand& data) override { return nullptr; };
+            response_parser get_current_load(ModbusCommand& data) override;
             response_parser get_status_ok(ModbusCommand& data) override { return nullptr; }
 
             std::string _cw_cmd;
@@ -34,6 +35,7 @@ namespace Spindles {
             std::string _get_min_rpm_cmd;
             std::string _get_max_rpm_cmd;
             std::string _get_rpm_cmd;
+            std::string _get_load_cmd;
 
             bool use_delay_settings() const override { return _get_rpm_cmd.empty(); }
             bool safety_polling() const override { return false; }
@@ -77,6 +79,7 @@ namespace Spindles {
                 handler.item("get_min_rpm_cmd", _get_min_rpm_cmd);
                 handler.item("get_max_rpm_cmd", _get_max_rpm_cmd);
                 handler.item("get_rpm_cmd", _get_rpm_cmd);
+                handler.item("get_load_cmd", _get_load_cmd);
             }
         };
     }
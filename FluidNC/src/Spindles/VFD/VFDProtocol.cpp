@@ -2,6 +2,7 @@
 
 #include "Spindles/VFDSpindle.h"
 #include "MotionControl.h"  // mc_critical
+#include "TaskProfiler.h"   // ProfileRun
 
 #include <freertos/task.h>
 #include <freertos/queue.h>
@@ -54,7 +55,9 @@ namespace Spindles {
             uint8_t       rx_message[VFD_RS485_MAX_MSG_SIZE];
             bool          safetyPollingEnabled = impl->safety_polling();
 
+            ProfileSlot profile = profile_task(ProfiledTask::Vfd);
             for (; true; delay_ms(instance->_poll_ms)) {
+                ProfileRun run(profile);
                 std::atomic_thread_fence(std::memory_order_seq_cst);  // read fence for settings
                 response_parser parser = nullptr;
 
@@ -114,6 +117,14 @@ namespace Spindles {
                                     // fall through if get_current_direction did not return a parser
                                     [[fallthrough]];
                                 case 3:
+                                    parser = impl->get_current_load(cmd);
+                                    if (parser) {
+                                        pollidx = 4;
+                                        break;
+                                    }
+                                    // fall through if get_current_load did not return a parser
+                                    [[fallthrough]];
+                                case 4:
                                 default:
                                     parser  = impl->get_status_ok(cmd);
                                     pollidx = 1;
@@ -122,6 +133,9 @@ namespace Spindles {
                                     // just keep it easy and wait an iteration.
                                     break;
                             }
+                        } else {
+                            // Without safety polling, only the load is polled, if the VFD reports it
+                            parser = impl->get_current_load(cmd);
                         }
 
                         // If we have no parser, that means get_status_ok is not implemented (and we have
@@ -38,6 +38,7 @@ namespace Spindles {
             virtual response_parser initialization_sequence(int index, ModbusCommand& data, VFDSpindle* vfd) { return nullptr; }
             virtual response_parser get_current_speed(ModbusCommand& data) { return nullptr; }
             virtual response_parser get_current_direction(ModbusCommand& data) { return nullptr; }
+            virtual response_parser get_current_load(ModbusCommand& data) { return nullptr; }
             virtual response_parser get_status_ok(ModbusCommand& data) = 0;
             virtual bool            safety_polling() const { return true; }
 
@@ -59,6 +59,11 @@ namespace Spindles {
         uint32_t     _sync_dev_speed;
         SpindleSpeed _slop;
 
+        // Set by protocols that can read the motor current or load
+        volatile int32_t _load_percent = -1;
+
+        int32_t load_percent() override { return _load_percent >= 0 ? _load_percent : Spindle::load_percent(); }
+
         // Configuration handlers:
         void validate() override;
         void afterParse() override;
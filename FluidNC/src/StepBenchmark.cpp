@@ -0,0 +1,166 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "StepBenchmark.h"
+
+#include "StepTiming.h"
+#include "Stepping.h"
+#include "Planner.h"       // plan_buffer_line(), plan_sync_position()
+#include "Protocol.h"      // cycleStartEvent, protocol_execute_realtime()
+#include "GCode.h"         // gc_sync_position()
+#include "State.h"         // state_is()
+#include "TaskProfiler.h"  // profile_stats()
+#include "Machine/MachineConfig.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+// Axes whose real motors all take step pulses.  A servo follows the axis
+// position by itself, so blocking its steps would not hold it still.
+static AxisMask stepping_axes() {
+    auto     axes = config->_axes;
+    AxisMask mask = 0;
+    for (axis_t axis = X_AXIS; axis < axes->_numberAxis; axis++) {
+        auto a = axes->_axis[axis];
+        if (!a) {
+            continue;
+        }
+        bool stepping = true;
+        for (motor_t motor = 0; motor < Axis::MAX_MOTORS_PER_AXIS; motor++) {
+            auto m = a->_motors[motor];
+            if (m && m->isReal() && !Stepping::isStepping(axis, motor)) {
+                stepping = false;
+            }
+        }
+        if (stepping) {
+            set_bitnum(mask, axis);
+        }
+    }
+    return mask;
+}
+
+static void block_motors(AxisMask axes, bool blocked) {
+    for (axis_t axis = X_AXIS; axis < Axes::_numberAxis; axis++) {
+        if (bitnum_is_true(axes, axis)) {
+            for (motor_t motor = 0; motor < Axis::MAX_MOTORS_PER_AXIS; motor++) {
+                if (blocked) {
+                    Stepping::block(axis, motor);
+                } else {
+                    Stepping::unblock(axis, motor);
+                }
+            }
+        }
+    }
+}
+
+// Runs one profile: a rapid move of the given number of steps on the axes
+// in step_mask, and back.  The planner, step segments, step timer and
+// stepper ISR all run as in a job.  The moves are planned as jogs, so that
+// motion sync does not send them to a follower.  Returns false if a reset
+// stopped the profile.
+static bool run(StepTiming& timing, uint32_t pulses, AxisMask step_mask) {
+    plan_sync_position();
+    steps_t start[MAX_N_AXIS];
+    get_steps(start);
+
+    float forward[MAX_N_AXIS];
+    float back[MAX_N_AXIS];
+    for (axis_t axis = X_AXIS; axis < Axes::_numberAxis; axis++) {
+        steps_t delta = bitnum_is_true(step_mask, axis) ? steps_t(pulses) : 0;
+        forward[axis] = steps_to_motor_pos(start[axis] + delta, axis);
+        back[axis]    = steps_to_motor_pos(start[axis], axis);
+    }
+
+    plan_line_data_t pl_data   = {};
+    pl_data.motion.rapidMotion = 1;
+    pl_data.is_jog             = true;
+    pl_data.limits_checked     = true;  // The motors are blocked, so nothing moves
+    plan_line_data_t pl_back   = pl_data;
+
+    profile_reset(ProfiledTask::StepperIsr);
+    int64_t start_us = profile_uptime_us();
+    plan_buffer_line(forward, &pl_data);
+    plan_buffer_line(back, &pl_back);
+    protocol_send_event(&cycleStartEvent);
+    do {
+        protocol_execute_realtime();
+        if (sys.abort()) {
+            return false;
+        }
+    } while (!state_is(State::Idle));
+
+    auto stats = profile_stats(ProfiledTask::StepperIsr);
+    timing.set(stats.runs, stats.busy_ticks, stats.max_ticks, uint32_t(profile_uptime_us() - start_us));
+    return true;
+}
+
+static std::string fixed(float value) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%.2f", value);
+    return buf;
+}
+
+static std::string column(const std::string& text, size_t width) {
+    return text.length() >= width ? text + " " : text + std::string(width - text.length(), ' ');
+}
+
+static void report_row(Channel& out, const std::string& profile, const StepTiming& timing, uint32_t pulses, uint32_t rated) {
+    uint32_t step_rate = timing.elapsed_us() ? uint32_t(uint64_t(pulses) * 2 * 1000000 / timing.elapsed_us()) : 0;
+
+    std::string row = column(profile, 10);
+    row += column(std::to_string(step_rate), 10);
+    row += column(std::to_string(timing.run_rate()), 10);
+    row += column(fixed(timing.mean_us()), 9);
+    row += column(fixed(timing.max_us()), 9);
+    row += column(fixed(timing.load()), 8);
+    row += std::to_string(std::min(timing.worst_rate(), rated));
+    log_stream(out, row);
+}
+
+void step_benchmark(Channel& out, uint32_t pulses) {
+    auto n_axis = Axes::_numberAxis;
+    if (!n_axis) {
+        log_stream(out, "No axes are configured");
+        return;
+    }
+    AxisMask axes = stepping_axes();
+    if (!axes) {
+        log_stream(out, "Every axis has a motor that does not take step pulses, so none can be held still");
+        return;
+    }
+    for (axis_t axis = X_AXIS; axis < n_axis; axis++) {
+        if (!bitnum_is_true(axes, axis)) {
+            log_stream(out, Axes::axisName(axis) << " is skipped because it has a motor that does not take step pulses");
+        }
+    }
+
+    uint32_t rated = Stepping::maxPulsesPerSec();
+    log_stream(out,
+               "Engine:" << Stepping::engineName() << " Pulse:" << Stepping::_pulseUsecs << "us Dir Delay:" << Stepping::_directionDelayUsecs
+                         << "us Rated:" << rated << "/s Pulses:" << pulses);
+    log_stream(out, "Axes      Steps/s   ISR/s     Mean us  Max us   Load%   Ceiling/s");
+
+    // Step pulses for blocked motors are never issued, so the machine stays
+    // still even when a driver has no enable pin
+    block_motors(axes, true);
+
+    StepTiming timing(profile_ticks_per_us());
+    AxisMask   step_mask = 0;
+    size_t     n_stepped = 0;
+    for (axis_t axis = X_AXIS; axis < n_axis; axis++) {
+        if (!bitnum_is_true(axes, axis)) {
+            continue;
+        }
+        set_bitnum(step_mask, axis);
+        if (!run(timing, pulses, step_mask)) {
+            break;
+        }
+        report_row(out, std::to_string(++n_stepped), timing, pulses, rated);
+    }
+
+    block_motors(axes, false);
+    plan_sync_position();
+    gc_sync_position();
+    protocol_disable_steppers();
+}
@@ -0,0 +1,16 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include "Channel.h"
+
+#include <cstdint>
+
+// $Stepping/Benchmark runs synthetic moves through the planner, the step
+// segments, the step timer and the stepper ISR of the configured engine, on
+// 1, 2, ... axes, and reports the ISR rate, the time each ISR took, the CPU
+// load and the pulse rate that the worst time allows.  Every motor is
+// blocked, so no step pulses go out.  Each profile moves forward and back
+// by the same number of steps.
+void step_benchmark(Channel& out, uint32_t pulses);
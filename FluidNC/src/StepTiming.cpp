@@ -0,0 +1,39 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "StepTiming.h"
+
+void StepTiming::set(uint32_t runs, uint64_t busy_ticks, uint32_t max_ticks, uint32_t elapsed_us) {
+    _count      = runs;
+    _sum        = busy_ticks;
+    _max        = max_ticks;
+    _elapsed_us = elapsed_us;
+}
+
+float StepTiming::mean_us() const {
+    return _count ? float(_sum) / _count / _ticks_per_us : 0.0f;
+}
+
+float StepTiming::max_us() const {
+    return float(_max) / _ticks_per_us;
+}
+
+float StepTiming::load() const {
+    return _elapsed_us ? 100.0f * _sum / _ticks_per_us / _elapsed_us : 0.0f;
+}
+
+uint32_t StepTiming::run_rate() const {
+    return _elapsed_us ? uint32_t(uint64_t(_count) * 1000000 / _elapsed_us) : 0;
+}
+
+uint32_t StepTiming::rate(float us) const {
+    return us > 0.0f ? uint32_t(1000000.0f / us) : 0;
+}
+
+uint32_t StepTiming::mean_rate() const {
+    return rate(mean_us());
+}
+
+uint32_t StepTiming::worst_rate() const {
+    return rate(max_us());
+}
@@ -0,0 +1,37 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+
+// Statistics of the stepper ISR over one $Stepping/Benchmark profile, from
+// its run count, total and longest run in CPU ticks, and the time that the
+// profile took.  The rates are the most ISRs per second that the CPU could
+// run if every one took the mean or the worst time.
+class StepTiming {
+public:
+    explicit StepTiming(uint32_t ticks_per_us) : _ticks_per_us(ticks_per_us ? ticks_per_us : 1) {}
+
+    void set(uint32_t runs, uint64_t busy_ticks, uint32_t max_ticks, uint32_t elapsed_us);
+
+    uint32_t count() const { return _count; }
+    uint32_t elapsed_us() const { return _elapsed_us; }
+
+    float mean_us() const;
+    float max_us() const;
+    float load() const;  // Percentage of the elapsed time spent in the ISR
+
+    uint32_t run_rate() const;  // ISRs per second over the elapsed time
+    uint32_t mean_rate() const;
+    uint32_t worst_rate() const;
+
+private:
+    uint32_t _ticks_per_us;
+    uint32_t _count      = 0;
+    uint64_t _sum        = 0;
+    uint32_t _max        = 0;
+    uint32_t _elapsed_us = 0;
+
+    uint32_t rate(float us) const;
+};
@@ -7,6 +7,9 @@
   Stepper.cpp - stepper motor driver: executes motion plans using stepper motors
 */
 
+// Debug logging here would change the step timing, so it is compiled out; see Logging.h
+#define LOG_HOT_PATH
+
 #include "Stepper.h"
 
 #include "Machine/MachineConfig.h"
@@ -15,6 +18,9 @@
 #include "StepperPrivate.h"
 #include "Planner.h"
 #include "Protocol.h"
+#include "GCode.h"         // gc_sync_position
+#include "BufferTuner.h"   // tuner_block_done
+#include "TaskProfiler.h"  // ProfileRun
 #include <cmath>
 
 using namespace Stepper;
@@ -32,6 +38,8 @@ struct st_block_t {
     uint32_t step_event_count;
     AxisMask direction_bits;
     bool     is_pwm_rate_adjusted;  // Tracks motions that require constant laser power/rate
+    bool     arm_probe;             // Copied from the planner block's motion.armProbe
+    bool     guard_probe;           // Copied from the planner block's motion.guardProbe
 };
 static volatile st_block_t* st_block_buffer = nullptr;
 
@@ -77,6 +85,14 @@ typedef struct {
 } stepper_t;
 static stepper_t st;
 
+// Step-level axis offset, e.g. for torch height control
+static volatile axis_t   offset_axis     = INVALID_AXIS;
+static volatile int32_t  offset_target   = 0;
+static volatile int32_t  offset_steps    = 0;
+static volatile uint32_t offset_period   = 0;      // Least timer ticks between offset steps
+static volatile uint32_t offset_ticks    = 0;      // Timer ticks since the last offset step
+static bool              offset_unsynced = false;  // Offset steps not yet in the planner and parser positions
+
 // Step segment ring buffer indices
 static volatile uint32_t segment_buffer_tail;
 static volatile uint32_t segment_buffer_head;
@@ -191,6 +207,7 @@ uint32_t Stepper::isr_count;  // for debugging only
  * Returns true if step interrupts should continue
  */
 bool IRAM_ATTR Stepper::pulse_func() {
+    ProfileRun run(ProfiledTask::StepperIsr);
 #ifdef DEBUG_STEPPER_ISR
     isr_count++;
 #endif
@@ -211,6 +228,7 @@ bool IRAM_ATTR Stepper::pulse_func() {
             st.exec_segment = &segment_buffer[segment_buffer_tail];
             // Initialize step segment timing per step and load number of steps to execute.
             Stepping::setTimerPeriod(st.exec_segment->isrPeriod);
+            Stepping::nextSegment();
             st.step_count = st.exec_segment->n_step;  // NOTE: Can sometimes be zero when moving slow.
             // If the new segment starts a new planner block, initialize stepper variables and counters.
             // NOTE: When the segment data index changes, this indicates a new planner block.
@@ -221,6 +239,12 @@ bool IRAM_ATTR Stepper::pulse_func() {
                 for (axis_t axis = X_AXIS; axis < n_axis; axis++) {
                     st.counter[axis] = st.exec_block->step_event_count >> 1;
                 }
+                if (st.exec_block->arm_probe) {
+                    probe_block_started = true;
+                }
+                if (st.exec_block->guard_probe) {
+                    probe_guard_started = true;
+                }
             }
 
             st.dir_outbits = st.exec_block->direction_bits;
@@ -256,6 +280,26 @@ bool IRAM_ATTR Stepper::pulse_func() {
         }
     }
 
+    // Interleave offset steps with the planned steps when the block does not move the offset axis,
+    // no faster than the offset's rate limit
+    axis_t oaxis = offset_axis;
+    if (oaxis != INVALID_AXIS) {
+        if (offset_ticks < offset_period) {
+            offset_ticks = offset_ticks + st.exec_segment->isrPeriod;
+        }
+        if (st.steps[oaxis] == 0 && offset_steps != offset_target && offset_ticks >= offset_period) {
+            offset_ticks = offset_ticks - offset_period;
+            set_bitnum(st.step_outbits, oaxis);
+            if (offset_target > offset_steps) {
+                clear_bitnum(st.dir_outbits, oaxis);
+                offset_steps = offset_steps + 1;
+            } else {
+                set_bitnum(st.dir_outbits, oaxis);
+                offset_steps = offset_steps - 1;
+            }
+        }
+    }
+
     st.step_count--;  // Decrement step events count
     if (st.step_count == 0) {
         // Segment is complete. Discard current segment and advance segment indexing.
@@ -294,6 +338,8 @@ void Stepper::reset() {
     Stepping::reset();
 
     go_idle();
+    disable_offset();
+    offset_unsynced = false;  // The callers of reset resync the positions
 
     // Initialize stepper algorithm variables.
     memset(&prep, 0, sizeof(st_prep_t));
@@ -416,6 +462,8 @@ void Stepper::prep_buffer() {
                     st_prep_block->steps[axis] = pl_block->steps[axis] << maxAmassLevel;
                 }
                 st_prep_block->step_event_count = pl_block->step_event_count << maxAmassLevel;
+                st_prep_block->arm_probe        = pl_block->motion.armProbe;
+                st_prep_block->guard_probe      = pl_block->motion.guardProbe;
 
                 // Initialize segment buffer data for generating the segments.
                 prep.steps_remaining  = (float)pl_block->step_event_count;
@@ -437,7 +485,7 @@ void Stepper::prep_buffer() {
                 if (spindle->isRateAdjusted()) {
                     if (pl_block->spindle == SpindleState::Ccw) {
                         // Pre-compute inverse programmed rate to speed up PWM updating per step segment.
-                        prep.inv_rate                       = 1.0f / pl_block->programmed_rate;
+                        prep.inv_rate                       = 1.0f / plan_get_programmed_rate(pl_block);
                         st_prep_block->is_pwm_rate_adjusted = true;
                     }
                 }
@@ -757,6 +805,7 @@ void Stepper::prep_buffer() {
                 }
                 pl_block = NULL;  // Set pointer to indicate check and load next planner block.
                 plan_discard_current_block();
+                tuner_block_done();
             }
         }
     }
@@ -766,6 +815,47 @@ void Stepper::prep_buffer() {
 // however is not exactly the current speed, but the speed computed in the last step segment
 // in the segment buffer. It will always be behind by up to the number of segment blocks (-1)
 // divided by the ACCELERATION TICKS PER SECOND in seconds.
+float Stepper::get_nominal_rate() {
+    plan_block_t* block = pl_block;
+    if (block == NULL || get_realtime_rate() == 0.0f) {
+        return 0.0f;
+    }
+    return plan_compute_profile_nominal_speed(block);
+}
+
+void Stepper::enable_offset(axis_t axis, uint32_t max_steps_per_sec) {
+    offset_target = 0;
+    offset_steps  = 0;
+    offset_period = max_steps_per_sec ? Machine::Stepping::fStepperTimer / max_steps_per_sec : 0;
+    offset_ticks  = offset_period;
+    offset_axis   = axis;
+}
+
+void Stepper::disable_offset() {
+    offset_axis = INVALID_AXIS;
+    if (offset_steps) {
+        offset_unsynced = true;
+    }
+    offset_target = 0;
+    offset_steps  = 0;
+}
+
+void Stepper::sync_offset() {
+    if (offset_unsynced && plan_get_current_block() == NULL) {
+        offset_unsynced = false;
+        plan_sync_position();
+        gc_sync_position();
+    }
+}
+
+void Stepper::set_offset_target(int32_t steps) {
+    offset_target = steps;
+}
+
+int32_t Stepper::get_offset() {
+    return offset_steps;
+}
+
 float Stepper::get_realtime_rate() {
     switch (sys.state()) {
         case State::Cycle:
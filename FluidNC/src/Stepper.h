@@ -10,6 +10,7 @@
 */
 
 #include "EnumItem.h"
+#include "Types.h"
 
 #include <cstdint>
 
@@ -45,5 +46,21 @@ namespace Stepper {
     // Called by realtime status reporting if realtime rate reporting is enabled in config.h.
     float get_realtime_rate();
 
+    // Nominal rate of the block being executed, including overrides, or 0 when idle.
+    float get_nominal_rate();
+
+    // A step-level offset for one axis, applied without replanning.  While
+    // enabled, the ISR moves the axis toward the target one step at a time,
+    // at most max_steps_per_sec (0 for no limit), during blocks that do not
+    // otherwise move that axis.  The offset steps are counted in the machine
+    // position, so after disabling the offset the planner and parser
+    // positions must be resynchronized.  sync_offset() does that once the
+    // planner is empty; it is called again at each cycle stop.
+    void    enable_offset(axis_t axis, uint32_t max_steps_per_sec);
+    void    disable_offset();
+    void    sync_offset();
+    void    set_offset_target(int32_t steps);
+    int32_t get_offset();
+
     extern uint32_t isr_count;
 }
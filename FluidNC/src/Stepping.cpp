@@ -2,8 +2,7 @@
 #include "EnumItem.h"
 #include "Stepping.h"
 #include "Machine/MachineConfig.h"  // config
-
-#include <atomic>
+#include "Driver/delay_usecs.h"     // getMicros()
 
 step_engine_t* step_engines = NULL;  // Linked list of stepping engines
 
@@ -86,6 +85,9 @@ void Stepping::assignMotor(axis_t axis, motor_t motor, pinnum_t step_pin, bool s
     m->dir_invert            = dir_invert;
     m->blocked               = false;
     m->limited               = false;
+    m->correction            = 0;
+    m->offset                = 0;
+    m->corrected             = 0;
 
     if (motor == 0 && dir_invert) {
         set_bitnum(direction_mask, axis);
@@ -113,6 +115,59 @@ void Stepping::unblock(axis_t axis, motor_t motor) {
     }
 }
 
+bool Stepping::isStepping(axis_t axis, motor_t motor) {
+    return axis_motors[axis][motor] != nullptr;
+}
+
+volatile uint32_t Stepping::_segment_number = 0;
+volatile uint32_t Stepping::_segment_us     = 0;
+int32_t           Stepping::_trim_q20       = 0;
+
+// Called only from Stepper::pulse_func when a new segment is loaded
+void IRAM_ATTR Stepping::nextSegment() {
+    _segment_us = getMicros();
+    _segment_number = _segment_number + 1;
+}
+
+void Stepping::segmentTime(uint32_t& number, uint32_t& us) {
+    // The ISR can change both between the two reads, so read until they agree
+    do {
+        number = _segment_number;
+        us     = _segment_us;
+    } while (number != _segment_number);
+}
+
+void Stepping::setTrim(int32_t ppm) {
+    _trim_q20 = int32_t((int64_t(ppm) << 20) / 1000000);
+}
+
+void Stepping::correct(axis_t axis, motor_t motor, int32_t steps) {
+    auto m = axis_motors[axis][motor];
+    if (m) {
+        m->correction += steps;
+    }
+}
+
+// Called only while homing, before the motors move, so the ISR is
+// not taking out a correction step at the same time
+void Stepping::clear_correction(axis_t axis, motor_t motor) {
+    auto m = axis_motors[axis][motor];
+    if (m) {
+        m->correction = 0;
+        m->offset     = 0;
+    }
+}
+
+int32_t Stepping::correction(axis_t axis, motor_t motor) {
+    auto m = axis_motors[axis][motor];
+    return m ? m->correction.load() : 0;
+}
+
+int32_t Stepping::offset(axis_t axis, motor_t motor) {
+    auto m = axis_motors[axis][motor];
+    return m ? m->offset.load() : 0;
+}
+
 void Stepping::limit(axis_t axis, motor_t motor) {
     auto m = axis_motors[axis][motor];
     if (m) {
@@ -147,9 +202,10 @@ void IRAM_ATTR Stepping::step(AxisMask step_mask, AxisMask dir_mask) {
                     }
                 }
             }
-            // Some stepper drivers need time between changing direction and doing a pulse.
-            step_engine->finish_dir();
         }
+        // Some stepper drivers need time between changing direction and doing a pulse.
+        // All of the direction changes are committed together, with one delay.
+        step_engine->finish_dir();
         previous_dir_mask = dir_mask;
     }
 
@@ -163,6 +219,17 @@ void IRAM_ATTR Stepping::step(AxisMask step_mask, AxisMask dir_mask) {
             for (size_t motor = 0; motor < MAX_MOTORS_PER_AXIS; motor++) {
                 auto m = axis_motors[axis][motor];
                 if (m && !m->blocked && !m->limited) {
+                    // Skipping a step moves the motor opposite to the axis direction,
+                    // so a correction in that direction is taken out here.  If $MS
+                    // changes the correction meanwhile, the exchange fails and the
+                    // step is taken; the next step tries again.
+                    int32_t correction = m->correction.load(std::memory_order_relaxed);
+                    if (correction && (correction > 0) == (increment < 0) && m->corrected != _segment_number &&
+                        m->correction.compare_exchange_strong(correction, correction + increment)) {
+                        m->offset   -= increment;
+                        m->corrected = _segment_number;
+                        continue;
+                    }
                     step_engine->set_step_pin(m->step_pin, !m->step_invert);
                 }
             }
@@ -194,6 +261,9 @@ void Stepping::endLowLatency() {}
 // Called only from Stepper::pulse_func when a new segment is loaded
 // The argument is in units of ticks of the timer that generates ISRs
 void IRAM_ATTR Stepping::setTimerPeriod(uint32_t ticks) {
+    if (_trim_q20) {
+        ticks -= uint32_t((int64_t(ticks) * _trim_q20) >> 20);
+    }
     step_engine->set_timer_ticks((uint32_t)ticks);
 }
 
@@ -8,6 +8,8 @@
 #include "Driver/step_engine.h"
 #include "System.h"
 
+#include <atomic>
+
 namespace Machine {
     class Stepping : public Configuration::Configurable {
     public:
@@ -26,6 +28,10 @@ namespace Machine {
             bool     dir_invert;
             bool     blocked;
             bool     limited;
+            // correction is changed by both the ISR and $MS, so it is atomic
+            std::atomic<int32_t> correction;  // Steps still to be taken out of this motor's motion
+            std::atomic<int32_t> offset;      // Steps taken out so far, relative to the axis position
+            uint32_t             corrected;   // The segment in which the last correction step was taken
         };
         static motor_pins_t* axis_motors[MAX_N_AXIS][MAX_MOTORS_PER_AXIS];
         static axis_t        _n_active_axes;
@@ -34,6 +40,10 @@ namespace Machine {
         static void    waitDirection();  // Wait for direction delay
         static steps_t axis_steps[MAX_N_AXIS];
 
+        static volatile uint32_t _segment_number;
+        static volatile uint32_t _segment_us;  // getMicros() when _segment_number started
+        static int32_t           _trim_q20;    // Step rate trim, as a fraction scaled by 2^20
+
         static step_engine_t* step_engine;
 
     public:
@@ -86,7 +96,26 @@ namespace Machine {
         static void block(axis_t axis, motor_t motor);
         static void unblock(axis_t axis, motor_t motor);
 
-        static uint32_t maxPulsesPerSec();
+        // True if the motor takes step pulses, so that block() stops it
+        static bool isStepping(axis_t axis, motor_t motor);
+
+        // Used to keep ganged motors square during normal motion.  A correction
+        // is applied by skipping at most one step of the motor per segment,
+        // when the axis moves in the direction that reduces the correction.
+        static void    correct(axis_t axis, motor_t motor, int32_t steps);
+        static void    clear_correction(axis_t axis, motor_t motor);
+        static int32_t correction(axis_t axis, motor_t motor);
+        static int32_t offset(axis_t axis, motor_t motor);
+        static void    nextSegment();
+
+        // Used by motion sync to line up segments with another controller.
+        // segmentTime() gets the number and start time of the current segment;
+        // setTrim() speeds up (positive) or slows down the step timer.
+        static void segmentTime(uint32_t& number, uint32_t& us);
+        static void setTrim(int32_t ppm);
+
+        static uint32_t    maxPulsesPerSec();
+        static const char* engineName() { return step_engine->name; }
 
         static AxisMask direction_mask;
 
@@ -0,0 +1,284 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "SyncProtocol.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace SyncProtocol {
+    uint8_t crc8(const uint8_t* data, size_t len, uint8_t crc) {
+        while (len--) {
+            crc ^= *data++;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x80) ? uint8_t((crc << 1) ^ 0x07) : uint8_t(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    Writer::Writer(MsgType type) {
+        _frame[0] = frame_start;
+        _frame[1] = uint8_t(type);
+        _frame[2] = 0;
+    }
+
+    void Writer::u8(uint8_t value) {
+        if (_len < max_frame - 1) {
+            _frame[_len++] = value;
+        }
+    }
+
+    void Writer::u32(uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            u8(uint8_t(value >> (8 * i)));
+        }
+    }
+
+    void Writer::f32(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        u32(bits);
+    }
+
+    const uint8_t* Writer::data() {
+        _frame[2]    = uint8_t(_len - 3);
+        _frame[_len] = crc8(_frame + 1, _len - 1);
+        return _frame;
+    }
+
+    Writer encode(const Block& msg) {
+        Writer w(MsgType::Block);
+        w.u32(msg.seq);
+        w.f32(msg.feed_rate);
+        w.u32(msg.spindle_speed);
+        w.u8(msg.motion);
+        w.u8(msg.spindle);
+        w.u8(msg.coolant);
+        w.u32(uint32_t(msg.line_number));
+        size_t n_axis = std::min(size_t(msg.n_axis), max_axes);
+        w.u8(uint8_t(n_axis));
+        for (size_t axis = 0; axis < n_axis; axis++) {
+            w.f32(msg.target[axis]);
+        }
+        return w;
+    }
+
+    Writer encode(const Start& msg) {
+        Writer w(MsgType::Start);
+        w.u32(msg.leader_us);
+        return w;
+    }
+
+    Writer encode(const Segment& msg) {
+        Writer w(MsgType::Segment);
+        w.u32(msg.count);
+        w.u32(msg.leader_us);
+        return w;
+    }
+
+    Writer encode(const Ping& msg) {
+        Writer w(MsgType::Ping);
+        w.u32(msg.follower_us);
+        return w;
+    }
+
+    Writer encode(const Pong& msg) {
+        Writer w(MsgType::Pong);
+        w.u32(msg.follower_us);
+        w.u32(msg.leader_us);
+        return w;
+    }
+
+    Writer encode(const Realtime& msg) {
+        Writer w(MsgType::Realtime);
+        w.u8(msg.cmd);
+        return w;
+    }
+
+    Writer encode(const Stop& msg) {
+        Writer w(MsgType::Stop);
+        w.u8(msg.alarm);
+        return w;
+    }
+
+    bool Decoder::push(uint8_t byte) {
+        switch (_state) {
+            case Idle:
+                if (byte == frame_start) {
+                    _state = Type;
+                }
+                return false;
+            case Type:
+                _type  = byte;
+                _state = Length;
+                return false;
+            case Length:
+                if (byte > max_payload) {
+                    ++_dropped;
+                    _state = Idle;
+                    return false;
+                }
+                _len   = byte;
+                _fill  = 0;
+                _state = _len ? Payload : Crc;
+                return false;
+            case Payload:
+                _payload[_fill++] = byte;
+                if (_fill == _len) {
+                    _state = Crc;
+                }
+                return false;
+            case Crc: {
+                uint8_t header[2] = { _type, _len };
+                _state            = Idle;
+                if (crc8(_payload, _len, crc8(header, 2)) != byte) {
+                    ++_dropped;
+                    return false;
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Reads the payload of a decoded frame
+    class Reader {
+    public:
+        Reader(const uint8_t* data, size_t len) : _data(data), _len(len) {}
+
+        uint8_t u8() {
+            if (_pos >= _len) {
+                _overrun = true;
+                return 0;
+            }
+            return _data[_pos++];
+        }
+
+        uint32_t u32() {
+            uint32_t value = 0;
+            for (int i = 0; i < 4; i++) {
+                value |= uint32_t(u8()) << (8 * i);
+            }
+            return value;
+        }
+
+        float f32() {
+            uint32_t bits = u32();
+            float    value;
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        // False if a read went past the end
+        bool ok() const { return !_overrun; }
+
+    private:
+        const uint8_t* _data;
+        size_t         _len;
+        size_t         _pos     = 0;
+        bool           _overrun = false;
+    };
+
+    bool Decoder::get(Block& msg) const {
+        if (type() != MsgType::Block) {
+            return false;
+        }
+        Reader r(_payload, _len);
+        msg.seq           = r.u32();
+        msg.feed_rate     = r.f32();
+        msg.spindle_speed = r.u32();
+        msg.motion        = r.u8();
+        msg.spindle       = r.u8();
+        msg.coolant       = r.u8();
+        msg.line_number   = int32_t(r.u32());
+        msg.n_axis        = r.u8();
+        if (msg.n_axis > max_axes) {
+            return false;
+        }
+        for (size_t axis = 0; axis < msg.n_axis; axis++) {
+            msg.target[axis] = r.f32();
+        }
+        return r.ok();
+    }
+
+    bool Decoder::get(Start& msg) const {
+        Reader r(_payload, _len);
+        msg.leader_us = r.u32();
+        return type() == MsgType::Start && r.ok();
+    }
+
+    bool Decoder::get(Segment& msg) const {
+        Reader r(_payload, _len);
+        msg.count     = r.u32();
+        msg.leader_us = r.u32();
+        return type() == MsgType::Segment && r.ok();
+    }
+
+    bool Decoder::get(Ping& msg) const {
+        Reader r(_payload, _len);
+        msg.follower_us = r.u32();
+        return type() == MsgType::Ping && r.ok();
+    }
+
+    bool Decoder::get(Pong& msg) const {
+        Reader r(_payload, _len);
+        msg.follower_us = r.u32();
+        msg.leader_us   = r.u32();
+        return type() == MsgType::Pong && r.ok();
+    }
+
+    bool Decoder::get(Realtime& msg) const {
+        Reader r(_payload, _len);
+        msg.cmd = r.u8();
+        return type() == MsgType::Realtime && r.ok();
+    }
+
+    bool Decoder::get(Stop& msg) const {
+        Reader r(_payload, _len);
+        msg.alarm = r.u8();
+        return type() == MsgType::Stop && r.ok();
+    }
+
+    void ClockSync::add(uint32_t sent_us, uint32_t leader_us, uint32_t received_us) {
+        uint32_t round_trip = received_us - sent_us;
+        // The leader answered halfway through the round trip
+        int32_t offset = int32_t(leader_us - (sent_us + round_trip / 2));
+
+        _round_trips[_next] = round_trip;
+        _offsets[_next]     = offset;
+        _next               = (_next + 1) % window;
+        _count              = std::min(_count + 1, window);
+
+        size_t best = 0;
+        for (size_t i = 1; i < _count; i++) {
+            if (_round_trips[i] < _round_trips[best]) {
+                best = i;
+            }
+        }
+        _offset     = _offsets[best];
+        _round_trip = _round_trips[best];
+    }
+
+    void ClockSync::reset() {
+        _count      = 0;
+        _next       = 0;
+        _offset     = 0;
+        _round_trip = 0;
+    }
+
+    static float clamp(float value, float limit) {
+        return std::max(std::min(value, limit), -limit);
+    }
+
+    int32_t SegmentAligner::update(int32_t lag_us) {
+        _integral = clamp(_integral + _integral_gain * lag_us, float(_max_trim));
+        _trim     = int32_t(clamp(_gain * lag_us + _integral, float(_max_trim)));
+        return _trim;
+    }
+
+    void SegmentAligner::reset() {
+        _integral = 0.0f;
+        _trim     = 0;
+    }
+}
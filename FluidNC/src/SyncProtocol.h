@@ -0,0 +1,179 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+// SyncProtocol is the wire format and the timing math for running two
+// controllers as one machine.  The leader sends each planned block to the
+// follower, which plans the same blocks, so both generate the same step
+// segments.  Start says when to begin a cycle in leader time, Ping and Pong
+// measure the offset between the two clocks, and Segment marks let the
+// follower trim its step timer so that its segments line up with the
+// leader's.  Stop makes the follower stop when the leader is reset or
+// raises an alarm.
+//
+// A frame is
+//   0xA5 type length payload crc
+// where length is the number of payload bytes and crc is a CRC-8 (poly 0x07)
+// of type, length and payload.  Numbers are little-endian.  A frame with a
+// bad crc is dropped and the decoder looks for the next 0xA5.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SyncProtocol {
+    const uint8_t frame_start = 0xA5;
+    const size_t  max_payload = 64;
+    const size_t  max_frame   = max_payload + 4;
+    const size_t  max_axes    = 9;
+
+    enum class MsgType : uint8_t {
+        Block    = 1,  // Leader to follower, a planned line
+        Start    = 2,  // Leader to follower, when to start or resume a cycle
+        Segment  = 3,  // Leader to follower, when a segment started
+        Ping     = 4,  // Follower to leader
+        Pong     = 5,  // Leader to follower, the answer to a Ping
+        Realtime = 6,  // Leader to follower, a realtime command to repeat
+        Stop     = 7,  // Leader to follower, the leader was reset or raised an alarm
+    };
+
+    struct Block {
+        uint32_t seq;
+        float    feed_rate;
+        uint32_t spindle_speed;
+        uint8_t  motion;   // PlMotion bits
+        uint8_t  spindle;  // SpindleState
+        uint8_t  coolant;  // CoolantState bits
+        int32_t  line_number;
+        uint8_t  n_axis;
+        float    target[max_axes];  // Motor positions in mm
+    };
+
+    struct Start {
+        uint32_t leader_us;
+    };
+
+    struct Segment {
+        uint32_t count;      // Segments since the cycle started
+        uint32_t leader_us;  // When that segment started
+    };
+
+    struct Ping {
+        uint32_t follower_us;
+    };
+
+    struct Pong {
+        uint32_t follower_us;  // From the Ping
+        uint32_t leader_us;    // When the leader answered
+    };
+
+    struct Realtime {
+        uint8_t cmd;
+    };
+
+    struct Stop {
+        uint8_t alarm;  // ExecAlarm, or 0 for a reset
+    };
+
+    uint8_t crc8(const uint8_t* data, size_t len, uint8_t crc = 0);
+
+    // Builds one frame
+    class Writer {
+    public:
+        explicit Writer(MsgType type);
+
+        void u8(uint8_t value);
+        void u32(uint32_t value);
+        void f32(float value);
+
+        // The finished frame
+        const uint8_t* data();
+        size_t         size() const { return _len + 1; }
+
+    private:
+        uint8_t _frame[max_frame];
+        size_t  _len = 3;
+    };
+
+    Writer encode(const Block& msg);
+    Writer encode(const Start& msg);
+    Writer encode(const Segment& msg);
+    Writer encode(const Ping& msg);
+    Writer encode(const Pong& msg);
+    Writer encode(const Realtime& msg);
+    Writer encode(const Stop& msg);
+
+    // Collects frames from a byte stream
+    class Decoder {
+    public:
+        // Returns true when byte completes a good frame
+        bool push(uint8_t byte);
+
+        MsgType type() const { return MsgType(_type); }
+        size_t  dropped() const { return _dropped; }
+
+        // Each fails if the frame is not of that type or is too short
+        bool get(Block& msg) const;
+        bool get(Start& msg) const;
+        bool get(Segment& msg) const;
+        bool get(Ping& msg) const;
+        bool get(Pong& msg) const;
+        bool get(Realtime& msg) const;
+        bool get(Stop& msg) const;
+
+    private:
+        enum State { Idle, Type, Length, Payload, Crc };
+
+        State   _state = Idle;
+        uint8_t _type  = 0;
+        uint8_t _len   = 0;
+        uint8_t _payload[max_payload];
+        size_t  _fill    = 0;
+        size_t  _dropped = 0;  // Frames with a bad crc or length
+    };
+
+    // Estimates the offset from the local clock to the leader's clock from
+    // Ping/Pong exchanges.  The exchange with the shortest round trip in the
+    // last few is the one least delayed on one side, so it is used.
+    class ClockSync {
+    public:
+        static constexpr size_t window = 8;
+
+        // sent_us and received_us are local times around the exchange
+        void add(uint32_t sent_us, uint32_t leader_us, uint32_t received_us);
+        void reset();
+
+        bool     valid() const { return _count != 0; }
+        int32_t  offset() const { return _offset; }
+        uint32_t round_trip() const { return _round_trip; }
+
+        uint32_t to_local(uint32_t leader_us) const { return leader_us - uint32_t(_offset); }
+
+    private:
+        uint32_t _round_trips[window];
+        int32_t  _offsets[window];
+        size_t   _count      = 0;
+        size_t   _next       = 0;
+        int32_t  _offset     = 0;
+        uint32_t _round_trip = 0;
+    };
+
+    // Turns the time by which the follower's segments lag the leader's into a
+    // trim of the follower's step rate, in parts per million.  The integral
+    // term takes out the steady difference between the two crystals.
+    class SegmentAligner {
+    public:
+        float   _gain          = 1.0f;   // ppm per us of lag
+        float   _integral_gain = 0.05f;  // ppm per us of lag per mark
+        int32_t _max_trim      = 5000;   // ppm
+
+        int32_t update(int32_t lag_us);
+        void    reset();
+
+        int32_t trim() const { return _trim; }
+
+    private:
+        float   _integral = 0.0f;
+        int32_t _trim     = 0;
+    };
+}
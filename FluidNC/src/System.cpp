@@ -31,6 +31,7 @@ void system_reset() {
     set_state(prior_state);
     sys.set_abort(prior_abort);
     sys.set_f_override(FeedOverride::Default);                 // Set to 100%
+    sys.set_a_override(FeedOverride::Default);                 // Set to 100%
     sys.set_r_override(RapidOverride::Default);                // Set to 100%
     sys.set_spindle_speed_ovr(SpindleSpeedOverride::Default);  // Set to 100%
     memset(probe_steps, 0, sizeof(probe_steps));               // Clear probe position.
@@ -70,6 +70,7 @@ protected:
     bool           abort_;              // System abort flag. Forces exit back to main loop for reset.
     Suspend        suspend_;            // System suspend bitflag variable that manages holds, cancels, and safety door.
     Percent        f_override_;         // Feed rate override value in percent
+    Percent        a_override_;         // Adaptive feed scaling in percent, applied with f_override_
     Percent        r_override_;         // Rapids override value in percent
     Percent        spindle_speed_ovr_;  // Spindle speed value in percent
     Override       override_ctrl_;      // Tracks override control states.
@@ -92,6 +93,7 @@ public:
         abort_ = false;
         memset(&suspend_, 0, sizeof(suspend_));  // suspend is a POD so this is okay.
         f_override_        = 0;
+        a_override_        = 0;
         r_override_        = 0;
         spindle_speed_ovr_ = 0;
         override_ctrl_     = Override(0);
@@ -133,6 +135,12 @@ public:
            f_override_ = value;
     }
 
+    Percent IRAM_ATTR a_override() const { return a_override_; }
+    void IRAM_ATTR    set_a_override(Percent value) {
+           dirty_      = SystemDirty(int(dirty_) | int(SystemDirty::FeedOverride));
+           a_override_ = value;
+    }
+
     Percent IRAM_ATTR r_override() const { return r_override_; }
     void IRAM_ATTR    set_r_override(Percent value) {
            dirty_      = SystemDirty(int(dirty_) | int(SystemDirty::RapidOverride));
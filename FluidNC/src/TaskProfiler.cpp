@@ -0,0 +1,239 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#include "TaskProfiler.h"
+
+#include "Config.h"  // IRAM_ATTR
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+
+namespace {
+    struct Slot {
+        // Written only by the slot's own task or ISR.  The totals are
+        // published under seq, which is odd while they change, so that a
+        // reader never sees half of the 64-bit busy count.
+        std::atomic<uint32_t> seq;
+        uint32_t              runs;
+        uint64_t              busy_ticks;
+        uint32_t              max_ticks;
+
+        // The current run
+        uint32_t since;      // When counting last started
+        uint32_t run_ticks;  // Busy time of the run so far
+        bool     counting;   // False inside a ProfileWait
+        uint8_t  depth;      // Nesting of ProfileWait and ProfileWork
+        uint32_t outer;      // Bit n is counting as it was outside nesting level n
+
+        // Set by the reader; the totals shown are the ones since then
+        uint32_t              base_runs;
+        uint64_t              base_busy_ticks;
+        std::atomic<bool>     clear_max;
+        void*                 task;  // Null until a task registers, and always for the ISR
+        ProfiledTask          kind;
+        uint8_t               instance;
+
+        constexpr Slot(ProfiledTask task_kind = ProfiledTask::Count) : kind(task_kind) {}
+    };
+
+    const int max_slots = int(ProfiledTask::Count) + 6;
+
+    // Not const, so that the ISR never reads it from flash.  The first slots
+    // have a fixed kind, whether or not their task registers.
+    Slot slots[max_slots] = { ProfiledTask::Poller,    ProfiledTask::Protocol, ProfiledTask::Output,
+                              ProfiledTask::Vfd,       ProfiledTask::Extender, ProfiledTask::StepperIsr };
+    int  n_slots = int(ProfiledTask::Count);
+
+    const char* const names[] = { "poller", "protocol", "output", "vfd", "i2c_extender", "stepper_isr" };
+
+    // Tasks that are not instrumented, but whose stacks can be checked
+    const char* const other_tasks[] = { "async_tcp" };
+
+    int64_t reset_us = 0;
+
+    // The slot of the calling task, or -1 if it has none
+    int current_slot() {
+        void* task = task_current();
+        for (int i = 0; i < n_slots; i++) {
+            if (slots[i].task == task) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    void IRAM_ATTR set_counting(Slot& slot, bool counting) {
+        uint32_t now = profile_ticks();
+        if (slot.counting) {
+            slot.run_ticks += now - slot.since;
+        }
+        slot.counting = counting;
+        slot.since    = now;
+    }
+
+    // A consistent copy of the totals since the last reset
+    ProfileStats read(const Slot& slot) {
+        ProfileStats stats;
+        uint32_t     seq;
+        do {
+            seq              = slot.seq;
+            stats.runs       = slot.runs;
+            stats.busy_ticks = slot.busy_ticks;
+            stats.max_ticks  = slot.max_ticks;
+        } while ((seq & 1) || seq != slot.seq);
+        stats.runs -= slot.base_runs;
+        stats.busy_ticks -= slot.base_busy_ticks;
+        if (slot.clear_max) {
+            stats.max_ticks = 0;
+        }
+        return stats;
+    }
+}
+
+ProfileSlot profile_task(ProfiledTask task) {
+    for (int i = 0; i < n_slots; i++) {
+        auto& slot = slots[i];
+        if (slot.task == task_current() && slot.kind == task) {
+            return ProfileSlot(i);
+        }
+    }
+    int i = int(task);
+    if (slots[i].task) {
+        // Another instance of this kind has the first slot
+        uint8_t instance = 1;
+        for (int j = int(ProfiledTask::Count); j < n_slots; j++) {
+            if (slots[j].kind == task) {
+                ++instance;
+            }
+        }
+        if (n_slots == max_slots) {
+            return ProfileSlot(int(task));  // Shares the first slot
+        }
+        i                 = n_slots++;
+        slots[i].kind     = task;
+        slots[i].instance = instance;
+    }
+    slots[i].task = task_current();
+    return ProfileSlot(i);
+}
+
+void IRAM_ATTR profile_begin(ProfileSlot n) {
+    auto& slot     = slots[n];
+    slot.run_ticks = 0;
+    slot.depth     = 0;
+    slot.counting  = true;
+    slot.since     = profile_ticks();
+}
+
+void IRAM_ATTR profile_end(ProfileSlot n) {
+    auto& slot = slots[n];
+    set_counting(slot, false);
+    uint32_t ticks = slot.run_ticks;
+
+    slot.seq = slot.seq + 1;
+    if (slot.clear_max) {
+        slot.max_ticks = 0;
+        slot.clear_max = false;
+    }
+    slot.runs = slot.runs + 1;
+    slot.busy_ticks += ticks;
+    if (ticks > slot.max_ticks) {
+        slot.max_ticks = ticks;
+    }
+    slot.seq = slot.seq + 1;
+}
+
+void profile_wait(bool waiting) {
+    int n = current_slot();
+    if (n < 0) {
+        return;
+    }
+    auto& slot = slots[n];
+    if (slot.depth < 32) {
+        if (slot.counting) {
+            slot.outer |= 1u << slot.depth;
+        } else {
+            slot.outer &= ~(1u << slot.depth);
+        }
+    }
+    ++slot.depth;
+    set_counting(slot, !waiting);
+}
+
+void profile_done() {
+    int n = current_slot();
+    if (n < 0 || slots[n].depth == 0) {
+        return;
+    }
+    auto& slot = slots[n];
+    --slot.depth;
+    set_counting(slot, slot.depth < 32 ? (slot.outer >> slot.depth) & 1 : true);
+}
+
+void profile_reset() {
+    reset_us = profile_uptime_us();
+    for (int i = 0; i < n_slots; i++) {
+        auto& slot = slots[i];
+        auto  now  = read(slot);
+        slot.base_runs += now.runs;
+        slot.base_busy_ticks += now.busy_ticks;
+        slot.clear_max = true;
+    }
+}
+
+void profile_reset(ProfiledTask task) {
+    auto& slot = slots[int(task)];
+    auto  now  = read(slot);
+    slot.base_runs += now.runs;
+    slot.base_busy_ticks += now.busy_ticks;
+    slot.clear_max = true;
+}
+
+ProfileStats profile_stats(ProfiledTask task) {
+    return read(slots[int(task)]);
+}
+
+static std::string column(const std::string& text, size_t width) {
+    return text.length() >= width ? text + " " : text + std::string(width - text.length(), ' ');
+}
+
+static std::string stack_free(void* task) {
+    int32_t free = task_stack_free(task);
+    return free < 0 ? "-" : std::to_string(free);
+}
+
+void profile_report(Channel& out) {
+    int64_t  elapsed_us   = profile_uptime_us() - reset_us;
+    uint32_t ticks_per_us = profile_ticks_per_us();
+    log_stream(out, "Since reset:" << uint32_t(elapsed_us / 1000) << "ms");
+    log_stream(out, "Task          Runs        Busy%   Max us    Stack free");
+
+    for (int i = 0; i < n_slots; i++) {
+        const auto& slot  = slots[i];
+        auto        stats = read(slot);
+        if (!stats.runs) {
+            continue;
+        }
+        char busy[16];
+        snprintf(busy, sizeof(busy), "%.2f", elapsed_us > 0 ? 100.0 * stats.busy_ticks / ticks_per_us / elapsed_us : 0.0);
+
+        std::string name = names[int(slot.kind)];
+        if (slot.instance) {
+            name += std::to_string(slot.instance + 1);
+        }
+        std::string row = column(name, 14);
+        row += column(std::to_string(stats.runs), 12);
+        row += column(busy, 8);
+        row += column(std::to_string(stats.max_ticks / ticks_per_us), 10);
+        row += slot.kind == ProfiledTask::StepperIsr ? "-" : stack_free(slot.task);
+        log_stream(out, row);
+    }
+
+    for (auto name : other_tasks) {
+        void* task = task_by_name(name);
+        if (task) {
+            log_stream(out, column(name, 14) << column("-", 12) << column("-", 8) << column("-", 10) << stack_free(task));
+        }
+    }
+}
@@ -0,0 +1,85 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+#pragma once
+
+#include "Channel.h"
+#include "Driver/task_stats.h"  // profile_ticks()
+
+#include <cstdint>
+
+// Timing of the main tasks and the stepper ISR, for $Tasks/Profile.  Each
+// pass through a task's loop, or each ISR, is one run.  A run is timed with
+// a cycle counter from the start of its work to the end, so the busy time
+// includes any waits inside the run, such as for a VFD reply, but not the
+// delay or queue wait between runs.  Waits that can last as long as a job,
+// such as the protocol task's wait for room in the planner, are marked with
+// ProfileWait and left out.  Taking a few timestamps per run is cheap
+// enough that the profiler is always on.
+
+enum class ProfiledTask : uint8_t {
+    Poller = 0,
+    Protocol,
+    Output,
+    Vfd,
+    Extender,
+    StepperIsr,
+    Count,
+};
+
+// Each task has its own slot, including each instance of the VFD and
+// extender tasks, so a slot is only ever written by one task.  The first
+// instance of each kind gets the slot numbered by its ProfiledTask, so the
+// stepper ISR, which has no task to register, uses that one.
+using ProfileSlot = uint8_t;
+
+// Called once by each task before its loop, to get its slot and find its stack
+ProfileSlot profile_task(ProfiledTask task);
+
+void profile_begin(ProfileSlot slot);
+void profile_end(ProfileSlot slot);
+
+// Times the enclosing scope as one run
+class ProfileRun {
+public:
+    explicit ProfileRun(ProfileSlot slot) : _slot(slot) { profile_begin(_slot); }
+    explicit ProfileRun(ProfiledTask task) : ProfileRun(ProfileSlot(task)) {}
+    ~ProfileRun() { profile_end(_slot); }
+
+private:
+    ProfileSlot _slot;
+};
+
+// Scopes inside a run of the calling task.  The time in a ProfileWait is
+// not busy time, except for the time in a ProfileWork inside it, such as
+// the realtime checks that a wait loop makes.  They do nothing in a task
+// without a slot.
+void profile_wait(bool waiting);
+void profile_done();
+
+class ProfileWait {
+public:
+    ProfileWait() { profile_wait(true); }
+    ~ProfileWait() { profile_done(); }
+};
+
+class ProfileWork {
+public:
+    ProfileWork() { profile_wait(false); }
+    ~ProfileWork() { profile_done(); }
+};
+
+void profile_reset();
+void profile_reset(ProfiledTask task);
+
+struct ProfileStats {
+    uint32_t runs;
+    uint64_t busy_ticks;
+    uint32_t max_ticks;
+};
+
+// The totals for the first instance of a task since it was last reset
+ProfileStats profile_stats(ProfiledTask task);
+
+// Shows runs, busy percentage, longest run and stack headroom per task
+void profile_report(Channel& out);
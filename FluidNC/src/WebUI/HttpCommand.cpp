@@ -13,6 +13,11 @@
 //   headers - Object of custom headers, e.g. {"Authorization":"Bearer xyz"}
 //   extract       - Object mapping GCode params to JSON keys, e.g. {"_temp":"temperature"}
 //   halt_on_error - If true (default), errors halt GCode. If false, errors set _HTTP_STATUS=0
+//   async         - If true, the request runs in the background and GCode continues at once.
+//                   The result parameters are set when the program first reads one of them,
+//                   which waits for the request only if it has not finished yet.
+//   forget        - If true, the request runs in the background and its result is discarded.
+//                   For job-start notices and metrics posts that nothing depends on.
 //
 // Token substitution:
 //   Long tokens (like JWT auth tokens) can be stored in /localfs/http_settings.json and
@@ -44,6 +49,7 @@
 //   $HTTP/COMMAND=http://metrics.local/log{"halt_on_error":false}
 //   $HTTP/COMMAND=http://ha:8123/api{"headers":{"Authorization":"${ha_token}"}}
 //   $HTTP/COMMAND=@fetch_temp
+//   $HTTP/COMMAND=http://shop/api/job_start{"forget":true}
 //
 // GCode parameters set after request:
 //   _HTTP_STATUS       - HTTP status code (0 if connection failed)
@@ -62,8 +68,15 @@
 //     M0 (Temperature too high!)
 //   o100 endif
 //
+// Example with an asynchronous request:
+//   $HTTP/COMMAND=http://sensor/api{"async":true,"extract":{"_temp":"temperature"}}
+//   G1 X100 F1000            ; Runs while the request is in flight
+//   #<_t> = #<_temp>         ; Waits here, if necessary, for the response
+//
 // Limitations:
-//   - Blocks GCode processing (not stepper motion) during request
+//   - Synchronous requests block GCode processing (not stepper motion) during request
+//   - Up to ASYNC_QUEUE_SIZE background requests can be queued; a fire-and-forget
+//     request that does not fit is dropped with a warning
 //   - Maximum timeout: 10 seconds
 //   - Only works when WiFi is connected
 //   - HTTPS certificates are not validated
@@ -88,6 +101,8 @@ namespace WebUI {
     // Static member initialization
     std::map<std::string, std::string> HttpCommand::_tokens;
     std::map<std::string, std::string> HttpCommand::_commands;
+    QueueHandle_t                      HttpCommand::_queue = nullptr;
+    TaskHandle_t                       HttpCommand::_task  = nullptr;
 
     // ============================================================================
     // Token loading and substitution
@@ -188,6 +203,10 @@ namespace WebUI {
             } else if (_currentKey == "halt_on_error") {
                 // "halt_on_error":true (default) = halt GCode on error, "halt_on_error":false = continue
                 _request.fail_on_error = (value == "true" || value == "1");
+            } else if (_currentKey == "async") {
+                _request.async = (value == "true" || value == "1");
+            } else if (_currentKey == "forget") {
+                _request.forget = (value == "true" || value == "1");
             }
         } else if (_depth == 2) {
             // Nested object values (headers or extract)
@@ -251,8 +270,8 @@ namespace WebUI {
             for (auto it = _extractMap.begin(); it != _extractMap.end(); ++it) {
                 if (it->second == keyStr) {
                     // Found a matching key - convert value to float and store
-                    float floatVal = value.toFloat();
-                    set_named_param(it->first.c_str(), floatVal);
+                    float floatVal     = value.toFloat();
+                    _values[it->first] = floatVal;
                     log_debug("HTTP: Extracted " << it->first << " = " << floatVal);
                     // Remove this key from the map (marks it as found)
                     _extractMap.erase(it);
@@ -413,6 +432,9 @@ namespace WebUI {
         // Check WiFi connection (runtime error - respects fail_on_error)
         if (WiFi.status() != WL_CONNECTED) {
             log_error_to(out, "HTTP: WiFi not connected");
+            if (request.forget) {
+                return Error::Ok;  // Nothing depends on the result
+            }
             if (request.fail_on_error) {
                 return Error::MessageFailed;
             }
@@ -423,16 +445,24 @@ namespace WebUI {
             return Error::Ok;
         }
 
+        if (request.async || request.forget) {
+            return execute_async(request, out);
+        }
+
         // Warn if in Cycle state
         if (state_is(State::Cycle)) {
             log_warn_to(out, "HTTP: Request during active motion may cause buffer underrun");
         }
 
         // Execute request
-        Error result = execute_request(request, status_code, bytes_received, out);
+        std::map<std::string, float> values;
+        Error                        result = execute_request(request, status_code, bytes_received, values, out);
 
         // Store response in parameters
         store_response_params(status_code, bytes_received);
+        for (const auto& value : values) {
+            set_named_param(value.first.c_str(), value.second);
+        }
 
         if (result == Error::Ok) {
             log_info_to(out, "HTTP: " << status_code);
@@ -511,7 +541,11 @@ namespace WebUI {
     // HTTP request execution
     // ============================================================================
 
-    Error HttpCommand::execute_request(HttpRequest& request, int& status_code, uint32_t& bytes_received, Channel& out) {
+    Error HttpCommand::execute_request(HttpRequest&                  request,
+                                       int&                          status_code,
+                                       uint32_t&                     bytes_received,
+                                       std::map<std::string, float>& values,
+                                       Channel&                      out) {
         std::string protocol;
         std::string host;
         uint16_t    port;
@@ -624,7 +658,7 @@ namespace WebUI {
             // Extraction requested - parse JSON and extract values
             // Listener will erase found keys from request.extract in-place
             JsonStreamingParser    parser;
-            ValueExtractorListener listener(request.extract, out);
+            ValueExtractorListener listener(request.extract, values, out);
             parser.setListener(&listener);
 
             while ((client.connected() || client.available())) {
@@ -662,4 +696,103 @@ namespace WebUI {
         set_named_param("_HTTP_RESPONSE_LEN", static_cast<float>(bytes_received));
     }
 
+    // ============================================================================
+    // Asynchronous requests
+    // ============================================================================
+
+    void HttpCommand::background_task(void* unused) {
+        std::shared_ptr<HttpJob>* item;
+        while (true) {
+            if (xQueueReceive(_queue, &item, portMAX_DELAY)) {
+                std::shared_ptr<HttpJob> job = *item;
+                delete item;
+
+                // The issuing channel may be gone by now, e.g. a file job that ended
+                job->result = execute_request(job->request, job->status_code, job->bytes_received, job->values, allChannels);
+                if (job->result == Error::Ok) {
+                    log_debug("HTTP: " << job->status_code << " from " << job->request.url);
+                }
+                job->done = true;
+            }
+        }
+    }
+
+    bool HttpCommand::wait_for(HttpJob& job) {
+        while (!job.done) {
+            protocol_execute_realtime();
+            if (sys.abort()) {
+                return false;
+            }
+            vTaskDelay(1);
+        }
+        return true;
+    }
+
+    Error HttpCommand::execute_async(HttpRequest& request, Channel& out) {
+        if (!_queue) {
+            _queue = xQueueCreate(ASYNC_QUEUE_SIZE, sizeof(std::shared_ptr<HttpJob>*));
+            xTaskCreatePinnedToCore(background_task,   // task
+                                    "http_command",    // name for task
+                                    8192,              // size of task stack, as for the poller that runs synchronous requests
+                                    NULL,              // parameters
+                                    1,                 // priority
+                                    &_task,            // task handle
+                                    SUPPORT_TASK_CORE  // core
+            );
+        }
+
+        auto job     = std::make_shared<HttpJob>();
+        job->request = request;
+
+        auto item = new std::shared_ptr<HttpJob>(job);
+        if (request.forget) {
+            if (!xQueueSend(_queue, &item, 0)) {
+                delete item;
+                log_warn_to(out, "HTTP: Background queue full, request dropped");
+            }
+            return Error::Ok;
+        }
+
+        // Results are needed, so wait for room rather than dropping the request
+        while (!xQueueSend(_queue, &item, 0)) {
+            protocol_execute_realtime();
+            if (sys.abort()) {
+                delete item;
+                return Error::Reset;
+            }
+            vTaskDelay(1);
+        }
+
+        // On failure with halt_on_error, reading a result fails, which halts the program there.
+        // Otherwise a failure reads as _HTTP_STATUS 0, as for a synchronous request.
+        auto pending = [job](std::function<bool(float&)> get) {
+            return [job, get](float& value) {
+                if (!wait_for(*job) || (job->result != Error::Ok && job->request.fail_on_error)) {
+                    return false;
+                }
+                return get(value);
+            };
+        };
+        set_named_param_pending("_HTTP_STATUS", pending([job](float& value) {
+                                    value = static_cast<float>(job->status_code);
+                                    return true;
+                                }));
+        set_named_param_pending("_HTTP_RESPONSE_LEN", pending([job](float& value) {
+                                    value = static_cast<float>(job->bytes_received);
+                                    return true;
+                                }));
+        for (const auto& mapping : request.extract) {
+            std::string name = mapping.first;
+            set_named_param_pending(name.c_str(), pending([job, name](float& value) {
+                                        auto it = job->values.find(name);
+                                        if (it == job->values.end()) {
+                                            return false;  // Not in the response; already reported
+                                        }
+                                        value = it->second;
+                                        return true;
+                                    }));
+        }
+        return Error::Ok;
+    }
+
 }  // namespace WebUI
@@ -11,6 +11,8 @@
 #include <string>
 #include <string_view>
 #include <map>
+#include <memory>
+#include <atomic>
 
 namespace WebUI {
 
@@ -23,8 +25,20 @@ namespace WebUI {
         uint32_t                           timeout_ms;
         std::map<std::string, std::string> extract;        // Maps GCode param name -> JSON key to extract
         bool                               fail_on_error;  // If true, errors halt GCode execution
+        bool                               async;          // Run in the background; results are set when first read
+        bool                               forget;         // Run in the background and discard the results
 
-        HttpRequest() : method("GET"), timeout_ms(5000), fail_on_error(true) {}
+        HttpRequest() : method("GET"), timeout_ms(5000), fail_on_error(true), async(false), forget(false) {}
+    };
+
+    // A request handed to the background task, with its results
+    struct HttpJob {
+        HttpRequest                  request;
+        int                          status_code    = 0;
+        uint32_t                     bytes_received = 0;
+        std::map<std::string, float> values;  // Extracted values by GCode param name
+        Error                        result = Error::Ok;
+        std::atomic<bool>            done { false };
     };
 
     // JSON listener for parsing HTTP command options
@@ -54,11 +68,13 @@ namespace WebUI {
 
     // JSON listener for extracting float values from response
     // Used to extract specific keys from JSON response body
-    // Calls set_named_param directly and removes found keys from extractMap
+    // Stores found values in values and removes found keys from extractMap
     class ValueExtractorListener : public JsonListener {
     public:
-        explicit ValueExtractorListener(std::map<std::string, std::string>& extractMap, Channel& out) :
-            _extractMap(extractMap), _out(out) {}
+        explicit ValueExtractorListener(std::map<std::string, std::string>& extractMap,
+                                        std::map<std::string, float>&       values,
+                                        Channel&                            out) :
+            _extractMap(extractMap), _values(values), _out(out) {}
 
         void whitespace(char c) override {}
         void startDocument() override {}
@@ -72,6 +88,7 @@ namespace WebUI {
 
     private:
         std::map<std::string, std::string>& _extractMap;
+        std::map<std::string, float>&       _values;
         Channel&                            _out;
         String                              _currentKey;
         int                                 _depth = 0;
@@ -111,6 +128,9 @@ namespace WebUI {
         // Default request timeout in milliseconds
         static const uint32_t DEFAULT_TIMEOUT_MS = 5000;
 
+        // Background requests that can wait for the background task
+        static const int ASYNC_QUEUE_SIZE = 8;
+
         // Settings file path on LocalFS (stores tokens, etc.)
         static constexpr const char* SETTINGS_FILE_PATH = "/http_settings.json";
 
@@ -136,12 +156,30 @@ namespace WebUI {
 
         // Execute the HTTP request
         // Returns: Error code
-        // Output parameters: status_code (HTTP response code), bytes_received (response body size)
-        static Error execute_request(HttpRequest& request, int& status_code, uint32_t& bytes_received, Channel& out);
+        // Output parameters: status_code (HTTP response code), bytes_received (response body size),
+        // values (extracted values by GCode param name)
+        static Error execute_request(HttpRequest&                  request,
+                                     int&                          status_code,
+                                     uint32_t&                     bytes_received,
+                                     std::map<std::string, float>& values,
+                                     Channel&                      out);
 
         // Store response in GCode parameters
         static void store_response_params(int status_code, uint32_t bytes_received);
 
+        // Queue a request for the background task.  Unless it is fire-and-forget, its
+        // result parameters become pending and are set when the GCode program reads them.
+        static Error execute_async(HttpRequest& request, Channel& out);
+
+        // Wait, while still servicing realtime commands, for a background request to finish
+        static bool wait_for(HttpJob& job);
+
+        // Background task that executes queued requests
+        static void background_task(void* unused);
+
+        static QueueHandle_t _queue;
+        static TaskHandle_t  _task;
+
         // Token storage (loaded from TOKEN_FILE_PATH)
         static std::map<std::string, std::string> _tokens;
 
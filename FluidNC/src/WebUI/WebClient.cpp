@@ -164,6 +164,7 @@ namespace WebUI {
 
     void WebClient::sendLine(MsgLevel level, const char* line) {
         print_msg(level, line);
+        log_release(line);
     }
     void WebClient::sendLine(MsgLevel level, const std::string* line) {
         print_msg(level, line->c_str());
@@ -16,6 +16,8 @@
 #include "WebDAV.h"
 #include "FileStream.h"
 #include "HashFS.h"
+#include "DirCache.h"
+#include "LocalFSMaint.h"
 
 #include "Mime.h"
 
@@ -41,17 +43,15 @@ namespace {
 
         explicit PropfindNodeFrame(stdfs::path node_path, int remaining_depth) : path(std::move(node_path)), level(remaining_depth) {}
 
-        stdfs::path               path;
-        std::string               display_name;
-        std::string               timestr;
-        int32_t                   size            = -1;
-        int                       level           = 0;
-        bool                      is_dir          = false;
-        bool                      initialized     = false;
-        bool                      iter_initialized = false;
-        Stage                     stage           = Stage::Enter;
-        stdfs::directory_iterator iter;
-        stdfs::directory_iterator end;
+        stdfs::path                path;
+        std::string                display_name;
+        std::string                timestr;
+        int32_t                    size        = -1;
+        int                        level       = 0;
+        bool                       is_dir      = false;
+        bool                       initialized = false;
+        Stage                      stage       = Stage::Enter;
+        std::unique_ptr<DirReader> reader;
     };
 
     struct PropfindChunkState {
@@ -85,17 +85,18 @@ namespace {
     };
 
     std::string propfind_time_string(const stdfs::path& fpath) {
-        std::error_code ec;
-        auto            ftime = stdfs::last_write_time(fpath, ec);
-
         // last modified
 #if __cpp_lib_format
+        std::error_code ec;
+        auto            ftime = stdfs::last_write_time(fpath, ec);
         if (ec) {
             return "Fri, 05 Sep 2014 19:00:00 GMT";
         }
         return std::format("{:%c}", ftime);
 #else
 #    if 0
+        std::error_code ec;
+        auto            ftime = stdfs::last_write_time(fpath, ec);
         if (ec) {
             return "Fri, 05 Sep 2014 19:00:00 GMT";
         }
@@ -104,6 +105,7 @@ namespace {
         timestr.pop_back();  // rm the trailing '\n' put by `asctime`
         return timestr;
 #    else
+        // There is no time formatting, so do not stat() every file for its time
         (void)fpath;
         return "Fri, 05 Sep 2014 19:00:00 GMT";
 #    endif
@@ -194,17 +196,25 @@ namespace {
         append_propfind_xml_response(state, metadata_frame);
     }
 
-    void initialize_propfind_iterator(PropfindNodeFrame& frame) {
-        if (frame.iter_initialized) {
-            return;
-        }
+    // The directory listing already has the type and size of each child,
+    // so the child does not have to be looked up again.
+    void push_propfind_child(PropfindChunkState& state, const PropfindNodeFrame& parent, const DirCache::Entry& entry) {
+        state.stack.emplace_back(parent.path / entry.name, parent.level - 1);
 
-        std::error_code ec;
-        frame.iter = stdfs::directory_iterator { frame.path, ec };
-        if (ec) {
-            frame.iter = frame.end;
+        auto& child        = state.stack.back();
+        child.is_dir       = entry.is_dir;
+        child.size         = entry.size;
+        child.display_name = state.replace_fs_name(child.path).string();
+        child.timestr      = propfind_time_string(child.path);
+        child.initialized  = true;
+    }
+
+    // Returns the next child of a directory frame, or nullptr after the last one
+    const DirCache::Entry* next_propfind_child(PropfindNodeFrame& frame) {
+        if (!frame.reader) {
+            frame.reader = std::make_unique<DirReader>(frame.path);
         }
-        frame.iter_initialized = true;
+        return frame.reader->ok() ? frame.reader->next() : nullptr;
     }
 
     bool advance_propfind_json_chunk(PropfindChunkState& state) {
@@ -232,16 +242,13 @@ namespace {
                 return true;
 
             case PropfindNodeFrame::Stage::IterateChildren:
-                initialize_propfind_iterator(frame);
-                if (frame.iter == frame.end) {
+                if (auto entry = next_propfind_child(frame)) {
+                    push_propfind_child(state, frame, *entry);
+                } else {
                     state.encoder->end_array();
                     state.encoder->end_object();
                     state.stack.pop_back();
                     state.encoder->flush();
-                } else {
-                    stdfs::path child_path = frame.iter->path();
-                    ++frame.iter;
-                    state.stack.emplace_back(std::move(child_path), frame.level - 1);
                 }
                 return true;
         }
@@ -270,13 +277,10 @@ namespace {
                 return true;
 
             case PropfindNodeFrame::Stage::IterateChildren:
-                initialize_propfind_iterator(frame);
-                if (frame.iter == frame.end) {
-                    state.stack.pop_back();
+                if (auto entry = next_propfind_child(frame)) {
+                    push_propfind_child(state, frame, *entry);
                 } else {
-                    stdfs::path child_path = frame.iter->path();
-                    ++frame.iter;
-                    state.stack.emplace_back(std::move(child_path), frame.level - 1);
+                    state.stack.pop_back();
                 }
                 return true;
         }
@@ -461,14 +465,10 @@ void WebDAV::handleBody(AsyncWebServerRequest* request, unsigned char* data, siz
                 return request->send(403);
             }
 
-            if (total) {
-                auto avail = stdfs::space(fpath, ec).available;
-                avail -= 4096;  // Reserve a block for overhead
-                if (total > avail) {
-                    log_debug("PUT " << total << " bytes will not fit in available space (" << avail << ")\n");
-                    request->send(507);  // Insufficient storage
-                    return;
-                }
+            if (total && !LocalFSMaint::has_room(fpath, total)) {
+                log_debug("PUT " << total << " bytes will not fit in available space");
+                request->send(507);  // Insufficient storage
+                return;
             }
 
             if (stdfs::is_directory(fpath)) {
@@ -499,6 +499,7 @@ void WebDAV::handleBody(AsyncWebServerRequest* request, unsigned char* data, siz
 
                 if (!ec) {
                     stdfs::remove(fpath, ec);
+                    DirCache::invalidate(fpath);
                 }
 
                 return request->send(507);  // Insufficient storage
@@ -697,6 +698,7 @@ void WebDAV::handleMkcol(const FluidPath& fpath, DavResource resource, AsyncWebS
         // create dir and send response
         std::error_code ec;
         if (stdfs::create_directory(fpath, ec)) {
+            DirCache::invalidate(fpath);
             status = 201;
         } else {
             status = 405;
@@ -722,6 +724,8 @@ void WebDAV::handleMove(const FluidPath& fpath, DavResource resource, AsyncWebSe
         response = request->beginResponse(500, "text/plain", "Unable to move");
     } else {
         std::filesystem::rename(fpath, newpath, ec);
+        DirCache::invalidate(fpath);
+        DirCache::invalidate(newpath);
         if (ec) {
             response = request->beginResponse(500, "text/plain", "Unable to move");
         } else {
@@ -743,6 +747,7 @@ void WebDAV::handleDelete(const FluidPath& fpath, DavResource resource, AsyncWeb
         // remove_all returns the number of items that were deleted
         okay = stdfs::remove_all(fpath, ec) != 0;
     }
+    DirCache::invalidate(fpath);
 
     return request->send(okay ? 204 : 413);
 }
@@ -22,6 +22,8 @@
 #include "Protocol.h"  // protocol_send_event
 #include "FluidPath.h"
 #include "JSONEncoder.h"
+#include "DirCache.h"
+#include "LocalFSMaint.h"
 
 #include "HashFS.h"
 #include <list>
@@ -41,7 +43,7 @@ namespace WebUI {
 
 namespace {
     struct FileListChunkState {
-        enum class Phase : uint8_t { Begin, FileEntries, Footer, End, Done };
+        enum class Phase : uint8_t { Begin, FileEntries, Count, Footer, End, Done };
 
         explicit FileListChunkState(
             FluidPath root,
@@ -61,63 +63,26 @@ namespace {
         FileListChunkState(const FileListChunkState&) = delete;
         FileListChunkState& operator=(const FileListChunkState&) = delete;
 
-        Phase                     phase          = Phase::Begin;
-        stdfs::directory_iterator iter;
-        stdfs::directory_iterator end;
-        FluidPath                 root_path;
-        std::string               path;
-        std::string               status;
-        std::string               total;
-        std::string               used;
-        std::string               pending;
-        size_t                    pending_offset = 0;
-        uint8_t                   percent        = 100;
-        bool                      emit_files     = false;
-        JSONencoder               encoder;
+        Phase                      phase          = Phase::Begin;
+        std::unique_ptr<DirReader> reader;
+        FluidPath                  root_path;
+        std::string                path;
+        std::string                status;
+        std::string                total;
+        std::string                used;
+        std::string                pending;
+        size_t                     pending_offset = 0;
+        uint8_t                    percent        = 100;
+        bool                       emit_files     = false;
+        size_t                     offset         = 0;  // Entries to skip
+        size_t                     limit          = 0;  // Entries to list, 0 for all of them
+        size_t                     count          = 0;  // Entries in the directory
+        size_t                     emitted        = 0;
+        JSONencoder                encoder;
     };
 
-    int32_t file_entry_size(const stdfs::directory_entry& dir_entry) {
-        std::error_code ec;
-
-        if (dir_entry.is_directory(ec) || ec) {
-            return -1;
-        }
-
-        ec = {};
-        if (!dir_entry.is_regular_file(ec) || ec) {
-            return -1;
-        }
-
-        ec = {};
-        auto entry_size = dir_entry.file_size(ec);
-        if (ec || entry_size == static_cast<uintmax_t>(-1)) {
-            return -1;
-        }
-
-        return static_cast<int32_t>(entry_size);
-    }
-
-    void advance_file_iterator(FileListChunkState& state) {
-        std::error_code ec;
-        state.iter.increment(ec);
-        if (ec) {
-            state.iter = state.end;
-        }
-    }
-
-    void append_file_entry(FileListChunkState& state) {
-        const auto& dir_entry = *state.iter;
-        std::string name      = dir_entry.path().filename().string();
-        int32_t     size      = file_entry_size(dir_entry);
-
-        state.encoder.begin_object();
-        state.encoder.member("name", name);
-        state.encoder.member("shortname", name);
-        state.encoder.member("size", size);
-        state.encoder.member("datetime", "");
-        state.encoder.end_object();
-        advance_file_iterator(state);
-    }
+    // The most entries that the Count phase reads per step
+    const size_t count_batch = 32;
 
     bool advance_file_list_chunk(FileListChunkState& state) {
         switch (state.phase) {
@@ -125,6 +90,7 @@ namespace {
                 state.encoder.begin();
                 if (state.emit_files) {
                     state.encoder.begin_array("files");
+                    state.count = state.reader->skip(state.offset);
                     state.phase = FileListChunkState::Phase::FileEntries;
                 } else {
                     state.phase = FileListChunkState::Phase::Footer;
@@ -132,15 +98,35 @@ namespace {
                 state.encoder.flush();
                 return true;
 
-            case FileListChunkState::Phase::FileEntries:
-                if (state.iter == state.end) {
+            case FileListChunkState::Phase::FileEntries: {
+                // The cached entries carry their JSON text, so they bypass the encoder
+                const DirCache::Entry* entry = nullptr;
+                if (!state.limit || state.emitted < state.limit) {
+                    entry = state.reader->next();
+                }
+                if (entry) {
+                    if (state.emitted++) {
+                        state.pending += ",\n";
+                    }
+                    state.pending += entry->json;
+                    ++state.count;
+                } else {
                     state.encoder.end_array();
+                    state.phase = state.limit ? FileListChunkState::Phase::Count : FileListChunkState::Phase::Footer;
+                    state.encoder.flush();
+                }
+                return true;
+            }
+
+            case FileListChunkState::Phase::Count: {
+                // Reading to the end also lets the reader cache the directory
+                size_t n = state.reader->skip(count_batch);
+                state.count += n;
+                if (n < count_batch) {
                     state.phase = FileListChunkState::Phase::Footer;
-                } else {
-                    append_file_entry(state);
                 }
-                state.encoder.flush();
                 return true;
+            }
 
             case FileListChunkState::Phase::Footer:
                 state.encoder.member("path", state.path.c_str());
@@ -148,6 +134,10 @@ namespace {
                 state.encoder.member("used", state.used.c_str());
                 state.encoder.member("occupation", state.percent);
                 state.encoder.member("status", state.status.c_str());
+                if (state.emit_files && state.limit) {
+                    state.encoder.member("offset", int32_t(state.offset));
+                    state.encoder.member("count", int32_t(state.count));
+                }
                 state.phase = FileListChunkState::Phase::End;
                 state.encoder.flush();
                 return true;
@@ -168,7 +158,9 @@ namespace {
                                                       const FluidPath&          fpath,
                                                       const std::string&        path,
                                                       const std::string&        status,
-                                                      bool                      list_files) {
+                                                      bool                      list_files,
+                                                      size_t                    offset,
+                                                      size_t                    limit) {
         std::error_code ec;
         auto            space      = stdfs::space(fpath, ec);
         uint64_t        totalspace = space.capacity;
@@ -184,8 +176,10 @@ namespace {
             percent);
 
         if (list_files) {
-            state->iter       = stdfs::directory_iterator { fpath, stdfs::directory_options::skip_permission_denied, ec };
-            state->emit_files = !ec;
+            state->reader     = std::make_unique<DirReader>(fpath);
+            state->emit_files = state->reader->ok();
+            state->offset     = offset;
+            state->limit      = limit;
         }
 
         AsyncWebServerResponse* response = request->beginChunkedResponse(
@@ -254,7 +248,8 @@ namespace WebUI {
     uint8_t           WebUI_Server::_nb_ip = 0;
     const int         MAX_AUTH_IP          = 10;
 #endif
-    FileStream* WebUI_Server::_uploadFile = nullptr;
+    FileStream*          WebUI_Server::_uploadFile    = nullptr;
+    GcodeCodec::Encoder* WebUI_Server::_uploadEncoder = nullptr;
     std::string WebUI_Server::_uploadPath = "";  // Store upload directory path for listing
 
     EnumSetting *http_enable, *http_block_during_motion;
@@ -1213,6 +1208,7 @@ namespace WebUI {
             if (action == "delete") {
                 if (stdfs::remove(fpath / filename, ec)) {
                     sstatus = filename + " deleted";
+                    DirCache::invalidate(fpath / filename);
                     HashFS::delete_file(fpath / filename);
                 } else {
                     sstatus = "Cannot delete ";
@@ -1224,6 +1220,7 @@ namespace WebUI {
                 size_t count = stdfs::remove_all(dirpath, ec);
                 if (count > 0) {
                     sstatus = filename + " deleted";
+                    DirCache::invalidate(dirpath);
                     HashFS::report_change();
                 } else {
                     log_debug("remove_all returned " << count);
@@ -1233,6 +1230,7 @@ namespace WebUI {
             } else if (action == "createdir") {
                 if (stdfs::create_directory(fpath / filename, ec)) {
                     sstatus = filename + " created";
+                    DirCache::invalidate(fpath / filename);
                     HashFS::report_change();
                 } else {
                     sstatus = "Cannot create ";
@@ -1249,6 +1247,8 @@ namespace WebUI {
                         sstatus += filename + " " + ec.message();
                     } else {
                         sstatus = filename + " renamed to " + newname;
+                        DirCache::invalidate(fpath / filename);
+                        DirCache::invalidate(fpath / newname);
                         HashFS::rename_file(fpath / filename, fpath / newname);
                     }
                 }
@@ -1260,7 +1260,17 @@ namespace WebUI {
             list_files = false;
         }
 
-        request->send(create_file_list_response(request, fpath, path, sstatus, list_files));
+        // Large directories can be listed a page at a time
+        size_t offset = 0;
+        size_t limit  = 0;
+        if (request->hasParam("offset")) {
+            offset = strtoul(request->getParam("offset")->value().c_str(), nullptr, 10);
+        }
+        if (request->hasParam("limit")) {
+            limit = strtoul(request->getParam("limit")->value().c_str(), nullptr, 10);
+        }
+
+        request->send(create_file_list_response(request, fpath, path, sstatus, list_files, offset, limit));
     }
 
     void WebUI_Server::handle_direct_SDFileList(AsyncWebServerRequest* request) {
@@ -1289,23 +1299,26 @@ namespace WebUI {
             _uploadPath = "";  // Root directory
         }
 
-        auto space = stdfs::space(fpath);
-        if (filesize && filesize > space.available) {
-            // If the file already exists, maybe there will be enough space
-            // when we replace it.
-            auto existing_size = stdfs::file_size(fpath, ec);
-            if (ec || (filesize > (space.available + existing_size))) {
-                _upload_status = UploadStatus::FAILED;
-                log_info("Upload not enough space");
-                pushError(request, ESP_ERROR_NOT_ENOUGH_SPACE, "Upload rejected, not enough space");
-                return;
-            }
+        if (filesize && !LocalFSMaint::has_room(fpath, filesize)) {
+            _upload_status = UploadStatus::FAILED;
+            log_info("Upload not enough space");
+            pushError(request, ESP_ERROR_NOT_ENOUGH_SPACE, "Upload rejected, not enough space");
+            return;
         }
 
         if (_upload_status != UploadStatus::FAILED) {
             //Create file for writing
             try {
-                _uploadFile    = new FileStream(fpath, "w");
+                _uploadFile = new FileStream(fpath, "w");
+                // Hand the filesystem whole blocks rather than network packets
+                LittleFSUsage::Geometry geometry;
+                if (LocalFSMaint::geometry(geometry)) {
+                    _uploadFile->set_write_buffer(geometry.block_size);
+                }
+                // /files?compress stores G-code compressed; jobs decompress it as they run
+                if (request->hasArg("compress")) {
+                    _uploadEncoder = new GcodeCodec::Encoder([](const uint8_t* data, size_t len) { return _uploadFile->write(data, len) == len; });
+                }
                 _upload_status = UploadStatus::ONGOING;
             } catch (const Error err) {
                 _uploadFile    = nullptr;
@@ -1320,7 +1333,8 @@ namespace WebUI {
         delay_ms(1);
         if (_uploadFile && _upload_status == UploadStatus::ONGOING) {
             //no error write post data
-            if (length != _uploadFile->write(buffer, length)) {
+            bool written = _uploadEncoder ? _uploadEncoder->write(buffer, length) : length == _uploadFile->write(buffer, length);
+            if (!written) {
                 _upload_status = UploadStatus::FAILED;
                 log_info("Upload failed - file write failed");
                 pushError(request, ESP_ERROR_FILE_WRITE, "File write failed");
@@ -1338,7 +1352,18 @@ namespace WebUI {
             //            delete _uploadFile;
             // _uploadFile = nullptr;
 
-            std::string pathname = _uploadFile->fpath();
+            std::string pathname      = _uploadFile->fpath();
+            size_t      received_size = 0;
+            if (_uploadEncoder) {
+                if (!_uploadEncoder->finish()) {
+                    _upload_status = UploadStatus::FAILED;
+                    pushError(request, ESP_ERROR_FILE_WRITE, "File write failed");
+                }
+                received_size = _uploadEncoder->bytes_in();
+                log_info("Upload compressed " << received_size << " bytes to " << _uploadEncoder->bytes_out());
+                delete _uploadEncoder;
+                _uploadEncoder = nullptr;
+            }
             delete _uploadFile;
             _uploadFile = nullptr;
             log_debug("pathname " << pathname);
@@ -1349,10 +1374,12 @@ namespace WebUI {
 
             // Check size
             if (filesize) {
-                size_t actual_size;
-                try {
-                    actual_size = stdfs::file_size(filepath);
-                } catch (const Error err) { actual_size = 0; }
+                size_t actual_size = received_size;
+                if (!actual_size) {
+                    try {
+                        actual_size = stdfs::file_size(filepath);
+                    } catch (const Error err) { actual_size = 0; }
+                }
 
                 if (filesize != actual_size) {
                     _upload_status = UploadStatus::FAILED;
@@ -1375,6 +1402,8 @@ namespace WebUI {
     void WebUI_Server::uploadStop() {
         _upload_status = UploadStatus::FAILED;
         _uploadPath.clear();  // Clear stored upload path on failure
+        delete _uploadEncoder;
+        _uploadEncoder = nullptr;
         if (_uploadFile) {
             log_info("Upload cancelled");
             std::filesystem::path filepath = _uploadFile->fpath();
@@ -1387,11 +1416,14 @@ namespace WebUI {
         std::error_code error_code;
         if (_upload_status == UploadStatus::FAILED) {
             cancelUpload(request);
+            delete _uploadEncoder;
+            _uploadEncoder = nullptr;
             if (_uploadFile) {
                 std::filesystem::path filepath = _uploadFile->fpath();
                 delete _uploadFile;
                 _uploadFile = nullptr;
                 stdfs::remove(filepath, error_code);
+                DirCache::invalidate(filepath);
                 HashFS::rehash_file(filepath);
             }
         }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "FileStream.h"
+#include "GcodeCodec.h"
 
 #include "Settings.h"
 #include "Module.h"
@@ -67,12 +68,13 @@ namespace WebUI {
         static AsyncWebSocket*            _socket_server;
         static std::string                current_session;
 
-        static uint16_t     _port;
-        static UploadStatus _upload_status;
-        static FileStream*  _uploadFile;
-        static std::string  _uploadPath;  // Store upload directory path for listing
-        static bool         _schedule_reboot;
-        static uint32_t     _schedule_reboot_time;
+        static uint16_t             _port;
+        static UploadStatus         _upload_status;
+        static FileStream*          _uploadFile;
+        static GcodeCodec::Encoder* _uploadEncoder;  // Set when the upload is stored compressed
+        static std::string          _uploadPath;     // Store upload directory path for listing
+        static bool                 _schedule_reboot;
+        static uint32_t             _schedule_reboot_time;
 
         static AuthenticationLevel is_authenticated();
 #ifdef ENABLE_AUTHENTICATION
@@ -0,0 +1,147 @@
+// Copyright (c) 2026 - FluidNC contributors
+// Use of this source code is governed by a GPLv3 license that can be found in the LICENSE file.
+
+// Host benchmark of the SD card read-ahead cache.
+//
+// Reads a job file's worth of sectors from a disk image the way FATFS does
+// when FileStream reads a file: one sector at a time, with a FAT sector read
+// whenever the cluster chain moves past the FAT sector in FATFS's window.  The image is read through stdfs, and the time an
+// SDSPI card would take is modeled from a per-command overhead and the SPI
+// clock.  Prefetches are modeled as running while the consumer (the G-code
+// parser) works through the previous chunk, so only the part of a prefetch
+// that takes longer than that is charged.
+//
+//   pio run -e sd_benchmark
+//   .pio/build/sd_benchmark/program sdcard.img [job_mb] [clock_mhz] [cmd_us] [consume_us_per_kb]
+//
+// Without an image, a scratch image is created in the temp directory.
+
+#include "BlockCache.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace stdfs = std::filesystem;
+
+namespace {
+    const uint32_t SECTOR          = 512;
+    const uint32_t CLUSTER_SECTORS = 64;  // 32 KiB clusters, typical for SDHC
+    const uint32_t FAT_START       = 32;
+
+    struct Model {
+        double clock_mhz;
+        double cmd_us;
+        double consume_us_per_kb;
+    };
+
+    struct Device {
+        std::ifstream image;
+        uint32_t      sectors;
+        Model         model;
+        uint32_t      commands    = 0;
+        uint64_t      bytes       = 0;
+        double        demand_us   = 0;
+        double        prefetch_us = 0;
+        bool          prefetching = false;
+
+        double cost_us(uint32_t count) const { return model.cmd_us + count * SECTOR * 8 / model.clock_mhz; }
+
+        bool read(uint32_t sector, uint32_t count, uint8_t* buf) {
+            image.seekg(uint64_t(sector) * SECTOR);
+            image.read(reinterpret_cast<char*>(buf), uint64_t(count) * SECTOR);
+            ++commands;
+            bytes += uint64_t(count) * SECTOR;
+            // A prefetch overlaps with parsing the chunk before it
+            double cost = cost_us(count);
+            if (prefetching) {
+                double hidden = model.consume_us_per_kb * count * SECTOR / 1024;
+                prefetch_us += cost > hidden ? cost - hidden : 0;
+            } else {
+                demand_us += cost;
+            }
+            return bool(image);
+        }
+    };
+
+    void report(const char* name, Device& dev, uint32_t job_sectors, double wall_ms) {
+        double us = dev.demand_us + dev.prefetch_us;
+        double mb = double(job_sectors) * SECTOR / (1024 * 1024);
+        printf("%-22s %8u commands %10.1f KiB/s modeled %8.1f ms host\n", name, dev.commands, mb * 1024 / (us / 1e6), wall_ms);
+    }
+
+    template <typename ReadSector>
+    double run_job(uint32_t first, uint32_t job_sectors, ReadSector read_sector) {
+        std::vector<uint8_t> buf(SECTOR);
+        uint32_t             fat_window = UINT32_MAX;
+        auto                 start      = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < job_sectors; ++i) {
+            // Follow the cluster chain; each FAT32 sector holds 128 entries
+            uint32_t fat_sector = FAT_START + (first + i) / CLUSTER_SECTORS / (SECTOR / 4);
+            if (fat_sector != fat_window) {
+                read_sector(fat_sector, buf.data());
+                fat_window = fat_sector;
+            }
+            read_sector(first + i, buf.data());
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char** argv) {
+    stdfs::path image = argc > 1 ? stdfs::path(argv[1]) : stdfs::temp_directory_path() / "fluidnc_sd_benchmark.img";
+    uint32_t    job_mb = argc > 2 ? atoi(argv[2]) : 8;
+    Model       model { argc > 3 ? atof(argv[3]) : 20.0, argc > 4 ? atof(argv[4]) : 150.0, argc > 5 ? atof(argv[5]) : 200.0 };
+
+    uint32_t job_sectors = job_mb * 1024 * 1024 / SECTOR;
+    uint32_t first       = 8192;  // Start of the data area
+    if (!stdfs::exists(image)) {
+        std::ofstream out(image, std::ios::binary);
+        std::vector<char> zeros(1024 * 1024, 0);
+        for (uint32_t mb = 0; mb < job_mb + 8; ++mb) {
+            out.write(zeros.data(), zeros.size());
+        }
+    }
+    uint32_t sectors = stdfs::file_size(image) / SECTOR;
+    if (first + job_sectors > sectors) {
+        fprintf(stderr, "%s is too small for a %u MiB job\n", image.c_str(), job_mb);
+        return 1;
+    }
+    printf("%s: %u MiB job, %.1f MHz clock, %.0f us per command, %.0f us per KiB parsed\n",
+           image.c_str(),
+           job_mb,
+           model.clock_mhz,
+           model.cmd_us,
+           model.consume_us_per_kb);
+
+    {
+        Device dev { std::ifstream(image, std::ios::binary), sectors, model };
+        double ms = run_job(first, job_sectors, [&](uint32_t sector, uint8_t* buf) { dev.read(sector, 1, buf); });
+        report("uncached", dev, job_sectors, ms);
+    }
+
+    for (uint32_t kb : { 4, 8, 16, 32 }) {
+        for (bool prefetch : { false, true }) {
+            Device     dev { std::ifstream(image, std::ios::binary), sectors, model };
+            BlockCache cache([&](uint32_t sector, uint32_t count, uint8_t* buf) { return dev.read(sector, count, buf); },
+                             SECTOR,
+                             kb * 1024 / SECTOR,
+                             sectors);
+            double     ms = run_job(first, job_sectors, [&](uint32_t sector, uint8_t* buf) {
+                cache.read(buf, sector, 1);
+                if (prefetch && cache.prefetch_pending()) {
+                    dev.prefetching = true;
+                    cache.prefetch();
+                    dev.prefetching = false;
+                }
+            });
+            char name[32];
+            snprintf(name, sizeof(name), "%2u KiB%s", kb, prefetch ? " + prefetch" : "");
+            report(name, dev, job_sectors, ms);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+// Test suite for the SD card read-ahead cache
+#include "gtest/gtest.h"
+#include "BlockCache.h"
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+const uint32_t SECTOR = 512;
+
+// A device whose sector N is filled with the low byte of N, which counts its reads
+struct FakeDevice {
+    uint32_t              sectors;
+    std::vector<uint32_t> reads;  // Sector counts of each read
+    bool                  fail = false;
+
+    BlockCache::ReadFn reader() {
+        return [this](uint32_t sector, uint32_t count, uint8_t* buf) {
+            if (fail) {
+                return false;
+            }
+            reads.push_back(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                memset(buf + i * SECTOR, uint8_t(sector + i), SECTOR);
+            }
+            return true;
+        };
+    }
+};
+
+bool holds(const std::vector<uint8_t>& buf, uint32_t first) {
+    for (size_t i = 0; i < buf.size(); ++i) {
+        if (buf[i] != uint8_t(first + i / SECTOR)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(BlockCache, SmallReadsAreWidenedToChunks) {
+    FakeDevice           dev { 1000, {}, false };
+    BlockCache           cache(dev.reader(), SECTOR, 8, dev.sectors);
+    std::vector<uint8_t> buf(SECTOR);
+    ASSERT_TRUE(cache.ok());
+
+    for (uint32_t s = 16; s < 24; ++s) {
+        ASSERT_TRUE(cache.read(buf.data(), s, 1));
+        EXPECT_TRUE(holds(buf, s));
+    }
+    ASSERT_EQ(dev.reads.size(), 1u);
+    EXPECT_EQ(dev.reads[0], 8u);
+    EXPECT_EQ(cache.stats().misses, 1u);
+    EXPECT_EQ(cache.stats().hits, 7u);
+}
+
+TEST(BlockCache, SequentialReadsPrefetchTheNextChunk) {
+    FakeDevice           dev { 1000, {}, false };
+    BlockCache           cache(dev.reader(), SECTOR, 8, dev.sectors);
+    std::vector<uint8_t> buf(SECTOR);
+
+    ASSERT_TRUE(cache.read(buf.data(), 0, 1));
+    EXPECT_FALSE(cache.prefetch_pending());
+    ASSERT_TRUE(cache.read(buf.data(), 8, 1));
+    ASSERT_TRUE(cache.prefetch_pending());
+    EXPECT_TRUE(cache.prefetch());
+    EXPECT_FALSE(cache.prefetch_pending());
+
+    size_t reads = dev.reads.size();
+    for (uint32_t s = 16; s < 24; ++s) {
+        ASSERT_TRUE(cache.read(buf.data(), s, 1));
+        EXPECT_TRUE(holds(buf, s));
+    }
+    EXPECT_EQ(dev.reads.size(), reads);
+    EXPECT_EQ(cache.stats().prefetches, 1u);
+}
+
+TEST(BlockCache, FatReadsDoNotBreakTheSequence) {
+    FakeDevice           dev { 1000, {}, false };
+    BlockCache           cache(dev.reader(), SECTOR, 8, dev.sectors);
+    std::vector<uint8_t> buf(SECTOR);
+
+    ASSERT_TRUE(cache.read(buf.data(), 100, 1));
+    ASSERT_TRUE(cache.read(buf.data(), 2, 1));  // FAT sector
+    ASSERT_TRUE(cache.read(buf.data(), 104, 1));
+    EXPECT_TRUE(cache.prefetch_pending());
+}
+
+TEST(BlockCache, WholeChunksBypassTheCache) {
+    FakeDevice           dev { 1000, {}, false };
+    BlockCache           cache(dev.reader(), SECTOR, 8, dev.sectors);
+    std::vector<uint8_t> buf(SECTOR * 20);
+
+    ASSERT_TRUE(cache.read(buf.data(), 32, 20));
+    EXPECT_TRUE(holds(buf, 32));
+    ASSERT_EQ(dev.reads.size(), 2u);
+    EXPECT_EQ(dev.reads[0], 16u);  // One multi-block read of two chunks
+    EXPECT_EQ(dev.reads[1], 8u);   // The partial chunk is cached
+    EXPECT_EQ(cache.stats().direct, 1u);
+}
+
+TEST(BlockCache, LastChunkIsShort) {
+    FakeDevice           dev { 20, {}, false };
+    BlockCache           cache(dev.reader(), SECTOR, 8, dev.sectors);
+    std::vector<uint8_t> buf(SECTOR);
+
+    ASSERT_TRUE(cache.read(buf.data(), 19, 1));
+    EXPECT_TRUE(holds(buf, 19));
+    EXPECT_EQ(dev.reads.back(), 4u);
+    EXPECT_FALSE(cache.read(buf.data(), 20, 1));
+}
+
+TEST(BlockCache, InvalidateDropsStaleData) {
+    FakeDevice           dev { 1000, {}, false };
+    BlockCache           cache(dev.reader(), SECTOR, 8, dev.sectors);
+    std::vector<uint8_t> buf(SECTOR);
+
+    ASSERT_TRUE(cache.read(buf.data(), 40, 1));
+    cache.invalidate(45, 1);
+    ASSERT_TRUE(cache.read(buf.data(), 41, 1));
+    EXPECT_EQ(dev.reads.size(), 2u);
+}
+
+TEST(BlockCache, ErrorsAreReported) {
+    FakeDevice           dev { 1000, {}, false };
+    BlockCache           cache(dev.reader(), SECTOR, 8, dev.sectors);
+    std::vector<uint8_t> buf(SECTOR);
+
+    dev.fail = true;
+    EXPECT_FALSE(cache.read(buf.data(), 0, 1));
+    EXPECT_EQ(cache.stats().errors, 1u);
+    dev.fail = false;
+    EXPECT_TRUE(cache.read(buf.data(), 0, 1));
+    EXPECT_TRUE(holds(buf, 0));
+}
+
+}  // namespace
@@ -0,0 +1,54 @@
+// Test suite for the segment and planner buffer sizing
+#include "gtest/gtest.h"
+#include "BufferSizer.h"
+
+namespace {
+
+TEST(BufferSizer, NothingMeasured) {
+    BufferSizer s;
+    EXPECT_EQ(s.segments(10000, 6, 20), 0u);
+    EXPECT_EQ(s.blocks(10, 120), 0u);
+}
+
+TEST(BufferSizer, Series) {
+    BufferSizer::Series series;
+    series.add(100);
+    series.add(300);
+    series.add(200);
+    EXPECT_EQ(series.count, 3u);
+    EXPECT_EQ(series.min, 100u);
+    EXPECT_EQ(series.max, 300u);
+    EXPECT_EQ(series.mean(), 200u);
+}
+
+TEST(BufferSizer, SegmentsCoverTheLongestGap) {
+    BufferSizer s;
+    s.prep(5000, 200);
+    s.prep(40000, 300);
+    // 40 ms with a 1.5 margin is 60 ms, six 10 ms segments plus the one executing
+    EXPECT_EQ(s.segments(10000, 6, 20), 7u);
+
+    s.prep(200000, 300);
+    EXPECT_EQ(s.segments(10000, 6, 20), 20u);
+
+    s.reset();
+    s.prep(1000, 100);
+    EXPECT_EQ(s.segments(10000, 6, 20), 6u);
+}
+
+TEST(BufferSizer, BlocksCoverTheLongestInputWait) {
+    BufferSizer s;
+    s.line(100000);
+    EXPECT_EQ(s.blocks(10, 120), 0u);  // No block times yet
+
+    s.block(4000);
+    s.block(6000);
+    // 100 ms with a 1.5 margin is 150 ms, 30 blocks of 5 ms plus two
+    EXPECT_EQ(s.blocks(10, 120), 32u);
+
+    s._margin = 1.0f;
+    EXPECT_EQ(s.blocks(10, 120), 22u);
+    EXPECT_EQ(s.blocks(10, 16), 16u);
+}
+
+}
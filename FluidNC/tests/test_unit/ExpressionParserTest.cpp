@@ -447,4 +447,53 @@ TEST(ComparativeTest, OperatorPrecedence) {
     }
 }
 
+// ============================================================================
+// Pending Named Parameters (asynchronous results)
+// ============================================================================
+
+TEST(PendingParamTest, ResolvedOnFirstRead) {
+    int calls = 0;
+    set_named_param_pending("_pending_a", [&calls](float& value) {
+        ++calls;
+        value = 42.0f;
+        return true;
+    });
+    EXPECT_EQ(calls, 0);
+
+    float  result;
+    size_t pos = 0;
+    EXPECT_TRUE(read_number("#<_pending_a>", pos, result));
+    EXPECT_FLOAT_EQ(result, 42.0f);
+
+    // Later reads use the stored value
+    pos = 0;
+    EXPECT_TRUE(read_number("#<_PENDING_A>", pos, result));
+    EXPECT_FLOAT_EQ(result, 42.0f);
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(PendingParamTest, CancelledBySet) {
+    bool called = false;
+    set_named_param_pending("_pending_b", [&called](float& value) {
+        called = true;
+        value  = 1.0f;
+        return true;
+    });
+    set_named_param("_pending_b", 7.0f);
+
+    float  result;
+    size_t pos = 0;
+    EXPECT_TRUE(read_number("#<_pending_b>", pos, result));
+    EXPECT_FLOAT_EQ(result, 7.0f);
+    EXPECT_FALSE(called);
+}
+
+TEST(PendingParamTest, FailedResolveFailsRead) {
+    set_named_param_pending("_pending_c", [](float& value) { return false; });
+
+    float  result;
+    size_t pos = 0;
+    EXPECT_FALSE(read_number("#<_pending_c>", pos, result));
+}
+
 }  // namespace
@@ -0,0 +1,79 @@
+// Test suite for the adaptive feed control law
+#include "gtest/gtest.h"
+#include "FeedController.h"
+
+namespace {
+
+FeedController controller() {
+    FeedController c;
+    c._target_load  = 70;
+    c._deadband     = 3;
+    c._gain         = 1;
+    c._min_feed     = 50;
+    c._max_feed     = 120;
+    c._smoothing_ms = 300;
+    return c;
+}
+
+TEST(FeedController, StartsAtFullFeed) {
+    auto c = controller();
+    EXPECT_EQ(c.feed(), 100u);
+    EXPECT_EQ(c.update(70, 100), 100u);
+    EXPECT_FLOAT_EQ(c.load(), 70);
+}
+
+TEST(FeedController, LightLoadSpeedsUpToTheLimit) {
+    auto     c    = controller();
+    uint32_t last = 100;
+    for (int i = 0; i < 3; ++i) {
+        uint32_t feed = c.update(10, 100);
+        EXPECT_GT(feed, last);
+        last = feed;
+    }
+    for (int i = 0; i < 100; ++i) {
+        c.update(10, 100);
+    }
+    EXPECT_EQ(c.feed(), 120u);
+}
+
+TEST(FeedController, HeavyLoadSlowsDownToTheLimit) {
+    auto c = controller();
+    for (int i = 0; i < 100; ++i) {
+        c.update(100, 100);
+    }
+    EXPECT_EQ(c.feed(), 50u);
+}
+
+TEST(FeedController, DeadbandHoldsTheFeed) {
+    auto c = controller();
+    for (int i = 0; i < 50; ++i) {
+        c.update(72, 100);
+        c.update(68, 100);
+    }
+    EXPECT_EQ(c.feed(), 100u);
+}
+
+TEST(FeedController, SmoothingDelaysTheResponse) {
+    auto c = controller();
+    c.update(70, 100);
+    c.update(100, 100);
+    // One sample a third of the time constant in moves the filter a quarter of the way
+    EXPECT_NEAR(c.load(), 77.5, 0.01);
+
+    c._smoothing_ms = 0;
+    c.update(100, 100);
+    EXPECT_FLOAT_EQ(c.load(), 100);
+}
+
+TEST(FeedController, ResetReturnsToFullFeed) {
+    auto c = controller();
+    for (int i = 0; i < 20; ++i) {
+        c.update(100, 100);
+    }
+    EXPECT_LT(c.feed(), 100u);
+    c.reset();
+    EXPECT_EQ(c.feed(), 100u);
+    EXPECT_LT(c.load(), 0);
+}
+
+}
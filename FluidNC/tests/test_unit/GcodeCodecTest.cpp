@@ -0,0 +1,168 @@
+// Test suite for the G-code compression codec
+#include "gtest/gtest.h"
+#include "GcodeCodec.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+Bytes compress(const std::string& text, size_t chunk = 1000, uint32_t window_log2 = 13) {
+    Bytes               out;
+    GcodeCodec::Encoder encoder([&out](const uint8_t* data, size_t len) {
+        out.insert(out.end(), data, data + len);
+        return true;
+    },
+                                window_log2);
+    for (size_t pos = 0; pos < text.size(); pos += chunk) {
+        size_t len = std::min(chunk, text.size() - pos);
+        EXPECT_TRUE(encoder.write((const uint8_t*)text.data() + pos, len));
+    }
+    EXPECT_TRUE(encoder.finish());
+    EXPECT_EQ(encoder.bytes_in(), text.size());
+    EXPECT_EQ(encoder.bytes_out(), out.size());
+    return out;
+}
+
+// Reads compressed data from memory the way InputFile reads it from a file
+struct MemoryDecoder {
+    Bytes               data;
+    size_t              pos = GcodeCodec::header_size;
+    GcodeCodec::Decoder decoder;
+
+    explicit MemoryDecoder(const Bytes& compressed) :
+        data(compressed), decoder([this](uint8_t* buf, size_t len) {
+            len = std::min(len, data.size() - pos);
+            std::copy_n(data.begin() + pos, len, buf);
+            pos += len;
+            return len;
+        },
+                                  compressed[3]) {}
+
+    std::string all() {
+        std::string text;
+        int         c;
+        while ((c = decoder.get()) >= 0) {
+            text += char(c);
+        }
+        return text;
+    }
+};
+
+// A raster pass, like an engraving or surfacing job
+std::string gcode(size_t lines) {
+    std::string text = "G21\nG90\nM3 S12000\n";
+    char        line[80];
+    for (size_t i = 0; i < lines; ++i) {
+        snprintf(line, sizeof(line), "G1 X%.3f Y%.3f F1500\n", i % 2 ? 0.0 : 150.0, i * 0.127);
+        text += line;
+    }
+    return text + "M5\nM30\n";
+}
+
+std::string random_bytes(size_t len) {
+    std::mt19937 rng(2);
+    std::string  text(len, '\0');
+    for (auto& c : text) {
+        c = char(rng());
+    }
+    return text;
+}
+
+TEST(GcodeCodec, RoundTripsGcode) {
+    auto text       = gcode(5000);
+    auto compressed = compress(text);
+    EXPECT_TRUE(GcodeCodec::is_compressed(compressed.data(), compressed.size()));
+    EXPECT_LT(compressed.size() * 3, text.size());
+    MemoryDecoder d(compressed);
+    EXPECT_EQ(d.all(), text);
+    EXPECT_FALSE(d.decoder.failed());
+    EXPECT_EQ(d.decoder.position(), text.size());
+}
+
+TEST(GcodeCodec, RepetitiveProgramsCompressWell) {
+    std::string pass;
+    for (int i = 0; i < 40; ++i) {
+        pass += "G1 X" + std::to_string(i) + ".000 Y10.000\nG1 X" + std::to_string(i) + ".000 Y0.000\n";
+    }
+    std::string text;
+    for (int z = 0; z < 20; ++z) {
+        text += "G1 Z-" + std::to_string(z) + ".5\n" + pass;
+    }
+    auto compressed = compress(text);
+    EXPECT_LT(compressed.size() * 10, text.size());
+    MemoryDecoder d(compressed);
+    EXPECT_EQ(d.all(), text);
+}
+
+TEST(GcodeCodec, RoundTripsIncompressibleData) {
+    auto text       = random_bytes(50000);
+    auto compressed = compress(text, 777);
+    MemoryDecoder d(compressed);
+    EXPECT_EQ(d.all(), text);
+    EXPECT_FALSE(d.decoder.failed());
+}
+
+TEST(GcodeCodec, RoundTripsLongRunsAndSmallWindows) {
+    std::string text(100000, 'x');
+    text += gcode(200);
+    text += std::string(3000, '\n');
+    for (uint32_t window_log2 : { 8, 10, 16 }) {
+        for (size_t chunk : { 1, 100, 70000 }) {
+            MemoryDecoder d(compress(text, chunk, window_log2));
+            EXPECT_EQ(d.all(), text) << "window " << window_log2 << " chunk " << chunk;
+        }
+    }
+}
+
+TEST(GcodeCodec, EmptyInput) {
+    auto compressed = compress("");
+    EXPECT_EQ(compressed.size(), GcodeCodec::header_size + 3);
+    MemoryDecoder d(compressed);
+    EXPECT_EQ(d.all(), "");
+    EXPECT_FALSE(d.decoder.failed());
+}
+
+TEST(GcodeCodec, PlainTextIsNotCompressed) {
+    std::string text = "G0 X0\n";
+    EXPECT_FALSE(GcodeCodec::is_compressed((const uint8_t*)text.data(), text.size()));
+    EXPECT_FALSE(GcodeCodec::is_compressed((const uint8_t*)"FNZ", 3));
+    EXPECT_FALSE(GcodeCodec::is_compressed((const uint8_t*)"FNZ\x30", 4));
+}
+
+TEST(GcodeCodec, ResetDecodesAgainFromTheStart) {
+    auto          text       = gcode(1000);
+    auto          compressed = compress(text);
+    MemoryDecoder d(compressed);
+    uint8_t       buf[5000];
+    EXPECT_EQ(d.decoder.read(buf, sizeof(buf)), sizeof(buf));
+    d.pos = GcodeCodec::header_size;
+    d.decoder.reset();
+    EXPECT_EQ(d.decoder.position(), 0u);
+    EXPECT_EQ(d.all(), text);
+}
+
+TEST(GcodeCodec, TruncatedDataFails) {
+    auto text       = gcode(1000);
+    auto compressed = compress(text);
+    compressed.resize(compressed.size() / 2);
+    MemoryDecoder d(compressed);
+    auto          partial = d.all();
+    EXPECT_TRUE(d.decoder.failed());
+    EXPECT_LT(partial.size(), text.size());
+    EXPECT_EQ(partial, text.substr(0, partial.size()));
+}
+
+TEST(GcodeCodec, BadOffsetFails) {
+    // One literal, then a match reaching back before the start of the data
+    Bytes         compressed = { 'F', 'N', 'Z', 13, 0x10, 'G', 5, 0 };
+    MemoryDecoder d(compressed);
+    EXPECT_EQ(d.all(), "G");
+    EXPECT_TRUE(d.decoder.failed());
+}
+
+}
@@ -0,0 +1,84 @@
+// Test suite for the digital input glitch filter
+#include "gtest/gtest.h"
+#include "InputFilter.h"
+#include <cstdint>
+
+namespace {
+
+const InputFilter::mask_t PIN5 = InputFilter::mask_t(1) << 5;
+
+TEST(InputFilter, UnfilteredInputsPassThrough) {
+    InputFilter filter;
+    EXPECT_EQ(filter.apply(0x12345678), 0x12345678u);
+    filter.sample(0xffffffff);
+    EXPECT_EQ(filter.apply(0), 0u);
+}
+
+TEST(InputFilter, ChangeAcceptedAfterEnoughSamples) {
+    InputFilter filter;
+    filter.set_samples(5, 3, false);
+
+    filter.sample(PIN5);
+    filter.sample(PIN5);
+    EXPECT_EQ(filter.apply(PIN5), 0u);
+    filter.sample(PIN5);
+    EXPECT_EQ(filter.apply(PIN5), PIN5);
+    EXPECT_EQ(filter.apply(0), PIN5);
+    EXPECT_EQ(filter.glitches(5), 0u);
+}
+
+TEST(InputFilter, ShortPulseRejectedAndCounted) {
+    InputFilter filter;
+    filter.set_samples(5, 4, false);
+
+    for (int i = 0; i < 10; ++i) {
+        filter.sample(PIN5);
+        filter.sample(PIN5);
+        filter.sample(0);
+    }
+    EXPECT_EQ(filter.apply(0), 0u);
+    EXPECT_EQ(filter.glitches(5), 10u);
+    EXPECT_EQ(filter.sample_count(), 30u);
+}
+
+TEST(InputFilter, NoisyInputSettlesToTrueLevel) {
+    InputFilter filter;
+    filter.set_samples(5, 8, false);
+
+    // The input switches on, with random single-sample dropouts that a
+    // filter of 8 samples must not react to.
+    uint32_t lcg      = 1;
+    int      accepted = -1;
+    for (int i = 0; i < 200; ++i) {
+        lcg       = lcg * 1103515245 + 12345;
+        bool drop = ((lcg >> 16) % 100) < 10;
+        bool on   = i >= 20 && !drop;
+        filter.sample(on ? PIN5 : 0);
+        if (accepted < 0 && filter.apply(0) == PIN5) {
+            accepted = i;
+        }
+        if (accepted >= 0) {
+            EXPECT_EQ(filter.apply(0), PIN5) << "sample " << i;
+        }
+    }
+    EXPECT_GE(accepted, 27);
+}
+
+TEST(InputFilter, OtherInputsUnaffected) {
+    InputFilter filter;
+    filter.set_samples(5, 2, false);
+    InputFilter::mask_t other = InputFilter::mask_t(1) << 40;
+    filter.sample(other | PIN5);
+    EXPECT_EQ(filter.apply(other | PIN5), other);
+}
+
+TEST(InputFilter, DisablingRestoresPassThrough) {
+    InputFilter filter;
+    filter.set_samples(5, 3, true);
+    EXPECT_EQ(filter.apply(0), PIN5);
+    filter.set_samples(5, 0, false);
+    EXPECT_EQ(filter.filtered(), 0u);
+    EXPECT_EQ(filter.apply(0), 0u);
+}
+
+}
@@ -0,0 +1,96 @@
+// Test suite for the LittleFS usage estimates
+#include "gtest/gtest.h"
+#include "LittleFSUsage.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+namespace stdfs = std::filesystem;
+
+const LittleFSUsage::Geometry geometry { 4096, 512 };
+
+// A directory tree that stands in for the contents of a LittleFS volume
+struct TempTree {
+    stdfs::path root;
+
+    TempTree() {
+        root = stdfs::temp_directory_path() / ("lfs_usage_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "_" +
+                                               ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        stdfs::remove_all(root);
+        stdfs::create_directories(root);
+    }
+    ~TempTree() { stdfs::remove_all(root); }
+
+    void file(const std::string& name, size_t size) {
+        stdfs::create_directories((root / name).parent_path());
+        std::ofstream(root / name, std::ios::binary) << std::string(size, 'x');
+    }
+};
+
+TEST(LittleFSUsage, FileBlocksAllowForSkipListPointers) {
+    EXPECT_EQ(LittleFSUsage::file_blocks(0, geometry), 0u);
+    EXPECT_EQ(LittleFSUsage::file_blocks(1, geometry), 1u);
+    EXPECT_EQ(LittleFSUsage::file_blocks(4096, geometry), 1u);
+    // Block 1 holds one pointer
+    EXPECT_EQ(LittleFSUsage::file_blocks(4096 + 4092, geometry), 2u);
+    EXPECT_EQ(LittleFSUsage::file_blocks(4096 + 4093, geometry), 3u);
+    // Block 2 holds two pointers, block 3 one, block 4 three
+    EXPECT_EQ(LittleFSUsage::file_blocks(4096 + 4092 + 4088 + 4092 + 4084, geometry), 5u);
+    EXPECT_EQ(LittleFSUsage::file_blocks(4096 + 4092 + 4088 + 4092 + 4085, geometry), 6u);
+}
+
+TEST(LittleFSUsage, SmallFilesAreWrittenInline) {
+    EXPECT_EQ(LittleFSUsage::write_blocks(0, geometry), 1u);
+    EXPECT_EQ(LittleFSUsage::write_blocks(512, geometry), 1u);
+    EXPECT_EQ(LittleFSUsage::write_blocks(513, geometry), 2u);
+    EXPECT_EQ(LittleFSUsage::write_blocks(5000, geometry), 3u);
+}
+
+TEST(LittleFSUsage, DirectoriesSplitAtHalfABlock) {
+    EXPECT_EQ(LittleFSUsage::dir_pairs(0, geometry), 1u);
+    EXPECT_EQ(LittleFSUsage::dir_pairs(2048, geometry), 1u);
+    EXPECT_EQ(LittleFSUsage::dir_pairs(2049, geometry), 2u);
+}
+
+TEST(LittleFSUsage, AnalyzeCountsTheTree) {
+    TempTree tree;
+    tree.file("config.yaml", 100);
+    tree.file("job.nc", 5000);
+    tree.file("macros/home.nc", 600);
+
+    auto report = LittleFSUsage::analyze(tree.root, geometry);
+    EXPECT_EQ(report.files, 3u);
+    EXPECT_EQ(report.dirs, 2u);
+    EXPECT_EQ(report.inline_files, 1u);
+    EXPECT_EQ(report.data_bytes, 5700u);
+    // Two blocks for job.nc, one for home.nc, and a metadata pair for each directory
+    EXPECT_EQ(report.min_blocks, 7u);
+}
+
+TEST(LittleFSUsage, ManySmallFilesSpillIntoMorePairs) {
+    TempTree tree;
+    for (int i = 0; i < 20; ++i) {
+        tree.file("m" + std::to_string(i) + ".nc", 200);
+    }
+
+    auto report = LittleFSUsage::analyze(tree.root, geometry);
+    EXPECT_EQ(report.inline_files, 20u);
+    // About 4 KB of inline data and entries needs three pairs
+    EXPECT_EQ(report.min_blocks, 6u);
+}
+
+TEST(LittleFSUsage, OverheadIsRelativeToBlocksInUse) {
+    LittleFSUsage::Report report;
+    report.min_blocks  = 7;
+    report.used_blocks = 14;
+    EXPECT_EQ(report.overhead_percent(), 50u);
+    report.used_blocks = 5;
+    EXPECT_EQ(report.overhead_percent(), 0u);
+    report.used_blocks = 0;
+    EXPECT_EQ(report.overhead_percent(), 0u);
+}
+
+}
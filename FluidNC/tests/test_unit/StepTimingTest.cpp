@@ -0,0 +1,31 @@
+// Test suite for the stepper ISR timing statistics
+#include "gtest/gtest.h"
+#include "StepTiming.h"
+
+namespace {
+
+TEST(StepTiming, NothingMeasured) {
+    StepTiming timing(240);
+    EXPECT_EQ(timing.count(), 0u);
+    EXPECT_EQ(timing.mean_us(), 0.0f);
+    EXPECT_EQ(timing.max_us(), 0.0f);
+    EXPECT_EQ(timing.load(), 0.0f);
+    EXPECT_EQ(timing.run_rate(), 0u);
+    EXPECT_EQ(timing.mean_rate(), 0u);
+    EXPECT_EQ(timing.worst_rate(), 0u);
+}
+
+TEST(StepTiming, TicksToMicroseconds) {
+    StepTiming timing(240);
+    // 1000 runs of 2 us on average, the longest 5 us, in 20 ms
+    timing.set(1000, 1000 * 480, 1200, 20000);
+    EXPECT_EQ(timing.count(), 1000u);
+    EXPECT_FLOAT_EQ(timing.mean_us(), 2.0f);
+    EXPECT_FLOAT_EQ(timing.max_us(), 5.0f);
+    EXPECT_FLOAT_EQ(timing.load(), 10.0f);
+    EXPECT_EQ(timing.run_rate(), 50000u);
+    EXPECT_EQ(timing.mean_rate(), 500000u);
+    EXPECT_EQ(timing.worst_rate(), 200000u);
+}
+
+}
@@ -0,0 +1,164 @@
+// Test suite for the leader/follower motion sync protocol
+#include "gtest/gtest.h"
+#include "SyncProtocol.h"
+
+#include <vector>
+
+namespace {
+
+using namespace SyncProtocol;
+
+std::vector<uint8_t> frame(Writer w) {
+    const uint8_t* data = w.data();
+    return std::vector<uint8_t>(data, data + w.size());
+}
+
+// Pushes bytes into the decoder, returning the number of frames completed
+size_t feed(Decoder& decoder, const std::vector<uint8_t>& bytes) {
+    size_t frames = 0;
+    for (auto byte : bytes) {
+        frames += decoder.push(byte);
+    }
+    return frames;
+}
+
+TEST(SyncProtocol, BlockRoundTrip) {
+    Block block {};
+    block.seq           = 1234567;
+    block.feed_rate     = 1500.5f;
+    block.spindle_speed = 18000;
+    block.motion        = 0x05;
+    block.spindle       = 3;
+    block.coolant       = 2;
+    block.line_number   = -1;
+    block.n_axis        = 6;
+    for (int axis = 0; axis < 6; axis++) {
+        block.target[axis] = axis * 10.25f - 3.0f;
+    }
+
+    auto bytes = frame(encode(block));
+    EXPECT_EQ(bytes.size(), size_t(4 + 20 + 6 * 4));
+
+    Decoder decoder;
+    ASSERT_EQ(feed(decoder, bytes), 1u);
+    EXPECT_EQ(decoder.type(), MsgType::Block);
+
+    Block got {};
+    ASSERT_TRUE(decoder.get(got));
+    EXPECT_EQ(got.seq, block.seq);
+    EXPECT_EQ(got.feed_rate, block.feed_rate);
+    EXPECT_EQ(got.spindle_speed, block.spindle_speed);
+    EXPECT_EQ(got.motion, block.motion);
+    EXPECT_EQ(got.spindle, block.spindle);
+    EXPECT_EQ(got.coolant, block.coolant);
+    EXPECT_EQ(got.line_number, block.line_number);
+    ASSERT_EQ(got.n_axis, block.n_axis);
+    for (int axis = 0; axis < 6; axis++) {
+        EXPECT_EQ(got.target[axis], block.target[axis]);
+    }
+
+    Start start;
+    EXPECT_FALSE(decoder.get(start));  // Wrong type
+}
+
+TEST(SyncProtocol, SmallMessages) {
+    Decoder decoder;
+
+    ASSERT_EQ(feed(decoder, frame(encode(Start { 0xfffffff0 }))), 1u);
+    Start start;
+    ASSERT_TRUE(decoder.get(start));
+    EXPECT_EQ(start.leader_us, 0xfffffff0u);
+
+    ASSERT_EQ(feed(decoder, frame(encode(Segment { 42, 100000 }))), 1u);
+    Segment segment;
+    ASSERT_TRUE(decoder.get(segment));
+    EXPECT_EQ(segment.count, 42u);
+    EXPECT_EQ(segment.leader_us, 100000u);
+
+    ASSERT_EQ(feed(decoder, frame(encode(Pong { 7, 9 }))), 1u);
+    Pong pong;
+    ASSERT_TRUE(decoder.get(pong));
+    EXPECT_EQ(pong.follower_us, 7u);
+    EXPECT_EQ(pong.leader_us, 9u);
+
+    ASSERT_EQ(feed(decoder, frame(encode(Realtime { '!' }))), 1u);
+    Realtime realtime;
+    ASSERT_TRUE(decoder.get(realtime));
+    EXPECT_EQ(realtime.cmd, '!');
+
+    ASSERT_EQ(feed(decoder, frame(encode(Stop { 3 }))), 1u);
+    Stop stop;
+    ASSERT_TRUE(decoder.get(stop));
+    EXPECT_EQ(stop.alarm, 3);
+    EXPECT_FALSE(decoder.get(realtime));
+}
+
+TEST(SyncProtocol, ResyncsAfterNoiseAndBadCrc) {
+    std::vector<uint8_t> bytes = { 0x00, 0x13, 0xA5, 0x04, 0xff };  // Noise, then a frame start with a bad length
+
+    auto bad = frame(encode(Ping { 1000 }));
+    bad[4] ^= 0x01;  // Corrupt the payload
+    bytes.insert(bytes.end(), bad.begin(), bad.end());
+
+    auto good = frame(encode(Ping { 2000 }));
+    bytes.insert(bytes.end(), good.begin(), good.end());
+
+    Decoder decoder;
+    EXPECT_EQ(feed(decoder, bytes), 1u);
+    EXPECT_EQ(decoder.dropped(), 2u);
+    Ping ping;
+    ASSERT_TRUE(decoder.get(ping));
+    EXPECT_EQ(ping.follower_us, 2000u);
+}
+
+TEST(SyncProtocol, ClockSyncUsesShortestRoundTrip) {
+    ClockSync clock;
+    EXPECT_FALSE(clock.valid());
+
+    // The leader clock is 5000 us ahead.  A symmetric 100 us exchange gives
+    // the offset exactly; one delayed on the way back is off by half the delay.
+    clock.add(1000, 1000 + 50 + 5000, 1100);
+    EXPECT_TRUE(clock.valid());
+    EXPECT_EQ(clock.offset(), 5000);
+
+    clock.add(2000, 2000 + 50 + 5000, 2900);
+    EXPECT_EQ(clock.offset(), 5000);
+    EXPECT_EQ(clock.round_trip(), 100u);
+    EXPECT_EQ(clock.to_local(6000 + 5000), 6000u);
+
+    // Once the good exchange leaves the window, the best remaining one is used
+    for (uint32_t i = 0; i < ClockSync::window; i++) {
+        uint32_t t = 10000 + i * 1000;
+        clock.add(t, t + 100 + 5000 + 20, t + 200);
+    }
+    EXPECT_EQ(clock.offset(), 5020);
+    EXPECT_EQ(clock.round_trip(), 200u);
+}
+
+TEST(SyncProtocol, ClockSyncAcrossWrap) {
+    ClockSync clock;
+    clock.add(0xffffff00, 0x00000100, 0x00000010);  // Both clocks wrap
+    EXPECT_EQ(clock.round_trip(), 0x110u);
+    EXPECT_EQ(clock.to_local(0x00000100), 0xffffff88u);
+}
+
+TEST(SyncProtocol, AlignerTrimsTowardTheLeader) {
+    SegmentAligner aligner;
+    EXPECT_GT(aligner.update(200), 0);  // Follower behind, so it speeds up
+    aligner.reset();
+    EXPECT_LT(aligner.update(-200), 0);
+
+    aligner.reset();
+    EXPECT_EQ(aligner.update(1000000), aligner._max_trim);
+
+    // A steady lag builds up the integral term
+    aligner.reset();
+    int32_t first = aligner.update(100);
+    int32_t later = first;
+    for (int i = 0; i < 10; i++) {
+        later = aligner.update(100);
+    }
+    EXPECT_GT(later, first);
+}
+
+}
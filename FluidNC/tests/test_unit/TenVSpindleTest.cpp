@@ -0,0 +1,81 @@
+// Test suite for the 10V spindle speed output
+#include <gtest/gtest.h>
+
+#include "Spindles/10vSpindle.h"
+#include "Pins/PinDetail.h"
+#include "Pins/PinCapabilities.h"
+
+#include "GCode.h"
+#include "System.h"
+#include "NutsBolts.h"
+#include "Machine/Macros.h"
+
+// PlatformIO native test build intentionally compiles a reduced subset of FluidNC.
+// Provide minimal stubs for what the spindle code links against.
+parser_state_t gc_state;
+system_t       sys;
+
+bool dwell_ms(uint32_t milliseconds, DwellMode mode) {
+    return true;
+}
+bool Macro::run(Channel* channel) {
+    return true;
+}
+void gpio_write(pinnum_t pin, bool value) {}
+
+Pin::~Pin() {
+    if (defined()) {
+        delete _detail;
+    }
+}
+
+namespace Spindles {
+    void    Tachometer::init(Spindle* owner) {}
+    bool    Tachometer::at_speed(SpindleSpeed target, uint32_t tolerance_percent) const { return true; }
+    int32_t Tachometer::load_percent(SpindleSpeed commanded) const { return -1; }
+    void    Tachometer::validate() {}
+    void    Tachometer::group(Configuration::HandlerBase& handler) {}
+}
+
+namespace {
+    // An output pin that records what the spindle writes to it
+    class RecordingPin : public Pins::PinDetail {
+    public:
+        uint32_t duty     = 0;
+        int      dutySets = 0;
+        bool     level    = false;
+
+        RecordingPin() : PinDetail(0) { _name = "recording"; }
+
+        Pins::PinCapabilities capabilities() const override {
+            return Pins::PinCapabilities::Output | Pins::PinCapabilities::PWM;
+        }
+        void write(bool high) override { level = high; }
+        void setDuty(uint32_t value) override {
+            duty = value;
+            ++dutySets;
+        }
+        uint32_t            maxDuty() override { return 1 << 16; }
+        bool                read() override { return level; }
+        void                setAttr(Pins::PinAttributes value, uint32_t frequency) override {}
+        Pins::PinAttributes getAttr() const override { return Pins::PinAttributes::Output; }
+    };
+
+    class TestSpindle : public Spindles::_10v {
+    public:
+        explicit TestSpindle(RecordingPin* output) : _10v("10V") { _output_pin = Pin::wrap(output); }
+
+        using _10v::set_output;
+    };
+}
+
+TEST(TenVSpindle, SetOutputWritesTheDuty) {
+    auto*       output = new RecordingPin();  // Owned by the spindle's Pin
+    TestSpindle spindle(output);
+    spindle.init();
+
+    output->dutySets = 0;
+    spindle.set_output(12345);
+    EXPECT_EQ(output->dutySets, 1);
+    EXPECT_EQ(output->duty, 12345u);
+}
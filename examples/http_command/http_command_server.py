@@ -14,7 +14,11 @@ Responds to various endpoints to demonstrate HttpCommand features:
 - /metrics/* - Metrics endpoints
 
 Usage:
-    python3 http_status_server.py [--port 8000]
+    python3 http_status_server.py [--port 8000] [--delay 2000]
+
+--delay makes every response wait that many milliseconds, like a slow shop
+server, so that the difference between synchronous and asynchronous
+($HTTP/Command with "async" or "forget") requests is visible in a job.
 
 Then access:
     curl http://localhost:8000/api/temperature
@@ -24,8 +28,9 @@ Then access:
 
 import json
 import sys
+import time
 import argparse
-from http.server import HTTPServer, BaseHTTPRequestHandler
+from http.server import ThreadingHTTPServer, BaseHTTPRequestHandler
 from urllib.parse import urlparse, parse_qs
 import random
 from datetime import datetime
@@ -40,9 +45,17 @@ except ImportError:
 
 class StatusHandler(BaseHTTPRequestHandler):
     """HTTP request handler supporting multiple endpoints"""
-    
+
+    # Simulated server latency in seconds, set by --delay
+    delay = 0
+
+    def simulate_latency(self):
+        if self.delay:
+            time.sleep(self.delay)
+
     def do_GET(self):
         """Handle GET requests"""
+        self.simulate_latency()
         parsed_path = urlparse(self.path)
         path = parsed_path.path
         
@@ -74,6 +87,7 @@ class StatusHandler(BaseHTTPRequestHandler):
     
     def do_POST(self):
         """Handle POST requests"""
+        self.simulate_latency()
         parsed_path = urlparse(self.path)
         path = parsed_path.path
         
@@ -92,6 +106,7 @@ class StatusHandler(BaseHTTPRequestHandler):
     
     def do_PUT(self):
         """Handle PUT requests"""
+        self.simulate_latency()
         parsed_path = urlparse(self.path)
         path = parsed_path.path
         
@@ -105,6 +120,7 @@ class StatusHandler(BaseHTTPRequestHandler):
     
     def do_DELETE(self):
         """Handle DELETE requests"""
+        self.simulate_latency()
         parsed_path = urlparse(self.path)
         path = parsed_path.path
         
@@ -379,11 +395,19 @@ def main():
         default='0.0.0.0',
         help='Host to bind to (default: 0.0.0.0 - all public interfaces)'
     )
+    parser.add_argument(
+        '--delay',
+        type=int,
+        default=0,
+        help='Milliseconds to wait before every response, to simulate a slow server (default: 0)'
+    )
     
     args = parser.parse_args()
+    StatusHandler.delay = args.delay / 1000
     
     server_address = (args.host, args.port)
-    httpd = HTTPServer(server_address, StatusHandler)
+    # Threaded, so that fire-and-forget posts do not queue behind each other
+    httpd = ThreadingHTTPServer(server_address, StatusHandler)
     
     # Display server info
     display_host = args.host if args.host != '0.0.0.0' else 'all interfaces'
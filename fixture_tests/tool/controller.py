@@ -3,14 +3,19 @@ from termcolor import colored
 
 
 class Controller:
-    def __init__(self, device, baudrate, timeout):
+    def __init__(self, device, baudrate, timeout, transport=None):
         self._debug = False
-        self._serial = serial.Serial(device, baudrate, timeout=timeout)
+        if transport is None:
+            transport = serial.Serial(device, baudrate, timeout=timeout)
+        self._serial = transport
         self._current_line = None
 
     def send_soft_reset(self):
         self._serial.write(b"\x18")
         self._serial.flush()
+        self.wait_for_startup()
+
+    def wait_for_startup(self):
         self.clear_line()
         # wait for startup message
         while not self.current_line().startswith("Grbl "):
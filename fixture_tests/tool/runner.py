@@ -0,0 +1,39 @@
+import os
+from termcolor import colored
+from tool import op_entries
+
+
+def run_fixture(fixture_path, controller):
+    """Execute one fixture file against a controller; returns True if it passed"""
+    op_entries_parsed = op_entries.parse_file(fixture_path)
+
+    try:
+        for op_entry in op_entries_parsed:
+            if not op_entry.execute(controller):
+                print(
+                    colored(f"--- Fixture ", "red")
+                    + colored(fixture_path, "red", attrs=["bold"])
+                    + colored(" failed ---", "red")
+                )
+                return False
+
+    except TimeoutError as e:
+        print("Timeout waiting for response, line: " + e.args[0])
+        return False
+
+    print(
+        colored(f"--- Fixture ", "green")
+        + colored(fixture_path, "green", attrs=["bold"])
+        + colored(" passed ---", "green"),
+        end="\n\n",
+    )
+    return True
+
+
+def find_fixtures(path):
+    """A fixture file, or all the .nc fixtures in a directory"""
+    if not os.path.isdir(path):
+        return [path]
+    return sorted(
+        os.path.join(path, file) for file in os.listdir(path) if file.endswith(".nc")
+    )
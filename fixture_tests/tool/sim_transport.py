@@ -0,0 +1,91 @@
+import os
+import pty
+import select
+import signal
+import subprocess
+import time
+import tty
+
+
+class SimTransport:
+    """Serial-port stand-in that runs the posix build of FluidNC on a pty.
+
+    Implements the subset of the pyserial interface that Controller uses
+    (readline, read, write, flush, timeout, close), so fixtures can run
+    against the simulator exactly as they do against an ESP32.
+
+    The simulator mounts native_localfs/ and native_sd/ relative to its
+    working directory, so each instance gets its own directory and no state
+    is shared between concurrently running instances.
+    """
+
+    def __init__(self, firmware, workdir, timeout=1, lifetime=None):
+        self.timeout = timeout
+        self._buffer = b""
+        # Give up on a hung fixture instead of waiting forever for a line
+        self._expires = None if lifetime is None else time.monotonic() + lifetime
+        master, slave = pty.openpty()
+        # Like a UART, the pty must not echo or translate what is sent
+        tty.setraw(slave)
+        self._fd = master
+        self._process = subprocess.Popen(
+            [os.path.abspath(firmware)],
+            cwd=workdir,
+            stdin=slave,
+            stdout=slave,
+            stderr=subprocess.DEVNULL,
+            start_new_session=True,
+        )
+        os.close(slave)
+
+    def _fill(self, deadline):
+        if self._expires is not None and time.monotonic() > self._expires:
+            raise TimeoutError("simulator lifetime expired")
+        if self._process.poll() is not None and not select.select([self._fd], [], [], 0)[0]:
+            raise TimeoutError(f"simulator exited with status {self._process.returncode}")
+        remaining = max(0, deadline - time.monotonic())
+        ready, _, _ = select.select([self._fd], [], [], remaining)
+        if not ready:
+            return False
+        try:
+            data = os.read(self._fd, 4096)
+        except OSError:
+            # EIO once the simulator exits and the pty closes
+            return False
+        if not data:
+            return False
+        self._buffer += data
+        return True
+
+    def readline(self):
+        deadline = time.monotonic() + self.timeout
+        while b"\n" not in self._buffer:
+            if not self._fill(deadline):
+                line, self._buffer = self._buffer, b""
+                return line
+        line, _, self._buffer = self._buffer.partition(b"\n")
+        return line + b"\n"
+
+    def read(self, size=1):
+        deadline = time.monotonic() + self.timeout
+        while len(self._buffer) < size:
+            if not self._fill(deadline):
+                break
+        data, self._buffer = self._buffer[:size], self._buffer[size:]
+        return data
+
+    def write(self, data):
+        return os.write(self._fd, data)
+
+    def flush(self):
+        pass
+
+    def close(self):
+        if self._process.poll() is None:
+            os.killpg(self._process.pid, signal.SIGTERM)
+            try:
+                self._process.wait(timeout=2)
+            except subprocess.TimeoutExpired:
+                os.killpg(self._process.pid, signal.SIGKILL)
+                self._process.wait()
+        os.close(self._fd)
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""
+trace_compare.py — compare output traces from two runs of the posix build.
+
+The posix build writes a trace of its outputs (step and GPIO pin levels,
+UART bytes and console output) when FLUIDNC_TRACE=<file> is set.  Combined
+with FLUIDNC_RECORD / FLUIDNC_REPLAY, which log and replay every external
+input, two builds can be driven with identical input and their behavior
+compared event by event.
+
+Usage:
+    FLUIDNC_RECORD=incident.log ./fluidnc                    # capture inputs
+    FLUIDNC_REPLAY=incident.log FLUIDNC_TRACE=a.trace ./old  # replay on build A
+    FLUIDNC_REPLAY=incident.log FLUIDNC_TRACE=b.trace ./new  # replay on build B
+    python3 trace_compare.py a.trace b.trace
+    python3 trace_compare.py a.trace b.trace --ids gpio.   # only GPIO streams
+    python3 trace_compare.py a.trace b.trace --timing      # also compare timestamps
+
+Each line of a trace is "<virtual_ms> <id> <hex bytes...>".  Events are
+grouped into one stream per id, and the streams are compared by value.
+Timestamps are ignored unless --timing is given, in which case events that
+match by value but differ in time by more than --tolerance ms are reported,
+along with the end-time difference per stream, which is a measure of how
+fast each build worked through the same input.
+
+Exit codes:
+    0  traces match
+    1  traces differ
+    2  file not found
+"""
+
+import argparse
+import sys
+from collections import defaultdict
+
+
+def load_trace(path, prefixes):
+    streams = defaultdict(list)
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            fields = line.split()
+            if len(fields) < 2:
+                continue
+            time, ident = int(fields[0]), fields[1]
+            if prefixes and not any(ident.startswith(p) for p in prefixes):
+                continue
+            streams[ident].append((time, " ".join(fields[2:])))
+    return streams
+
+
+def compare_stream(ident, a, b, timing, tolerance, max_reports):
+    differences = 0
+    for i, (ea, eb) in enumerate(zip(a, b)):
+        if ea[1] != eb[1]:
+            print(f"{ident}: event {i} differs: {ea[1]!r} at {ea[0]} ms vs {eb[1]!r} at {eb[0]} ms")
+            # Once values diverge, later events are not comparable
+            return differences + 1
+        if timing and abs(ea[0] - eb[0]) > tolerance:
+            differences += 1
+            if differences <= max_reports:
+                print(f"{ident}: event {i} time {ea[0]} ms vs {eb[0]} ms")
+    if len(a) != len(b):
+        print(f"{ident}: {len(a)} events vs {len(b)} events")
+        differences += 1
+    return differences
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare FluidNC posix output traces")
+    parser.add_argument("trace_a")
+    parser.add_argument("trace_b")
+    parser.add_argument("--ids", nargs="*", default=[], help="only compare streams whose id starts with one of these prefixes")
+    parser.add_argument("--timing", action="store_true", help="compare event timestamps as well as values")
+    parser.add_argument("--tolerance", type=int, default=0, help="allowed timestamp difference in ms with --timing")
+    parser.add_argument("--max-reports", type=int, default=10, help="timing differences to print per stream")
+    args = parser.parse_args()
+
+    try:
+        a = load_trace(args.trace_a, args.ids)
+        b = load_trace(args.trace_b, args.ids)
+    except OSError as e:
+        print(e, file=sys.stderr)
+        return 2
+
+    differences = 0
+    for ident in sorted(set(a) | set(b)):
+        sa, sb = a.get(ident, []), b.get(ident, [])
+        differences += compare_stream(ident, sa, sb, args.timing, args.tolerance, args.max_reports)
+        if args.timing and sa and sb:
+            delta = sb[-1][0] - sa[-1][0]
+            print(f"{ident}: {len(sa)} events, last at {sa[-1][0]} ms vs {sb[-1][0]} ms ({delta:+d} ms)")
+
+    if differences:
+        print(f"Traces differ: {differences} difference(s)")
+        return 1
+    print("Traces match")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())